@@ -0,0 +1,80 @@
+#include "arena.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define ALIGN_UP(size) (((size) + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1))
+
+static ArenaPage* page_create(size_t size) {
+    ArenaPage* page = (ArenaPage*)malloc(sizeof(ArenaPage) + size);
+    page->next = NULL;
+    page->size = size;
+    page->used = 0;
+    return page;
+}
+
+Arena* arena_create(void) {
+    Arena* arena = (Arena*)malloc(sizeof(Arena));
+    arena->pages = page_create(ARENA_PAGE_SIZE);
+    return arena;
+}
+
+void arena_free(Arena* arena) {
+    if (!arena) return;
+    ArenaPage* page = arena->pages;
+    while (page) {
+        ArenaPage* next = page->next;
+        free(page);
+        page = next;
+    }
+    free(arena);
+}
+
+void* arena_alloc(Arena* arena, size_t size) {
+    size = ALIGN_UP(size);
+    ArenaPage* current = arena->pages;
+
+    if (current->used + size <= current->size) {
+        void* block = current->data + current->used;
+        current->used += size;
+        return block;
+    }
+
+    // 큰 블록은 전용 페이지 (현재 페이지 뒤에 끼워 넣어 남은 공간을 계속 씀)
+    if (size > ARENA_PAGE_SIZE / 4) {
+        ArenaPage* page = page_create(size);
+        page->used = size;
+        page->next = current->next;
+        current->next = page;
+        return page->data;
+    }
+
+    ArenaPage* page = page_create(ARENA_PAGE_SIZE);
+    page->next = current;
+    arena->pages = page;
+    page->used = size;
+    return page->data;
+}
+
+void* arena_calloc(Arena* arena, size_t size) {
+    void* block = arena_alloc(arena, size);
+    memset(block, 0, size);
+    return block;
+}
+
+void* arena_grow(Arena* arena, void* block, size_t old_size, size_t new_size) {
+    if (!block) return arena_alloc(arena, new_size);
+
+    // 현재 페이지의 마지막 블록이면 제자리에서
+    ArenaPage* current = arena->pages;
+    size_t old_aligned = ALIGN_UP(old_size);
+    size_t new_aligned = ALIGN_UP(new_size);
+    if ((char*)block + old_aligned == current->data + current->used &&
+        current->used - old_aligned + new_aligned <= current->size) {
+        current->used = current->used - old_aligned + new_aligned;
+        return block;
+    }
+
+    void* grown = arena_alloc(arena, new_size);
+    memcpy(grown, block, old_size < new_size ? old_size : new_size);
+    return grown;
+}
@@ -0,0 +1,37 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+// 아레나 (범프 할당기)
+//
+// 페이지(기본 64KB) 안에서 포인터만 밀어 가며 나눠 주고, 개별 해제 없이 arena_free로 한 번에 해제한다.
+// 파스 하나가 아레나 하나를 쓴다: 렉서는 토큰을, 파서는 AST 노드와 자식 배열을 여기서 받으므로
+// 트리가 할당 순서대로 연속해서 놓이고 ast_free는 아레나만 해제한다.
+// 페이지의 1/4보다 큰 요청은 전용 페이지를 받는다 (현재 페이지는 계속 씀).
+
+#define ARENA_PAGE_SIZE (64 * 1024)
+#define ARENA_ALIGN 8
+
+typedef struct ArenaPage {
+    struct ArenaPage* next;
+    size_t size;   // data 크기
+    size_t used;
+    char data[];
+} ArenaPage;
+
+typedef struct Arena {
+    ArenaPage* pages;  // 맨 앞이 지금 나눠 주는 페이지
+} Arena;
+
+Arena* arena_create(void);
+void arena_free(Arena* arena);
+
+void* arena_alloc(Arena* arena, size_t size);   // ARENA_ALIGN 정렬, 초기화하지 않음
+void* arena_calloc(Arena* arena, size_t size);  // 0으로 채움
+
+// 늘리기 (realloc 대신): 마지막으로 받은 블록이면 그 자리에서 늘리고, 아니면 새로 받아 복사
+// (옛 블록은 아레나를 해제할 때 같이 사라짐)
+void* arena_grow(Arena* arena, void* block, size_t old_size, size_t new_size);
+
+#endif
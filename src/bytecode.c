@@ -1,4 +1,8 @@
 #include "bytecode.h"
+#include "jit.h"
+#include "trace.h"
+#include "intern.h"
+#include "gc.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -6,13 +10,33 @@
 // 바이트코드 청크 생성
 BytecodeChunk* bytecode_chunk_create() {
     BytecodeChunk* chunk = (BytecodeChunk*)malloc(sizeof(BytecodeChunk));
-    chunk->instructions = NULL;
+    chunk->code = NULL;
     chunk->count = 0;
     chunk->capacity = 0;
     
+    chunk->lines = NULL;
+    chunk->line_count = 0;
+    chunk->line_capacity = 0;
+    
+    chunk->handlers = NULL;
+    chunk->handler_count = 0;
+    chunk->handler_capacity = 0;
+    
     chunk->constants = NULL;
     chunk->constant_count = 0;
     chunk->constant_capacity = 0;
+    chunk->constant_slots = NULL;
+    chunk->constant_slot_capacity = 0;
+    
+    chunk->global_names = NULL;
+    chunk->global_count = 0;
+    
+    chunk->name = NULL;
+    chunk->arity = 0;
+    chunk->local_count = 0;
+    chunk->max_stack = 0;
+    chunk->jit = NULL;
+    chunk->traces = NULL;
     
     return chunk;
 }
@@ -21,56 +45,238 @@ BytecodeChunk* bytecode_chunk_create() {
 void bytecode_chunk_free(BytecodeChunk* chunk) {
     if (!chunk) return;
     
-    // 명령어 해제
-    if (chunk->instructions) {
-        free(chunk->instructions);
+    // 명령어 해제 (캐시 파일에서 읽은 청크는 매핑을 빌려 쓰므로 해제하지 않음)
+    if (chunk->code && chunk->capacity > 0) {
+        free(chunk->code);
     }
+    free(chunk->lines);
+    free(chunk->handlers);
     
-    // 상수 해제
+    // 상수 해제 (함수 상수의 청크는 이 청크가 소유, 인턴된 문자열은 인턴 테이블이 소유)
     for (int i = 0; i < chunk->constant_count; i++) {
-        value_free(chunk->constants[i]);
+        Value* constant = chunk->constants[i];
+        if (constant->type == VAL_FUNCTION && constant->data.function->chunk) {
+            bytecode_chunk_free(constant->data.function->chunk);
+            constant->data.function->chunk = NULL;
+        }
+        if (constant->type != VAL_STRING) {
+            value_free(constant);
+        }
     }
     if (chunk->constants) {
         free(chunk->constants);
     }
+    free(chunk->constant_slots);
+    
+    // 전역 변수 이름 해제
+    for (int i = 0; i < chunk->global_count; i++) {
+        free(chunk->global_names[i]);
+    }
+    free(chunk->global_names);
+    free(chunk->name);
+    jit_code_free(chunk->jit);
+    trace_cache_free(chunk->traces);
     
     free(chunk);
 }
 
-// 명령어 추가
-void bytecode_emit(BytecodeChunk* chunk, OpCode opcode) {
+// 바이트 추가
+static void bytecode_write_byte(BytecodeChunk* chunk, uint8_t byte) {
     // 용량 확장 필요 시
     if (chunk->count >= chunk->capacity) {
         int old_capacity = chunk->capacity;
         chunk->capacity = old_capacity < 8 ? 8 : old_capacity * 2;
-        chunk->instructions = (Instruction*)realloc(chunk->instructions, 
-                                                    sizeof(Instruction) * chunk->capacity);
+        chunk->code = (uint8_t*)realloc(chunk->code, chunk->capacity);
+    }
+    
+    chunk->code[chunk->count++] = byte;
+}
+
+static void bytecode_write_u16(BytecodeChunk* chunk, uint16_t value) {
+    bytecode_write_byte(chunk, value & 0xff);
+    bytecode_write_byte(chunk, (value >> 8) & 0xff);
+}
+
+static void bytecode_write_u32(BytecodeChunk* chunk, uint32_t value) {
+    bytecode_write_byte(chunk, value & 0xff);
+    bytecode_write_byte(chunk, (value >> 8) & 0xff);
+    bytecode_write_byte(chunk, (value >> 16) & 0xff);
+    bytecode_write_byte(chunk, (value >> 24) & 0xff);
+}
+
+// 라인 기록 (같은 라인이면 그대로, 아직 명령어가 없는 항목은 덮어씀)
+void bytecode_set_line(BytecodeChunk* chunk, int line) {
+    if (line <= 0) return;
+    
+    if (chunk->line_count > 0) {
+        BytecodeLine* last = &chunk->lines[chunk->line_count - 1];
+        if (last->line == line) return;
+        if (last->offset == chunk->count) {
+            last->line = line;
+            return;
+        }
     }
     
-    // 명령어 추가
-    chunk->instructions[chunk->count].opcode = opcode;
-    chunk->instructions[chunk->count].operand.int_operand = 0;
-    chunk->count++;
+    if (chunk->line_count >= chunk->line_capacity) {
+        chunk->line_capacity = chunk->line_capacity < 8 ? 8 : chunk->line_capacity * 2;
+        chunk->lines = (BytecodeLine*)realloc(chunk->lines, sizeof(BytecodeLine) * chunk->line_capacity);
+    }
+    chunk->lines[chunk->line_count].offset = chunk->count;
+    chunk->lines[chunk->line_count].line = line;
+    chunk->line_count++;
+}
+
+// 명령어 추가
+void bytecode_emit(BytecodeChunk* chunk, OpCode opcode) {
+    bytecode_write_byte(chunk, (uint8_t)opcode);
+}
+
+// 1바이트 피연산자가 넘칠 때 쓰는 4바이트 변형 (없으면 -1)
+static int long_variant(OpCode opcode) {
+    switch (opcode) {
+        case OP_LOAD_CONST: return OP_LOAD_CONST_LONG;
+        case OP_LOAD_GLOBAL: return OP_LOAD_GLOBAL_LONG;
+        case OP_STORE_GLOBAL: return OP_STORE_GLOBAL_LONG;
+        case OP_BUILD_ARRAY: return OP_BUILD_ARRAY_LONG;
+        default: return -1;
+    }
 }
 
-// 피연산자가 있는 명령어 추가
+// 피연산자가 있는 명령어 추가 (피연산자 크기는 값에 따라 선택)
 void bytecode_emit_with_operand(BytecodeChunk* chunk, OpCode opcode, int64_t operand) {
-    // 용량 확장 필요 시
-    if (chunk->count >= chunk->capacity) {
-        int old_capacity = chunk->capacity;
-        chunk->capacity = old_capacity < 8 ? 8 : old_capacity * 2;
-        chunk->instructions = (Instruction*)realloc(chunk->instructions, 
-                                                    sizeof(Instruction) * chunk->capacity);
+    if (operand < 0 || operand > UINT32_MAX) {
+        fprintf(stderr, "Operand out of range for %s: %lld\n", 
+                bytecode_opcode_name(opcode), (long long)operand);
+        exit(1);
+    }
+    
+    if (operand > UINT8_MAX && bytecode_operand_width(opcode) == 1) {
+        int long_opcode = long_variant(opcode);
+        if (long_opcode < 0) {
+            fprintf(stderr, "Operand too large for %s: %lld\n", 
+                    bytecode_opcode_name(opcode), (long long)operand);
+            exit(1);
+        }
+        opcode = (OpCode)long_opcode;
+    }
+    
+    bytecode_write_byte(chunk, (uint8_t)opcode);
+    switch (bytecode_operand_width(opcode)) {
+        case 1: bytecode_write_byte(chunk, (uint8_t)operand); break;
+        case 2: bytecode_write_u16(chunk, (uint16_t)operand); break;
+        case 4: bytecode_write_u32(chunk, (uint32_t)operand); break;
+        default: break;
+    }
+}
+
+// 1바이트 피연산자 두 개짜리 명령어 추가 (슈퍼명령어용)
+void bytecode_emit_with_operands(BytecodeChunk* chunk, OpCode opcode, uint8_t first, uint8_t second) {
+    bytecode_write_byte(chunk, (uint8_t)opcode);
+    bytecode_write_byte(chunk, first);
+    bytecode_write_byte(chunk, second);
+}
+
+// 앞쪽 점프 추가 (오프셋은 나중에 bytecode_patch_jump로 채움, 피연산자 위치 반환)
+int bytecode_emit_jump(BytecodeChunk* chunk, OpCode opcode) {
+    bytecode_write_byte(chunk, (uint8_t)opcode);
+    bytecode_write_u16(chunk, 0xffff);
+    return chunk->count - 2;
+}
+
+// 앞쪽 점프의 목적지를 현재 위치로 설정
+void bytecode_patch_jump(BytecodeChunk* chunk, int operand_offset) {
+    int jump = chunk->count - (operand_offset + 2);
+    if (jump > JUMP_MAX) {
+        fprintf(stderr, "Too much code to jump over\n");
+        exit(1);
+    }
+    
+    chunk->code[operand_offset] = jump & 0xff;
+    chunk->code[operand_offset + 1] = (jump >> 8) & 0xff;
+}
+
+// loop_start로 돌아가는 역방향 점프 추가
+void bytecode_emit_loop(BytecodeChunk* chunk, int loop_start) {
+    bytecode_write_byte(chunk, (uint8_t)OP_LOOP);
+    
+    int offset = chunk->count + 2 - loop_start;
+    if (offset > JUMP_MAX) {
+        fprintf(stderr, "Loop body too large\n");
+        exit(1);
+    }
+    bytecode_write_u16(chunk, (uint16_t)offset);
+}
+
+// 상수 풀 해시 인덱스에 넣는 상수 (숫자, 인턴된 문자열)
+static int constant_is_indexed(Value* value) {
+    return value->type == VAL_NUMBER || value->type == VAL_STRING;
+}
+
+// 숫자는 비트 패턴으로 (0과 -0은 다른 상수), 문자열은 인턴할 때 계산한 해시
+static uint32_t constant_hash(Value* value) {
+    if (value->type == VAL_STRING) return value->hash;
+    
+    uint64_t bits;
+    memcpy(&bits, &value->data.number, sizeof(bits));
+    bits ^= bits >> 33;
+    bits *= 0xff51afd7ed558ccdULL;
+    bits ^= bits >> 33;
+    return (uint32_t)bits;
+}
+
+// 같은 상수인지 (인턴된 문자열은 포인터만 비교)
+static int constant_equals(Value* a, Value* b) {
+    if (a->type != b->type) return 0;
+    if (a->type == VAL_STRING) return a == b;
+    return memcmp(&a->data.number, &b->data.number, sizeof(double)) == 0;
+}
+
+// value의 자리 (있으면 그 상수의 자리, 없으면 넣을 빈 자리)
+static int* constant_slot(BytecodeChunk* chunk, Value* value) {
+    uint32_t mask = (uint32_t)chunk->constant_slot_capacity - 1;
+    uint32_t index = constant_hash(value) & mask;
+    for (;;) {
+        int* slot = &chunk->constant_slots[index];
+        if (*slot < 0 || constant_equals(chunk->constants[*slot], value)) return slot;
+        index = (index + 1) & mask;
     }
+}
+
+// 해시 인덱스 두 배로 (상수 수의 3/4를 넘으면)
+static void grow_constant_slots(BytecodeChunk* chunk) {
+    int capacity = chunk->constant_slot_capacity < 16 ? 16 : chunk->constant_slot_capacity * 2;
+    free(chunk->constant_slots);
+    chunk->constant_slots = (int*)malloc(sizeof(int) * capacity);
+    chunk->constant_slot_capacity = capacity;
+    for (int i = 0; i < capacity; i++) chunk->constant_slots[i] = -1;
     
-    // 명령어 추가
-    chunk->instructions[chunk->count].opcode = opcode;
-    chunk->instructions[chunk->count].operand.int_operand = operand;
-    chunk->count++;
+    for (int i = 0; i < chunk->constant_count; i++) {
+        if (constant_is_indexed(chunk->constants[i])) {
+            *constant_slot(chunk, chunk->constants[i]) = i;
+        }
+    }
 }
 
-// 상수 추가 (상수 풀에 추가하고 인덱스 반환)
+// 상수 추가 (숫자/문자열은 같은 값이 이미 있으면 그 인덱스, 문자열은 인턴해서 저장)
 int bytecode_add_constant(BytecodeChunk* chunk, Value* value) {
+    int* slot = NULL;
+    if (constant_is_indexed(value)) {
+        if (value->type == VAL_STRING) {
+            Value* interned = intern_string(value->data.string);
+            if (interned != value) value_free(value);
+            value = interned;
+        }
+        
+        if ((chunk->constant_count + 1) * 4 > chunk->constant_slot_capacity * 3) {
+            grow_constant_slots(chunk);
+        }
+        slot = constant_slot(chunk, value);
+        if (*slot >= 0) {
+            if (chunk->constants[*slot] != value) value_free(value);
+            return *slot;
+        }
+    }
+    
     // 용량 확장 필요 시
     if (chunk->constant_count >= chunk->constant_capacity) {
         int old_capacity = chunk->constant_capacity;
@@ -79,102 +285,626 @@ int bytecode_add_constant(BytecodeChunk* chunk, Value* value) {
                                            sizeof(Value*) * chunk->constant_capacity);
     }
     
-    // 상수 추가
+    // 상수 추가 (상수는 청크가 살아 있는 동안 쓰이므로 GC에서 고정)
+    gc_pin(value);
+    if (slot) *slot = chunk->constant_count;
     chunk->constants[chunk->constant_count] = value;
     return chunk->constant_count++;
 }
 
+// 예외 핸들러 추가 (try 블록을 다 컴파일한 뒤 호출하므로 안쪽 try가 먼저 들어감)
+void bytecode_add_handler(BytecodeChunk* chunk, int start, int end, int handler, int depth, int type) {
+    if (chunk->handler_count >= chunk->handler_capacity) {
+        chunk->handler_capacity = chunk->handler_capacity < 4 ? 4 : chunk->handler_capacity * 2;
+        chunk->handlers = (BytecodeHandler*)realloc(chunk->handlers, 
+                                                    sizeof(BytecodeHandler) * chunk->handler_capacity);
+    }
+    
+    BytecodeHandler* entry = &chunk->handlers[chunk->handler_count++];
+    entry->start = start;
+    entry->end = end;
+    entry->handler = handler;
+    entry->depth = depth;
+    entry->type = type;
+}
+
+// offset에서 던진 type 예외를 받을 핸들러 (가장 안쪽 try부터)
+BytecodeHandler* bytecode_find_handler(BytecodeChunk* chunk, int offset, const char* type) {
+    for (int i = 0; i < chunk->handler_count; i++) {
+        BytecodeHandler* entry = &chunk->handlers[i];
+        if (offset < entry->start || offset >= entry->end) continue;
+        if (entry->type < 0 || strcmp(chunk->constants[entry->type]->data.string, type) == 0) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+// 명령어 정보 (이름, 피연산자 바이트 수)
+typedef struct {
+    const char* name;
+    int operand_width;
+} OpInfo;
+
+static const OpInfo opcode_info[] = {
+    [OP_LOAD_CONST]        = {"LOAD_CONST", 1},
+    [OP_LOAD_CONST_LONG]   = {"LOAD_CONST_LONG", 4},
+    [OP_LOAD_TRUE]         = {"LOAD_TRUE", 0},
+    [OP_LOAD_FALSE]        = {"LOAD_FALSE", 0},
+    [OP_LOAD_NULL]         = {"LOAD_NULL", 0},
+    [OP_LOAD_GLOBAL]       = {"LOAD_GLOBAL", 1},
+    [OP_LOAD_GLOBAL_LONG]  = {"LOAD_GLOBAL_LONG", 4},
+    [OP_STORE_GLOBAL]      = {"STORE_GLOBAL", 1},
+    [OP_STORE_GLOBAL_LONG] = {"STORE_GLOBAL_LONG", 4},
+    [OP_LOAD_LOCAL]        = {"LOAD_LOCAL", 1},
+    [OP_STORE_LOCAL]       = {"STORE_LOCAL", 1},
+    [OP_ADD]               = {"ADD", 0},
+    [OP_SUBTRACT]          = {"SUBTRACT", 0},
+    [OP_MULTIPLY]          = {"MULTIPLY", 0},
+    [OP_DIVIDE]            = {"DIVIDE", 0},
+    [OP_MODULO]            = {"MODULO", 0},
+    [OP_FLOOR_DIV]         = {"FLOOR_DIV", 0},
+    [OP_NEGATE]            = {"NEGATE", 0},
+    [OP_EQUAL]             = {"EQUAL", 0},
+    [OP_NOT_EQUAL]         = {"NOT_EQUAL", 0},
+    [OP_LESS]              = {"LESS", 0},
+    [OP_LESS_EQUAL]        = {"LESS_EQUAL", 0},
+    [OP_GREATER]           = {"GREATER", 0},
+    [OP_GREATER_EQUAL]     = {"GREATER_EQUAL", 0},
+    [OP_NOT]               = {"NOT", 0},
+    [OP_BUILD_ARRAY]       = {"BUILD_ARRAY", 1},
+    [OP_BUILD_ARRAY_LONG]  = {"BUILD_ARRAY_LONG", 4},
+    [OP_BUILD_DICT]        = {"BUILD_DICT", 1},
+    [OP_INDEX]             = {"INDEX", 0},
+    [OP_STORE_INDEX]       = {"STORE_INDEX", 0},
+    [OP_ARRAY_LENGTH]      = {"ARRAY_LENGTH", 0},
+    [OP_JUMP]              = {"JUMP", 2},
+    [OP_JUMP_IF_FALSE]     = {"JUMP_IF_FALSE", 2},
+    [OP_JUMP_IF_TRUE]      = {"JUMP_IF_TRUE", 2},
+    [OP_LOOP]              = {"LOOP", 2},
+    [OP_CALL]              = {"CALL", 1},
+    [OP_RETURN]            = {"RETURN", 0},
+    [OP_CALL_BUILTIN]      = {"CALL_BUILTIN", 2},
+    [OP_PRINT]             = {"PRINT", 0},
+    [OP_POP]               = {"POP", 0},
+    [OP_DUP]               = {"DUP", 0},
+    [OP_THROW]             = {"THROW", 0},
+    [OP_JUMP_IF_NOT_LESS]  = {"JUMP_IF_NOT_LESS", 2},
+    [OP_INCR_LOCAL]        = {"INCR_LOCAL", 2},
+    [OP_INCR_GLOBAL]       = {"INCR_GLOBAL", 2},
+    [OP_INDEX_LOCALS]      = {"INDEX_LOCALS", 2},
+    [OP_INDEX_GLOBALS]     = {"INDEX_GLOBALS", 2},
+    [OP_ADD_CONST]         = {"ADD_CONST", 1},
+    [OP_ADD_NUM]           = {"ADD_NUM", 0},
+    [OP_ADD_STR]           = {"ADD_STR", 0},
+    [OP_SUBTRACT_NUM]      = {"SUBTRACT_NUM", 0},
+    [OP_MULTIPLY_NUM]      = {"MULTIPLY_NUM", 0},
+    [OP_LESS_NUM]          = {"LESS_NUM", 0},
+    [OP_LESS_EQUAL_NUM]    = {"LESS_EQUAL_NUM", 0},
+    [OP_GREATER_NUM]       = {"GREATER_NUM", 0},
+    [OP_GREATER_EQUAL_NUM] = {"GREATER_EQUAL_NUM", 0},
+    [OP_HALT]              = {"HALT", 0},
+};
+
+#define OPCODE_COUNT ((int)(sizeof(opcode_info) / sizeof(opcode_info[0])))
+
+// 유효한 opcode인지 확인
+static int opcode_is_valid(int opcode) {
+    return opcode >= 0 && opcode < OPCODE_COUNT && opcode_info[opcode].name != NULL;
+}
+
 // OpCode를 문자열로 변환
-static const char* opcode_to_string(OpCode opcode) {
+const char* bytecode_opcode_name(OpCode opcode) {
+    return opcode_is_valid(opcode) ? opcode_info[opcode].name : "UNKNOWN";
+}
+
+// 피연산자 바이트 수
+int bytecode_operand_width(OpCode opcode) {
+    return opcode_is_valid(opcode) ? opcode_info[opcode].operand_width : 0;
+}
+
+// offset 위치 명령어의 전체 바이트 수 (opcode + 피연산자)
+int bytecode_instruction_length(BytecodeChunk* chunk, int offset) {
+    return 1 + bytecode_operand_width((OpCode)chunk->code[offset]);
+}
+
+// offset 위치 명령어의 피연산자 값
+int64_t bytecode_read_operand(BytecodeChunk* chunk, int offset) {
+    const uint8_t* operand = &chunk->code[offset + 1];
+    switch (bytecode_operand_width((OpCode)chunk->code[offset])) {
+        case 1: return operand[0];
+        case 2: return bytecode_read_u16(operand);
+        case 4: return bytecode_read_u32(operand);
+        default: return 0;
+    }
+}
+
+// 점프 명령어의 목적지 (점프가 아니면 -1)
+int bytecode_jump_target(BytecodeChunk* chunk, int offset) {
+    int next = offset + bytecode_instruction_length(chunk, offset);
+    switch (chunk->code[offset]) {
+        case OP_JUMP:
+        case OP_JUMP_IF_FALSE:
+        case OP_JUMP_IF_TRUE:
+        case OP_JUMP_IF_NOT_LESS:
+            return next + (int)bytecode_read_operand(chunk, offset);
+        case OP_LOOP:
+            return next - (int)bytecode_read_operand(chunk, offset);
+        default:
+            return -1;
+    }
+}
+
+// offset 위치 명령어의 소스 라인 (항목은 offset 순서이므로 이진 탐색)
+int bytecode_line_at(BytecodeChunk* chunk, int offset) {
+    int low = 0;
+    int high = chunk->line_count - 1;
+    int line = 0;
+    
+    while (low <= high) {
+        int mid = (low + high) / 2;
+        if (chunk->lines[mid].offset <= offset) {
+            line = chunk->lines[mid].line;
+            low = mid + 1;
+        } else {
+            high = mid - 1;
+        }
+    }
+    return line;
+}
+
+// 퀵닝된 명령어의 원래 명령어 (JIT/트레이스 기록은 일반 명령어 기준으로 처리)
+OpCode bytecode_generic_opcode(OpCode opcode) {
     switch (opcode) {
-        case OP_LOAD_CONST: return "LOAD_CONST";
-        case OP_LOAD_TRUE: return "LOAD_TRUE";
-        case OP_LOAD_FALSE: return "LOAD_FALSE";
-        case OP_LOAD_NULL: return "LOAD_NULL";
-        case OP_LOAD_VAR: return "LOAD_VAR";
-        case OP_STORE_VAR: return "STORE_VAR";
-        case OP_LOAD_GLOBAL: return "LOAD_GLOBAL";
-        case OP_STORE_GLOBAL: return "STORE_GLOBAL";
-        case OP_ADD: return "ADD";
-        case OP_SUBTRACT: return "SUBTRACT";
-        case OP_MULTIPLY: return "MULTIPLY";
-        case OP_DIVIDE: return "DIVIDE";
-        case OP_MODULO: return "MODULO";
-        case OP_FLOOR_DIV: return "FLOOR_DIV";
-        case OP_NEGATE: return "NEGATE";
-        case OP_EQUAL: return "EQUAL";
-        case OP_NOT_EQUAL: return "NOT_EQUAL";
-        case OP_LESS: return "LESS";
-        case OP_LESS_EQUAL: return "LESS_EQUAL";
-        case OP_GREATER: return "GREATER";
-        case OP_GREATER_EQUAL: return "GREATER_EQUAL";
-        case OP_NOT: return "NOT";
-        case OP_BUILD_ARRAY: return "BUILD_ARRAY";
-        case OP_BUILD_DICT: return "BUILD_DICT";
-        case OP_INDEX: return "INDEX";
-        case OP_STORE_INDEX: return "STORE_INDEX";
-        case OP_ARRAY_LENGTH: return "ARRAY_LENGTH";
-        case OP_JUMP: return "JUMP";
-        case OP_JUMP_IF_FALSE: return "JUMP_IF_FALSE";
-        case OP_JUMP_IF_TRUE: return "JUMP_IF_TRUE";
-        case OP_LOOP: return "LOOP";
-        case OP_CALL: return "CALL";
-        case OP_RETURN: return "RETURN";
-        case OP_PRINT: return "PRINT";
-        case OP_POP: return "POP";
-        case OP_DUP: return "DUP";
-        case OP_HALT: return "HALT";
-        default: return "UNKNOWN";
-    }
-}
-
-// 바이트코드 디스어셈블 (디버깅용)
-void bytecode_disassemble(BytecodeChunk* chunk, const char* name) {
-    printf("== %s ==\n", name);
+        case OP_ADD_NUM:
+        case OP_ADD_STR:           return OP_ADD;
+        case OP_SUBTRACT_NUM:      return OP_SUBTRACT;
+        case OP_MULTIPLY_NUM:      return OP_MULTIPLY;
+        case OP_LESS_NUM:          return OP_LESS;
+        case OP_LESS_EQUAL_NUM:    return OP_LESS_EQUAL;
+        case OP_GREATER_NUM:       return OP_GREATER;
+        case OP_GREATER_EQUAL_NUM: return OP_GREATER_EQUAL;
+        default:                   return opcode;
+    }
+}
+
+// 청크 안의 함수 상수 (없으면 NULL)
+static BytecodeChunk* function_constant(BytecodeChunk* chunk, int index) {
+    Value* constant = chunk->constants[index];
+    return constant->type == VAL_FUNCTION ? constant->data.function->chunk : NULL;
+}
+
+// 청크 하나 디스어셈블 (전역 이름은 스크립트 청크에서 가져옴)
+static void disassemble_chunk(BytecodeChunk* chunk, const char* name, BytecodeChunk* script) {
+    printf("== %s (%d bytes) ==\n", name, chunk->count);
+    int previous_line = -1;
     
-    for (int i = 0; i < chunk->count; i++) {
-        Instruction* instr = &chunk->instructions[i];
-        printf("%04d  %-20s", i, opcode_to_string(instr->opcode));
+    for (int offset = 0; offset < chunk->count; 
+         offset += bytecode_instruction_length(chunk, offset)) {
+        OpCode opcode = (OpCode)chunk->code[offset];
+        int64_t operand = bytecode_read_operand(chunk, offset);
+        
+        // 라인은 바뀔 때만 출력
+        int line = bytecode_line_at(chunk, offset);
+        if (line == previous_line) {
+            printf("%04d     |  %-20s", offset, bytecode_opcode_name(opcode));
+        } else {
+            printf("%04d  %4d  %-20s", offset, line, bytecode_opcode_name(opcode));
+        }
+        previous_line = line;
         
         // 피연산자 출력
-        switch (instr->opcode) {
+        switch (opcode) {
             case OP_LOAD_CONST:
-            case OP_JUMP:
-            case OP_JUMP_IF_FALSE:
-            case OP_JUMP_IF_TRUE:
-            case OP_LOOP:
-            case OP_CALL:
-            case OP_BUILD_ARRAY:
-            case OP_BUILD_DICT:
-                printf(" %lld", instr->operand.int_operand);
+            case OP_LOAD_CONST_LONG:
+            case OP_ADD_CONST:
+                printf(" %lld", (long long)operand);
                 
                 // 상수 풀 인덱스인 경우 값도 출력
-                if (instr->opcode == OP_LOAD_CONST && 
-                    instr->operand.int_operand < chunk->constant_count) {
+                if (operand < chunk->constant_count) {
                     printf(" (");
-                    value_print(chunk->constants[instr->operand.int_operand]);
+                    value_print(chunk->constants[operand]);
                     printf(")");
                 }
                 break;
             
-            case OP_LOAD_VAR:
-            case OP_STORE_VAR:
-                printf(" %lld", instr->operand.int_operand);
+            case OP_LOAD_GLOBAL:
+            case OP_LOAD_GLOBAL_LONG:
+            case OP_STORE_GLOBAL:
+            case OP_STORE_GLOBAL_LONG:
+                printf(" %lld", (long long)operand);
                 
-                // 변수 이름 출력
-                if (instr->operand.int_operand < chunk->constant_count) {
-                    printf(" (");
-                    value_print(chunk->constants[instr->operand.int_operand]);
-                    printf(")");
+                // 전역 변수 이름 출력
+                if (operand < script->global_count) {
+                    printf(" (%s)", script->global_names[operand]);
                 }
                 break;
             
+            case OP_JUMP:
+            case OP_JUMP_IF_FALSE:
+            case OP_JUMP_IF_TRUE:
+            case OP_JUMP_IF_NOT_LESS:
+            case OP_LOOP:
+                printf(" %lld -> %04d", (long long)operand, bytecode_jump_target(chunk, offset));
+                break;
+            
+            case OP_INCR_LOCAL:
+                printf(" %d %+d", chunk->code[offset + 1], (int8_t)chunk->code[offset + 2]);
+                break;
+            
+            case OP_INCR_GLOBAL:
+                printf(" %d %+d (%s)", chunk->code[offset + 1], (int8_t)chunk->code[offset + 2],
+                       script->global_names[chunk->code[offset + 1]]);
+                break;
+            
+            case OP_INDEX_LOCALS:
+                printf(" %d[%d]", chunk->code[offset + 1], chunk->code[offset + 2]);
+                break;
+            
+            case OP_CALL_BUILTIN:
+                printf(" %s/%d", chunk->code[offset + 1] == BUILTIN_LEN ? "len" : "range", 
+                       chunk->code[offset + 2]);
+                break;
+            
+            case OP_INDEX_GLOBALS:
+                printf(" %d[%d] (%s[%s])", chunk->code[offset + 1], chunk->code[offset + 2],
+                       script->global_names[chunk->code[offset + 1]],
+                       script->global_names[chunk->code[offset + 2]]);
+                break;
+            
             default:
+                if (bytecode_operand_width(opcode) > 0) {
+                    printf(" %lld", (long long)operand);
+                }
                 break;
         }
         
         printf("\n");
     }
     
+    // 예외 핸들러 테이블
+    for (int i = 0; i < chunk->handler_count; i++) {
+        BytecodeHandler* entry = &chunk->handlers[i];
+        printf("  try %04d-%04d -> %04d  depth %d  %s\n", entry->start, entry->end, 
+               entry->handler, entry->depth, 
+               entry->type >= 0 ? chunk->constants[entry->type]->data.string : "*");
+    }
+    
     printf("\n");
+    
+    // 함수 본문
+    for (int i = 0; i < chunk->constant_count; i++) {
+        BytecodeChunk* function = function_constant(chunk, i);
+        if (function) {
+            disassemble_chunk(function, function->name, script);
+        }
+    }
+}
+
+// 바이트코드 디스어셈블 (디버깅용, 함수 청크 포함)
+void bytecode_disassemble(BytecodeChunk* chunk, const char* name) {
+    disassemble_chunk(chunk, name, chunk);
+}
+
+// 명령어가 스택에서 꺼내는/올리는 값 수
+static void stack_effect(BytecodeChunk* chunk, int offset, int* pops, int* pushes) {
+    int64_t operand = bytecode_read_operand(chunk, offset);
+    *pops = 0;
+    *pushes = 0;
+    
+    switch (bytecode_generic_opcode((OpCode)chunk->code[offset])) {
+        case OP_LOAD_CONST:
+        case OP_LOAD_CONST_LONG:
+        case OP_LOAD_TRUE:
+        case OP_LOAD_FALSE:
+        case OP_LOAD_NULL:
+        case OP_LOAD_GLOBAL:
+        case OP_LOAD_GLOBAL_LONG:
+        case OP_LOAD_LOCAL:
+        case OP_INDEX_LOCALS:
+        case OP_INDEX_GLOBALS:
+            *pushes = 1;
+            break;
+        
+        // top을 읽고 그대로 두거나 결과로 바꾸는 명령어
+        case OP_STORE_GLOBAL:
+        case OP_STORE_GLOBAL_LONG:
+        case OP_STORE_LOCAL:
+        case OP_NEGATE:
+        case OP_NOT:
+        case OP_ARRAY_LENGTH:
+        case OP_ADD_CONST:
+            *pops = 1;
+            *pushes = 1;
+            break;
+        
+        case OP_ADD:
+        case OP_SUBTRACT:
+        case OP_MULTIPLY:
+        case OP_DIVIDE:
+        case OP_MODULO:
+        case OP_FLOOR_DIV:
+        case OP_EQUAL:
+        case OP_NOT_EQUAL:
+        case OP_LESS:
+        case OP_LESS_EQUAL:
+        case OP_GREATER:
+        case OP_GREATER_EQUAL:
+        case OP_INDEX:
+            *pops = 2;
+            *pushes = 1;
+            break;
+        
+        case OP_BUILD_ARRAY:
+        case OP_BUILD_ARRAY_LONG:
+            *pops = (int)operand;
+            *pushes = 1;
+            break;
+        
+        case OP_BUILD_DICT:
+            *pops = 2 * (int)operand;
+            *pushes = 1;
+            break;
+        
+        case OP_STORE_INDEX:
+            *pops = 3;
+            *pushes = 1;
+            break;
+        
+        case OP_CALL:
+            *pops = (int)operand + 1;   // 함수 + 인자 → 반환값
+            *pushes = 1;
+            break;
+        
+        case OP_CALL_BUILTIN:
+            *pops = chunk->code[offset + 2];
+            *pushes = 1;
+            break;
+        
+        case OP_DUP:
+            *pops = 1;
+            *pushes = 2;
+            break;
+        
+        case OP_JUMP_IF_FALSE:
+        case OP_JUMP_IF_TRUE:
+        case OP_RETURN:
+        case OP_PRINT:
+        case OP_POP:
+        case OP_THROW:
+            *pops = 1;
+            break;
+        
+        case OP_JUMP_IF_NOT_LESS:
+            *pops = 2;
+            break;
+        
+        default:
+            break;
+    }
+}
+
+// 명령어가 읽거나 쓰는 지역 슬롯 중 가장 큰 번호 (지역 슬롯을 쓰지 않으면 -1)
+static int64_t highest_local_slot(BytecodeChunk* chunk, int offset) {
+    switch ((OpCode)chunk->code[offset]) {
+        case OP_LOAD_LOCAL:
+        case OP_STORE_LOCAL:
+            return bytecode_read_operand(chunk, offset);
+        case OP_INCR_LOCAL:
+            return chunk->code[offset + 1];
+        case OP_INDEX_LOCALS:
+            return chunk->code[offset + 1] > chunk->code[offset + 2] ? chunk->code[offset + 1]
+                                                                       : chunk->code[offset + 2];
+        default:
+            return -1;
+    }
+}
+
+// 프레임 기준 최대 스택 깊이 (명령어마다 들어올 때의 깊이를 따라가며 계산)
+// 앞으로 가는 점프와 뒤로 가는 LOOP만 있으므로 오프셋 순서로 한 번 훑으면 모든 진입 깊이가 정해진다.
+// 예외 핸들러는 try 블록 뒤에 있으므로 미리 (남길 깊이 + 예외 값)으로 진입 깊이를 정해 둔다.
+// 점프 목적지에서 깊이가 어긋나거나, 꺼낼 값이 모자라거나, 지역 슬롯이 그 위치의 깊이 밖이면 -1
+static int stack_depth(BytecodeChunk* chunk) {
+    int* depth = (int*)malloc(sizeof(int) * (chunk->count + 1));
+    for (int i = 0; i <= chunk->count; i++) depth[i] = -1;
+    
+    // 함수 프레임은 슬롯 0(함수), 인자, 지역 변수를 채운 상태로 시작
+    depth[0] = chunk->name ? 1 + chunk->arity + chunk->local_count : 0;
+    int max = depth[0];
+    
+    for (int i = 0; i < chunk->handler_count; i++) {
+        BytecodeHandler* entry = &chunk->handlers[i];
+        depth[entry->handler] = entry->depth + 1;
+        if (depth[entry->handler] > max) max = depth[entry->handler];
+    }
+    
+    for (int offset = 0; offset < chunk->count; 
+         offset += bytecode_instruction_length(chunk, offset)) {
+        if (depth[offset] < 0) continue;  // 도달할 수 없는 코드
+        
+        int pops, pushes;
+        stack_effect(chunk, offset, &pops, &pushes);
+        if (depth[offset] < pops) {
+            fprintf(stderr, "Bytecode error at %04d: stack underflow\n", offset);
+            max = -1;
+            break;
+        }
+        
+        // 지역 슬롯은 프레임에 이미 있는 값만 (VM은 slots[]를 범위 검사 없이 읽고 씀)
+        int64_t slot = highest_local_slot(chunk, offset);
+        if (slot >= depth[offset]) {
+            fprintf(stderr, "Bytecode error at %04d: local slot %lld out of range\n", 
+                    offset, (long long)slot);
+            max = -1;
+            break;
+        }
+        
+        int after = depth[offset] - pops + pushes;
+        if (after > max) max = after;
+        
+        OpCode opcode = (OpCode)chunk->code[offset];
+        int next = offset + bytecode_instruction_length(chunk, offset);
+        int target = bytecode_jump_target(chunk, offset);
+        int falls_through = opcode != OP_JUMP && opcode != OP_LOOP && opcode != OP_THROW &&
+                            opcode != OP_RETURN && opcode != OP_HALT;
+        int successors[2] = { falls_through ? next : -1, target };
+        
+        for (int i = 0; i < 2; i++) {
+            int successor = successors[i];
+            if (successor < 0 || successor > chunk->count) continue;
+            if (depth[successor] < 0) {
+                depth[successor] = after;
+            } else if (depth[successor] != after) {
+                fprintf(stderr, "Bytecode error at %04d: stack depth %d does not match %d at %04d\n",
+                        offset, after, depth[successor], successor);
+                max = -1;
+                break;
+            }
+        }
+        if (max < 0) break;
+    }
+    
+    free(depth);
+    return max;
+}
+
+int bytecode_compute_max_stack(BytecodeChunk* chunk) {
+    int max = stack_depth(chunk);
+    if (max >= 0) chunk->max_stack = max;
+    return max;
+}
+
+// 바이트코드 검증 (실행 전 한 번만 수행, 통과하면 VM은 ip 범위 검사 없이 실행)
+//  - 모든 opcode가 유효하고 피연산자가 청크 안에 있으며, 마지막 명령어가 HALT/RETURN
+//  - 상수/전역 슬롯 인덱스가 범위 안
+//  - 점프 목적지는 명령어 경계, JUMP 계열은 앞으로만, LOOP는 뒤로만 (무한 루프 검사를 LOOP에서만 하기 위함)
+//  - 예외 핸들러의 범위/목적지가 명령어 경계이고 목적지는 try 블록 뒤, 타입은 문자열 상수
+//  - 스택 깊이가 max_stack 안 (VM의 push/pop은 검사 없이 포인터만 옮김), 지역 슬롯은 그 위치의 깊이 안
+//  - 함수 상수의 청크도 같은 규칙으로 검사 (전역 슬롯은 스크립트 청크 기준)
+static int verify_chunk(BytecodeChunk* chunk, BytecodeChunk* script) {
+    // 명령어 시작 위치 표시 (점프 목적지 검사용)
+    uint8_t* is_start = (uint8_t*)calloc(chunk->count + 1, 1);
+    int last = -1;
+    int ok = 1;
+    
+    for (int offset = 0; offset < chunk->count && ok; 
+         offset += bytecode_instruction_length(chunk, offset)) {
+        if (!opcode_is_valid(chunk->code[offset])) {
+            fprintf(stderr, "Bytecode error at %04d: invalid opcode %d\n", offset, chunk->code[offset]);
+            ok = 0;
+        } else if (offset + bytecode_instruction_length(chunk, offset) > chunk->count) {
+            fprintf(stderr, "Bytecode error at %04d: truncated operand\n", offset);
+            ok = 0;
+        } else {
+            is_start[offset] = 1;
+            last = offset;
+        }
+    }
+    
+    if (ok && (last < 0 || (chunk->code[last] != OP_HALT && chunk->code[last] != OP_RETURN))) {
+        fprintf(stderr, "Bytecode error: chunk must end with HALT or RETURN\n");
+        ok = 0;
+    }
+    
+    for (int offset = 0; offset < chunk->count && ok; 
+         offset += bytecode_instruction_length(chunk, offset)) {
+        OpCode opcode = (OpCode)chunk->code[offset];
+        int64_t operand = bytecode_read_operand(chunk, offset);
+        
+        switch (opcode) {
+            case OP_LOAD_CONST:
+            case OP_LOAD_CONST_LONG:
+            case OP_ADD_CONST:
+                if (operand >= chunk->constant_count) {
+                    fprintf(stderr, "Bytecode error at %04d: constant index %lld out of range\n", 
+                            offset, (long long)operand);
+                    ok = 0;
+                }
+                break;
+            
+            case OP_LOAD_GLOBAL:
+            case OP_LOAD_GLOBAL_LONG:
+            case OP_STORE_GLOBAL:
+            case OP_STORE_GLOBAL_LONG:
+                if (operand >= script->global_count) {
+                    fprintf(stderr, "Bytecode error at %04d: global slot %lld out of range\n", 
+                            offset, (long long)operand);
+                    ok = 0;
+                }
+                break;
+            
+            case OP_CALL_BUILTIN:
+                if (chunk->code[offset + 1] > BUILTIN_RANGE) {
+                    fprintf(stderr, "Bytecode error at %04d: unknown builtin %d\n", 
+                            offset, chunk->code[offset + 1]);
+                    ok = 0;
+                }
+                break;
+            
+            case OP_INCR_GLOBAL:
+            case OP_INDEX_GLOBALS:
+                if (chunk->code[offset + 1] >= script->global_count ||
+                    (opcode == OP_INDEX_GLOBALS && chunk->code[offset + 2] >= script->global_count)) {
+                    fprintf(stderr, "Bytecode error at %04d: global slot out of range\n", offset);
+                    ok = 0;
+                }
+                break;
+            
+            case OP_JUMP:
+            case OP_JUMP_IF_FALSE:
+            case OP_JUMP_IF_TRUE:
+            case OP_JUMP_IF_NOT_LESS:
+            case OP_LOOP: {
+                int target = bytecode_jump_target(chunk, offset);
+                int forward = opcode != OP_LOOP;
+                if (target < 0 || target >= chunk->count || !is_start[target] ||
+                    (forward ? target <= offset : target > offset)) {
+                    fprintf(stderr, "Bytecode error at %04d: bad jump target %d\n", offset, target);
+                    ok = 0;
+                }
+                break;
+            }
+            
+            default:
+                break;
+        }
+    }
+    
+    for (int i = 0; i < chunk->handler_count && ok; i++) {
+        BytecodeHandler* entry = &chunk->handlers[i];
+        if (entry->start < 0 || entry->start >= entry->end || entry->end > entry->handler ||
+            entry->handler >= chunk->count || !is_start[entry->start] || !is_start[entry->handler] ||
+            (entry->end < chunk->count && !is_start[entry->end]) || entry->depth < 0 || entry->type < -1 ||
+            entry->type >= chunk->constant_count ||
+            (entry->type >= 0 && chunk->constants[entry->type]->type != VAL_STRING)) {
+            fprintf(stderr, "Bytecode error: bad exception handler %d\n", i);
+            ok = 0;
+        }
+    }
+    
+    free(is_start);
+    
+    if (ok) {
+        int depth = stack_depth(chunk);
+        if (depth < 0) {
+            ok = 0;
+        } else if (depth > chunk->max_stack) {
+            fprintf(stderr, "Bytecode error: stack depth %d exceeds max_stack %d\n", 
+                    depth, chunk->max_stack);
+            ok = 0;
+        }
+    }
+    
+    for (int i = 0; i < chunk->constant_count && ok; i++) {
+        BytecodeChunk* function = function_constant(chunk, i);
+        if (function) {
+            ok = verify_chunk(function, script);
+        }
+    }
+    
+    return ok;
+}
+
+int bytecode_verify(BytecodeChunk* chunk) {
+    return verify_chunk(chunk, chunk);
 }
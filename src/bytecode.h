@@ -7,16 +7,19 @@
 // 바이트코드 명령어 (OpCode)
 typedef enum {
     // 상수 로드
-    OP_LOAD_CONST,      // 상수를 스택에 푸시
+    OP_LOAD_CONST,      // 상수를 스택에 푸시 (피연산자: 1바이트 상수 인덱스)
+    OP_LOAD_CONST_LONG, // 상수를 스택에 푸시 (피연산자: 4바이트 상수 인덱스)
     OP_LOAD_TRUE,       // true를 스택에 푸시
     OP_LOAD_FALSE,      // false를 스택에 푸시
     OP_LOAD_NULL,       // null을 스택에 푸시
     
-    // 변수 연산
-    OP_LOAD_VAR,        // 변수 로드
-    OP_STORE_VAR,       // 변수 저장
-    OP_LOAD_GLOBAL,     // 전역 변수 로드
-    OP_STORE_GLOBAL,    // 전역 변수 저장
+    // 변수 연산 (컴파일 시점에 슬롯 번호로 해석됨)
+    OP_LOAD_GLOBAL,     // 전역 변수 로드 (피연산자: 전역 슬롯)
+    OP_LOAD_GLOBAL_LONG,
+    OP_STORE_GLOBAL,    // 전역 변수 저장 (피연산자: 전역 슬롯)
+    OP_STORE_GLOBAL_LONG,
+    OP_LOAD_LOCAL,      // 지역 변수 로드 (피연산자: 스택 슬롯)
+    OP_STORE_LOCAL,     // 지역 변수 저장 (피연산자: 스택 슬롯)
     
     // 산술 연산
     OP_ADD,             // +
@@ -40,20 +43,22 @@ typedef enum {
     
     // 배열/딕셔너리
     OP_BUILD_ARRAY,     // 배열 생성 (피연산자: 요소 개수)
+    OP_BUILD_ARRAY_LONG,
     OP_BUILD_DICT,      // 딕셔너리 생성 (피연산자: 키-값 쌍 개수)
     OP_INDEX,           // 인덱스 접근 []
     OP_STORE_INDEX,     // 인덱스에 저장
     OP_ARRAY_LENGTH,    // 배열 길이 가져오기
     
     // 제어 흐름
-    OP_JUMP,            // 무조건 점프
+    OP_JUMP,            // 무조건 점프 (피연산자: 2바이트 앞쪽 오프셋)
     OP_JUMP_IF_FALSE,   // false면 점프
     OP_JUMP_IF_TRUE,    // true면 점프
-    OP_LOOP,            // 루프 (뒤로 점프)
+    OP_LOOP,            // 루프 (피연산자: 2바이트 뒤쪽 오프셋)
     
     // 함수
-    OP_CALL,            // 함수 호출 (피연산자: 인자 개수)
-    OP_RETURN,          // 함수 반환
+    OP_CALL,            // 함수 호출 (피연산자: 인자 개수, 스택: 함수, 인자들)
+    OP_RETURN,          // 함수 반환 (스택 top이 반환값)
+    OP_CALL_BUILTIN,    // 내장 함수 호출 (피연산자: 내장 함수 번호, 인자 개수)
     
     // 내장 함수
     OP_PRINT,           // print 함수
@@ -62,39 +67,131 @@ typedef enum {
     OP_POP,             // 스택에서 제거
     OP_DUP,             // 스택 top 복제
     
+    // 예외
+    OP_THROW,           // top을 예외로 던짐 (예외 값이 아니면 RuntimeError로 감쌈)
+    
+    // 슈퍼명령어 (컴파일러가 자주 나오는 패턴에 자동 선택)
+    OP_JUMP_IF_NOT_LESS,  // a, b를 pop해서 !(a < b)면 점프 (피연산자: 2바이트 앞쪽 오프셋)
+    OP_INCR_LOCAL,        // 지역 변수 += 상수 (피연산자: 슬롯 1바이트, 부호 있는 증가량 1바이트)
+    OP_INCR_GLOBAL,       // 전역 변수 += 상수 (피연산자: 슬롯 1바이트, 부호 있는 증가량 1바이트)
+    OP_INDEX_LOCALS,      // 지역 배열[지역 인덱스] 푸시 (피연산자: 배열 슬롯, 인덱스 슬롯)
+    OP_INDEX_GLOBALS,     // 전역 배열[전역 인덱스] 푸시 (피연산자: 배열 슬롯, 인덱스 슬롯)
+    OP_ADD_CONST,         // top + 상수 (피연산자: 1바이트 상수 인덱스)
+    
+    // 퀵닝 (컴파일러는 만들지 않음, vm_run이 처음 실행할 때 본 타입으로 일반 명령어를 바꿔 씀)
+    // 가드가 틀리면 일반 명령어로 되돌리고 다시 실행한다.
+    OP_ADD_NUM,           // 숫자 + 숫자
+    OP_ADD_STR,           // 문자열 + 문자열
+    OP_SUBTRACT_NUM,
+    OP_MULTIPLY_NUM,
+    OP_LESS_NUM,
+    OP_LESS_EQUAL_NUM,
+    OP_GREATER_NUM,
+    OP_GREATER_EQUAL_NUM,
+    
     // 프로그램 종료
     OP_HALT             // 프로그램 종료
 } OpCode;
 
-// 바이트코드 명령어 구조체
+// 바이트코드 인코딩: 1바이트 opcode 뒤에 0/1/2/4바이트 피연산자가 붙는 바이트 스트림
+//  - 인덱스/슬롯/개수: 1바이트, 255를 넘으면 emitter가 _LONG 변형(4바이트)을 선택
+//  - 점프: 2바이트 상대 오프셋 (명령어 끝 기준, LOOP는 뒤로)
+//  - 여러 바이트 피연산자는 리틀 엔디안
+#define JUMP_MAX UINT16_MAX
+
+static inline uint16_t bytecode_read_u16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t bytecode_read_u32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// OP_CALL_BUILTIN이 부르는 내장 함수
+typedef enum {
+    BUILTIN_LEN,        // len(배열/딕셔너리/문자열)
+    BUILTIN_RANGE       // range(start, end)
+} BuiltinId;
+
+// 라인 테이블 항목 (offset부터 다음 항목 전까지의 명령어가 나온 소스 라인)
 typedef struct {
-    OpCode opcode;
-    union {
-        int64_t int_operand;      // 정수 피연산자
-        double double_operand;    // 실수 피연산자
-        char* string_operand;     // 문자열 피연산자
-        void* ptr_operand;        // 포인터 피연산자
-    } operand;
-} Instruction;
+    int offset;
+    int line;
+} BytecodeLine;
 
-// 바이트코드 청크 (명령어 모음)
+// 예외 핸들러 테이블 항목 (try 블록 하나)
+// [start, end) 안의 명령어가 던진 예외 중 타입이 맞는 것을 handler로 보낸다.
+// 던지지 않는 경로에는 아무 명령어도 추가되지 않고, 던질 때만 테이블을 찾는다.
 typedef struct {
-    Instruction* instructions;
-    int count;
+    int start;          // try 블록 첫 명령어 오프셋
+    int end;            // try 블록 끝 오프셋 (포함하지 않음)
+    int handler;        // catch 블록 오프셋 (예외 값을 top에 올린 채로 들어감)
+    int depth;          // 들어가기 전 남겨 둘 프레임 기준 스택 깊이 (예외 값 제외)
+    int type;           // 잡을 예외 타입 이름의 상수 인덱스 (-1이면 모든 예외)
+} BytecodeHandler;
+
+// 바이트코드 청크 (명령어 모음, 스크립트 하나 또는 함수 하나)
+typedef struct BytecodeChunk {
+    uint8_t* code;      // 인코딩된 명령어 바이트 (capacity가 0이면 캐시 파일 매핑을 빌려 씀)
+    int count;          // 바이트 수
     int capacity;
     
-    // 상수 풀
+    // 라인 테이블 (라인이 바뀌는 위치만 기록)
+    BytecodeLine* lines;
+    int line_count;
+    int line_capacity;
+    
+    // 예외 핸들러 (안쪽 try가 먼저 오므로 앞에서부터 찾음)
+    BytecodeHandler* handlers;
+    int handler_count;
+    int handler_capacity;
+    
+    // 상수 풀 (숫자/문자열은 중복 없이 한 번만, 문자열은 인턴된 값)
     Value** constants;
     int constant_count;
     int constant_capacity;
+    int* constant_slots;        // 숫자/문자열 상수 → 인덱스 해시 인덱스 (열린 주소법, -1은 빈 자리)
+    int constant_slot_capacity;
+    
+    // 전역 변수 이름 (슬롯 번호 → 이름, 에러 메시지/디스어셈블용)
+    // 전역 슬롯은 프로그램 전체가 공유하므로 스크립트 청크에만 있음
+    char** global_names;
+    int global_count;
+    
+    // 함수 청크 정보 (스크립트 청크는 name == NULL)
+    char* name;
+    int arity;          // 매개변수 개수
+    int local_count;    // 매개변수 외 지역 변수 슬롯 수 (호출 시 null로 채움)
+    int max_stack;      // 프레임이 쓰는 최대 스택 슬롯 수 (슬롯 0/인자/지역 변수 포함, 컴파일러가 계산)
+    
+    struct JitCode* jit; // --jit로 만든 기계어 (없으면 NULL, 청크가 소유)
+    struct TraceCache* traces; // 핫 루프 카운터와 트레이스 (vm_run이 처음 OP_LOOP에서 만듦)
 } BytecodeChunk;
 
 // 바이트코드 함수
 BytecodeChunk* bytecode_chunk_create();
 void bytecode_chunk_free(BytecodeChunk* chunk);
+void bytecode_set_line(BytecodeChunk* chunk, int line);  // 이후에 내보내는 명령어의 소스 라인
 void bytecode_emit(BytecodeChunk* chunk, OpCode opcode);
 void bytecode_emit_with_operand(BytecodeChunk* chunk, OpCode opcode, int64_t operand);
-int bytecode_add_constant(BytecodeChunk* chunk, Value* value);
+void bytecode_emit_with_operands(BytecodeChunk* chunk, OpCode opcode, uint8_t first, uint8_t second);
+int bytecode_emit_jump(BytecodeChunk* chunk, OpCode opcode);
+void bytecode_patch_jump(BytecodeChunk* chunk, int operand_offset);
+void bytecode_emit_loop(BytecodeChunk* chunk, int loop_start);
+int bytecode_add_constant(BytecodeChunk* chunk, Value* value);  // 같은 숫자/문자열이 있으면 그 인덱스
+void bytecode_add_handler(BytecodeChunk* chunk, int start, int end, int handler, int depth, int type);
+BytecodeHandler* bytecode_find_handler(BytecodeChunk* chunk, int offset, const char* type);  // 없으면 NULL
 void bytecode_disassemble(BytecodeChunk* chunk, const char* name);
+int bytecode_verify(BytecodeChunk* chunk);
+int bytecode_compute_max_stack(BytecodeChunk* chunk);  // max_stack 계산 후 반환 (스택 깊이가 어긋나면 -1)
+
+// 명령어 정보
+const char* bytecode_opcode_name(OpCode opcode);
+int bytecode_operand_width(OpCode opcode);
+int bytecode_instruction_length(BytecodeChunk* chunk, int offset);
+int64_t bytecode_read_operand(BytecodeChunk* chunk, int offset);
+int bytecode_jump_target(BytecodeChunk* chunk, int offset);
+int bytecode_line_at(BytecodeChunk* chunk, int offset);  // 라인 정보가 없으면 0
+OpCode bytecode_generic_opcode(OpCode opcode);  // 퀵닝된 명령어 → 원래 일반 명령어
 
 #endif
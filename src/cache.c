@@ -0,0 +1,415 @@
+#include "cache.h"
+#include "intern.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// 상수 태그
+enum {
+    CACHE_NUMBER,
+    CACHE_STRING,
+    CACHE_FUNCTION
+};
+
+#define CACHE_NO_NAME UINT32_MAX   // 이름 없는 청크 (스크립트)
+#define CACHE_HEADER_SIZE 36       // 매직 4 + 버전/opcode 수/최적화 단계/전체 크기 각 4 + 해시 8 + 체크섬 8
+#define CACHE_SIZE_OFFSET 16       // 헤더 안의 전체 크기 위치
+#define CACHE_CHECKSUM_OFFSET 28   // 헤더 뒤 내용 전체의 체크섬 위치
+#define CACHE_MAX_NESTING 2        // 스크립트 → 함수 (중첩 함수는 컴파일러가 만들지 않음)
+
+// foo.fine → foo.finec
+char* cache_path(const char* source_path) {
+    size_t len = strlen(source_path);
+    char* path = (char*)malloc(len + 2);
+    memcpy(path, source_path, len);
+    path[len] = 'c';
+    path[len + 1] = '\0';
+    return path;
+}
+
+// FNV-1a 64비트
+static uint64_t fnv1a(const uint8_t* bytes, size_t size) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+uint64_t cache_hash(const char* source) {
+    return fnv1a((const uint8_t*)source, strlen(source));
+}
+
+// ============ 쓰기 ============
+
+typedef struct {
+    uint8_t* data;
+    size_t count;
+    size_t capacity;
+    int ok;           // 저장할 수 없는 상수가 있으면 0
+} CacheWriter;
+
+static void write_bytes(CacheWriter* writer, const void* bytes, size_t size) {
+    if (size == 0) return;  // 빈 테이블은 bytes가 NULL일 수 있음
+    if (writer->count + size > writer->capacity) {
+        while (writer->count + size > writer->capacity) {
+            writer->capacity = writer->capacity < 256 ? 256 : writer->capacity * 2;
+        }
+        writer->data = (uint8_t*)realloc(writer->data, writer->capacity);
+    }
+    memcpy(writer->data + writer->count, bytes, size);
+    writer->count += size;
+}
+
+static void write_u8(CacheWriter* writer, uint8_t value) {
+    write_bytes(writer, &value, sizeof(value));
+}
+
+static void write_u32(CacheWriter* writer, uint32_t value) {
+    write_bytes(writer, &value, sizeof(value));
+}
+
+static void write_string(CacheWriter* writer, const char* string) {
+    if (!string) {
+        write_u32(writer, CACHE_NO_NAME);
+        return;
+    }
+    uint32_t len = (uint32_t)strlen(string);
+    write_u32(writer, len);
+    write_bytes(writer, string, len);
+}
+
+static void write_chunk(CacheWriter* writer, BytecodeChunk* chunk) {
+    write_string(writer, chunk->name);
+    write_u32(writer, (uint32_t)chunk->arity);
+    write_u32(writer, (uint32_t)chunk->local_count);
+    write_u32(writer, (uint32_t)chunk->max_stack);
+
+    write_u32(writer, (uint32_t)chunk->global_count);
+    for (int i = 0; i < chunk->global_count; i++) {
+        write_string(writer, chunk->global_names[i]);
+    }
+
+    // 명령어 (이미 실행된 청크라면 퀵닝된 opcode를 일반 opcode로 되돌려서)
+    write_u32(writer, (uint32_t)chunk->count);
+    size_t code_start = writer->count;
+    write_bytes(writer, chunk->code, chunk->count);
+    for (int offset = 0; offset < chunk->count;
+         offset += bytecode_instruction_length(chunk, offset)) {
+        writer->data[code_start + offset] = (uint8_t)bytecode_generic_opcode((OpCode)chunk->code[offset]);
+    }
+
+    write_u32(writer, (uint32_t)chunk->line_count);
+    write_bytes(writer, chunk->lines, sizeof(BytecodeLine) * chunk->line_count);
+
+    write_u32(writer, (uint32_t)chunk->handler_count);
+    write_bytes(writer, chunk->handlers, sizeof(BytecodeHandler) * chunk->handler_count);
+
+    write_u32(writer, (uint32_t)chunk->constant_count);
+    for (int i = 0; i < chunk->constant_count; i++) {
+        Value* constant = chunk->constants[i];
+        switch (constant->type) {
+            case VAL_NUMBER:
+                write_u8(writer, CACHE_NUMBER);
+                write_bytes(writer, &constant->data.number, sizeof(double));
+                break;
+
+            case VAL_STRING:
+                write_u8(writer, CACHE_STRING);
+                write_string(writer, constant->data.string);
+                break;
+
+            case VAL_FUNCTION:
+                if (!constant->data.function->chunk) {
+                    writer->ok = 0;
+                    return;
+                }
+                write_u8(writer, CACHE_FUNCTION);
+                write_u32(writer, (uint32_t)constant->data.function->param_count);
+                for (int p = 0; p < constant->data.function->param_count; p++) {
+                    write_string(writer, constant->data.function->params[p]);
+                }
+                write_chunk(writer, constant->data.function->chunk);
+                break;
+
+            default:
+                writer->ok = 0;
+                return;
+        }
+    }
+}
+
+int cache_save(const char* path, BytecodeChunk* chunk, const char* source, int opt_level) {
+    CacheWriter writer = { NULL, 0, 0, 1 };
+    uint64_t hash = cache_hash(source);
+
+    write_bytes(&writer, "FNEC", 4);
+    write_u32(&writer, FINEC_VERSION);
+    write_u32(&writer, (uint32_t)OP_HALT + 1);
+    write_u32(&writer, (uint32_t)opt_level);
+    write_u32(&writer, 0);  // 전체 크기 (다 쓴 뒤 채움)
+    write_bytes(&writer, &hash, sizeof(hash));
+    write_bytes(&writer, &hash, sizeof(hash));  // 체크섬 자리 (다 쓴 뒤 채움)
+    write_chunk(&writer, chunk);
+
+    if (!writer.ok) {
+        free(writer.data);
+        return 0;
+    }
+    uint32_t size = (uint32_t)writer.count;
+    uint64_t checksum = fnv1a(writer.data + CACHE_HEADER_SIZE, writer.count - CACHE_HEADER_SIZE);
+    memcpy(writer.data + CACHE_SIZE_OFFSET, &size, sizeof(size));
+    memcpy(writer.data + CACHE_CHECKSUM_OFFSET, &checksum, sizeof(checksum));
+
+    // 다른 프로세스가 반쯤 쓴 파일을 읽지 않도록 임시 파일에 쓰고 rename
+    char* temp = (char*)malloc(strlen(path) + 32);
+    sprintf(temp, "%s.%ld.tmp", path, (long)getpid());
+
+    FILE* file = fopen(temp, "wb");
+    int ok = file != NULL;
+    if (file) {
+        ok = fwrite(writer.data, 1, writer.count, file) == writer.count;
+        ok = fclose(file) == 0 && ok;
+    }
+    if (ok) {
+        ok = rename(temp, path) == 0;
+    }
+    if (!ok) {
+        remove(temp);
+    }
+
+    free(temp);
+    free(writer.data);
+    return ok;
+}
+
+// ============ 읽기 ============
+
+typedef struct {
+    uint8_t* data;
+    size_t size;
+    size_t pos;
+    int ok;           // 잘리거나 값이 이상하면 0 (이후 읽기는 모두 실패)
+} CacheReader;
+
+static uint8_t* read_bytes(CacheReader* reader, size_t size) {
+    if (!reader->ok || size > reader->size - reader->pos) {
+        reader->ok = 0;
+        return NULL;
+    }
+    uint8_t* bytes = reader->data + reader->pos;
+    reader->pos += size;
+    return bytes;
+}
+
+static uint32_t read_u32(CacheReader* reader) {
+    uint32_t value = 0;
+    uint8_t* bytes = read_bytes(reader, sizeof(value));
+    if (bytes) memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+// 개수 필드 (int 범위를 넘으면 실패)
+static int read_count(CacheReader* reader) {
+    uint32_t value = read_u32(reader);
+    if (value > INT32_MAX) {
+        reader->ok = 0;
+        return 0;
+    }
+    return (int)value;
+}
+
+static char* read_string(CacheReader* reader) {
+    uint32_t len = read_u32(reader);
+    if (len == CACHE_NO_NAME) return NULL;
+
+    uint8_t* bytes = read_bytes(reader, len);
+    if (!bytes) return NULL;
+
+    char* string = (char*)malloc(len + 1);
+    memcpy(string, bytes, len);
+    string[len] = '\0';
+    return string;
+}
+
+// 매개변수 이름은 매핑에서 바로 심볼로 (없으면 NULL)
+static char* read_symbol(CacheReader* reader) {
+    uint32_t len = read_u32(reader);
+    if (len == CACHE_NO_NAME) return NULL;
+
+    uint8_t* bytes = read_bytes(reader, len);
+    if (!bytes) return NULL;
+    return symbol_intern((const char*)bytes, len);
+}
+
+static BytecodeChunk* read_chunk(CacheReader* reader, int nesting) {
+    if (nesting > CACHE_MAX_NESTING) {
+        reader->ok = 0;
+        return NULL;
+    }
+
+    BytecodeChunk* chunk = bytecode_chunk_create();
+    chunk->name = read_string(reader);
+    chunk->arity = read_count(reader);
+    chunk->local_count = read_count(reader);
+    chunk->max_stack = read_count(reader);
+
+    // 이름 하나가 최소 4바이트이므로 남은 크기보다 많으면 잘못된 파일
+    int global_count = read_count(reader);
+    if (global_count > (int)((reader->size - reader->pos) / 4)) reader->ok = 0;
+    if (global_count > 0 && reader->ok) {
+        chunk->global_names = (char**)calloc(global_count, sizeof(char*));
+        for (int i = 0; i < global_count && reader->ok; i++) {
+            chunk->global_names[i] = read_string(reader);
+            chunk->global_count = i + 1;
+            if (!chunk->global_names[i]) reader->ok = 0;
+        }
+    }
+
+    // 명령어는 복사하지 않고 매핑을 가리킴 (capacity 0 = 빌린 메모리)
+    int count = read_count(reader);
+    uint8_t* code = read_bytes(reader, count);
+    if (code) {
+        chunk->code = code;
+        chunk->count = count;
+    }
+
+    int line_count = read_count(reader);
+    uint8_t* lines = read_bytes(reader, sizeof(BytecodeLine) * (size_t)line_count);
+    if (lines && line_count > 0) {
+        chunk->lines = (BytecodeLine*)malloc(sizeof(BytecodeLine) * line_count);
+        memcpy(chunk->lines, lines, sizeof(BytecodeLine) * line_count);
+        chunk->line_count = line_count;
+        chunk->line_capacity = line_count;
+    }
+
+    // 핸들러 범위/타입은 bytecode_verify가 검사
+    int handler_count = read_count(reader);
+    uint8_t* handlers = read_bytes(reader, sizeof(BytecodeHandler) * (size_t)handler_count);
+    if (handlers && handler_count > 0) {
+        chunk->handlers = (BytecodeHandler*)malloc(sizeof(BytecodeHandler) * handler_count);
+        memcpy(chunk->handlers, handlers, sizeof(BytecodeHandler) * handler_count);
+        chunk->handler_count = handler_count;
+        chunk->handler_capacity = handler_count;
+    }
+
+    int constant_count = read_count(reader);
+    for (int i = 0; i < constant_count && reader->ok; i++) {
+        uint8_t* tag = read_bytes(reader, 1);
+        if (!tag) break;
+
+        Value* value = NULL;
+        switch (*tag) {
+            case CACHE_NUMBER: {
+                double number = 0;
+                uint8_t* bytes = read_bytes(reader, sizeof(double));
+                if (bytes) memcpy(&number, bytes, sizeof(double));
+                value = value_create_number(number);
+                break;
+            }
+
+            case CACHE_STRING: {
+                char* string = read_string(reader);
+                value = value_create_string(string ? string : "");
+                free(string);
+                break;
+            }
+
+            case CACHE_FUNCTION: {
+                int param_count = read_count(reader);
+                if (param_count > UINT8_MAX) {
+                    reader->ok = 0;
+                    break;
+                }
+
+                // 컴파일러가 만드는 함수 값과 같은 모양 (본문 AST 없이 청크만)
+                value = value_alloc(VAL_FUNCTION);
+                value->data.function->param_count = param_count;
+                value->data.function->params = malloc(sizeof(char*) * param_count);
+                for (int p = 0; p < param_count; p++) {
+                    char* param = read_symbol(reader);
+                    value->data.function->params[p] = param ? param : symbol_from("");
+                }
+                value->data.function->body = NULL;
+                value->data.function->closure = NULL;
+                value->data.function->chunk = read_chunk(reader, nesting + 1);
+                value->data.function->reg_chunk = NULL;
+                break;
+            }
+
+            default:
+                reader->ok = 0;
+                break;
+        }
+
+        // 저장된 풀은 이미 중복이 없으므로 인덱스가 그대로여야 함
+        if (value && bytecode_add_constant(chunk, value) != i) reader->ok = 0;
+    }
+
+    if (!reader->ok) {
+        bytecode_chunk_free(chunk);
+        return NULL;
+    }
+    return chunk;
+}
+
+BytecodeChunk* cache_load(const char* path, const char* source, int opt_level, CacheFile** file) {
+    *file = NULL;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < CACHE_HEADER_SIZE) {
+        close(fd);
+        return NULL;
+    }
+
+    // 쓰기 가능한 사적 매핑: 읽기만 하면 페이지 캐시를 공유하고, 퀵닝이 쓴 페이지만 복사됨
+    size_t size = (size_t)st.st_size;
+    uint8_t* data = (uint8_t*)mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return NULL;
+
+    CacheReader reader = { data, size, 0, 1 };
+    uint8_t* magic = read_bytes(&reader, 4);
+    uint32_t version = read_u32(&reader);
+    uint32_t opcode_count = read_u32(&reader);
+    uint32_t level = read_u32(&reader);
+    uint32_t total = read_u32(&reader);
+    uint64_t hash = 0;
+    uint64_t checksum = 0;
+    memcpy(&hash, read_bytes(&reader, sizeof(hash)), sizeof(hash));
+    memcpy(&checksum, read_bytes(&reader, sizeof(checksum)), sizeof(checksum));
+
+    // 소스가 바뀌었거나 캐시 파일이 잘리거나 깨졌으면 다시 컴파일
+    BytecodeChunk* chunk = NULL;
+    if (memcmp(magic, "FNEC", 4) == 0 && version == FINEC_VERSION &&
+        opcode_count == (uint32_t)OP_HALT + 1 && level == (uint32_t)opt_level &&
+        total == size && hash == cache_hash(source) &&
+        checksum == fnv1a(data + CACHE_HEADER_SIZE, size - CACHE_HEADER_SIZE)) {
+        chunk = read_chunk(&reader, 0);
+    }
+
+    if (!chunk || chunk->name) {
+        bytecode_chunk_free(chunk);
+        munmap(data, size);
+        return NULL;
+    }
+
+    *file = (CacheFile*)malloc(sizeof(CacheFile));
+    (*file)->data = data;
+    (*file)->size = size;
+    return chunk;
+}
+
+void cache_close(CacheFile* file) {
+    if (!file) return;
+    munmap(file->data, file->size);
+    free(file);
+}
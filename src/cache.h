@@ -0,0 +1,39 @@
+#ifndef CACHE_H
+#define CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "bytecode.h"
+
+// 바이트코드 캐시 파일 (.finec)
+//
+// compile()(+ optimize_chunk) 결과를 소스 옆의 <파일>.finec에 저장해 두고,
+// 다음 실행에서 소스 해시가 같으면 렉싱/파싱/컴파일 없이 그대로 읽어 쓴다.
+// 파일은 mmap(MAP_PRIVATE)으로 열고 명령어 바이트는 복사하지 않고 매핑을 직접 가리킨다.
+// 같은 캐시를 여는 프로세스들은 페이지를 공유하고, 퀵닝이 opcode를 바꿔 쓴 페이지만 복사된다.
+//
+// 형식 (호스트 바이트 순서, 버전/opcode 수가 다르면 다시 컴파일):
+//   헤더: "FNEC", 버전, opcode 수, 최적화 단계, 전체 크기, 소스 해시, 내용 체크섬 (둘 다 FNV-1a 64비트)
+//   청크: 이름, arity, local_count, max_stack, 전역 이름들, 명령어 바이트, 라인 테이블, 예외 핸들러, 상수들
+//   상수: 태그 1바이트 + 값 (숫자, 문자열, 함수 = 매개변수 이름들 + 청크)
+// 명령어는 퀵닝 전의 일반 opcode로 저장한다.
+
+#define FINEC_VERSION 2
+
+// 읽어 온 캐시 파일의 매핑 (청크를 해제한 뒤 cache_close)
+typedef struct CacheFile {
+    uint8_t* data;
+    size_t size;
+} CacheFile;
+
+char* cache_path(const char* source_path);  // foo.fine → foo.finec (호출한 쪽이 free)
+uint64_t cache_hash(const char* source);
+
+// 소스 해시/버전/최적화 단계가 맞으면 청크를 돌려줌 (없거나 맞지 않으면 NULL)
+BytecodeChunk* cache_load(const char* path, const char* source, int opt_level, CacheFile** file);
+void cache_close(CacheFile* file);
+
+// 청크 저장 (임시 파일에 쓴 뒤 rename, 실패하면 0)
+int cache_save(const char* path, BytecodeChunk* chunk, const char* source, int opt_level);
+
+#endif
@@ -2,30 +2,327 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
 
 // 컴파일러 생성
 Compiler* compiler_create() {
     Compiler* compiler = (Compiler*)malloc(sizeof(Compiler));
+    compiler->enclosing = NULL;
     compiler->chunk = bytecode_chunk_create();
-    compiler->env = environment_create(NULL);
     compiler->loop_start = -1;
     compiler->loop_depth = 0;
+    compiler->globals = NULL;
+    compiler->global_count = 0;
+    compiler->global_capacity = 0;
+    compiler->local_count = 0;
+    compiler->error = NULL;
     return compiler;
 }
 
 // 컴파일러 해제
 void compiler_free(Compiler* compiler) {
     if (!compiler) return;
-    environment_free(compiler->env);
+    for (int i = 0; i < compiler->global_count; i++) {
+        free(compiler->globals[i]);
+    }
+    free(compiler->globals);
     free(compiler);
 }
 
 // 전방 선언
 void compile_statement(Compiler* compiler, ASTNode* node);
 
+// 최상위 (스크립트) 컴파일러
+static Compiler* root_compiler(Compiler* compiler) {
+    while (compiler->enclosing) compiler = compiler->enclosing;
+    return compiler;
+}
+
+// 컴파일 에러 기록 (첫 번째 에러만 유지, 컴파일은 끝까지 진행)
+static void compiler_error(Compiler* compiler, const char* message) {
+    Compiler* root = root_compiler(compiler);
+    if (!root->error) root->error = message;
+}
+
+// ============ 변수 슬롯 해석 ============
+
+// 지역 변수 찾기 (가장 안쪽 선언부터, 없으면 -1)
+static int resolve_local(Compiler* compiler, char* name) {
+    for (int i = compiler->local_count - 1; i >= 0; i--) {
+        if (strcmp(compiler->locals[i].name, name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// 전역 변수 찾기 (없으면 -1)
+static int find_global(Compiler* compiler, char* name) {
+    compiler = root_compiler(compiler);
+    for (int i = 0; i < compiler->global_count; i++) {
+        if (strcmp(compiler->globals[i], name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// 전역 변수 슬롯 (처음 보는 이름이면 새 슬롯 할당)
+static int resolve_global(Compiler* compiler, char* name) {
+    int slot = find_global(compiler, name);
+    if (slot >= 0) return slot;
+    
+    compiler = root_compiler(compiler);    
+    if (compiler->global_count >= compiler->global_capacity) {
+        int old_capacity = compiler->global_capacity;
+        compiler->global_capacity = old_capacity < 8 ? 8 : old_capacity * 2;
+        compiler->globals = (char**)realloc(compiler->globals, 
+                                            sizeof(char*) * compiler->global_capacity);
+    }
+    compiler->globals[compiler->global_count] = strdup(name);
+    return compiler->global_count++;
+}
+
+// 지역 변수 선언 (스택 top의 값이 해당 슬롯이 됨)
+static int add_local(Compiler* compiler, char* name) {
+    if (compiler->local_count >= LOCALS_MAX) {
+        compiler_error(compiler, "too many local variables");
+        return LOCALS_MAX - 1;
+    }
+    compiler->locals[compiler->local_count].name = name;
+    return compiler->local_count++;
+}
+
+// 변수 로드 명령어 생성
+static void emit_load_variable(Compiler* compiler, char* name) {
+    int slot = resolve_local(compiler, name);
+    if (slot >= 0) {
+        bytecode_emit_with_operand(compiler->chunk, OP_LOAD_LOCAL, slot);
+        return;
+    }
+    
+    // 정의된 적 없는 null은 리터럴로 취급 (인터프리터와 동일하게 null로 평가)
+    if (strcmp(name, "null") == 0 && find_global(compiler, name) < 0) {
+        bytecode_emit(compiler->chunk, OP_LOAD_NULL);
+        return;
+    }
+    
+    bytecode_emit_with_operand(compiler->chunk, OP_LOAD_GLOBAL, resolve_global(compiler, name));
+}
+
+// 변수 저장 명령어 생성 (값은 스택에 남음)
+static void emit_store_variable(Compiler* compiler, char* name) {
+    int slot = resolve_local(compiler, name);
+    if (slot >= 0) {
+        bytecode_emit_with_operand(compiler->chunk, OP_STORE_LOCAL, slot);
+    } else {
+        bytecode_emit_with_operand(compiler->chunk, OP_STORE_GLOBAL, resolve_global(compiler, name));
+    }
+}
+
+// ============ 슈퍼명령어 선택 ============
+
+// 변수의 슬롯 (is_local에 지역 여부), null 리터럴처럼 변수가 아니면 -1
+static int variable_slot(Compiler* compiler, char* name, int* is_local) {
+    int slot = resolve_local(compiler, name);
+    if (slot >= 0) {
+        *is_local = 1;
+        return slot;
+    }
+    
+    *is_local = 0;
+    if (strcmp(name, "null") == 0 && find_global(compiler, name) < 0) {
+        return -1;
+    }
+    return resolve_global(compiler, name);
+}
+
+// 조건식 + 조건 점프 (a < b는 JUMP_IF_NOT_LESS 하나로), 패치할 피연산자 위치 반환
+static int emit_condition_jump(Compiler* compiler, ASTNode* condition) {
+    if (condition && condition->type == AST_BINARY_OP && condition->data.binary.right &&
+        strcmp(condition->data.binary.op, "<") == 0) {
+        compile_expression(compiler, condition->data.binary.left);
+        compile_expression(compiler, condition->data.binary.right);
+        return bytecode_emit_jump(compiler->chunk, OP_JUMP_IF_NOT_LESS);
+    }
+    
+    compile_expression(compiler, condition);
+    return bytecode_emit_jump(compiler->chunk, OP_JUMP_IF_FALSE);
+}
+
+// x = x + k, x = x - k (k는 1바이트에 들어가는 정수) → INCR_LOCAL/INCR_GLOBAL
+// 선택했으면 1 반환 (값을 스택에 남기지 않음)
+static int emit_increment(Compiler* compiler, char* name, ASTNode* value) {
+    if (!value || value->type != AST_BINARY_OP) return 0;
+    
+    char* op = value->data.binary.op;
+    ASTNode* left = value->data.binary.left;
+    ASTNode* right = value->data.binary.right;
+    if (strcmp(op, "+") != 0 && strcmp(op, "-") != 0) return 0;
+    if (left->type != AST_IDENTIFIER || strcmp(left->data.string, name) != 0) return 0;
+    if (right->type != AST_NUMBER) return 0;
+    
+    double amount = strcmp(op, "+") == 0 ? right->data.number : -right->data.number;
+    if (amount != (int)amount || amount < INT8_MIN || amount > INT8_MAX) return 0;
+    
+    int is_local;
+    int slot = variable_slot(compiler, name, &is_local);
+    if (slot < 0 || slot > UINT8_MAX) return 0;
+    
+    bytecode_emit_with_operands(compiler->chunk, is_local ? OP_INCR_LOCAL : OP_INCR_GLOBAL,
+                                (uint8_t)slot, (uint8_t)(int8_t)amount);
+    return 1;
+}
+
+// 변수[변수] → INDEX_LOCALS/INDEX_GLOBALS (둘 다 같은 종류의 1바이트 슬롯일 때만)
+static int emit_variable_index(Compiler* compiler, ASTNode* array, ASTNode* index) {
+    if (array->type != AST_IDENTIFIER || index->type != AST_IDENTIFIER) return 0;
+    
+    int array_local, index_local;
+    int array_slot = variable_slot(compiler, array->data.string, &array_local);
+    int index_slot = variable_slot(compiler, index->data.string, &index_local);
+    if (array_slot < 0 || index_slot < 0 || array_local != index_local) return 0;
+    if (array_slot > UINT8_MAX || index_slot > UINT8_MAX) return 0;
+    
+    bytecode_emit_with_operands(compiler->chunk, array_local ? OP_INDEX_LOCALS : OP_INDEX_GLOBALS,
+                                (uint8_t)array_slot, (uint8_t)index_slot);
+    return 1;
+}
+
+// 리터럴 상수인지 (상수 폴딩 대상이면 슈퍼명령어로 바꾸지 않음)
+static int is_literal(ASTNode* node) {
+    return node->type == AST_NUMBER || node->type == AST_STRING;
+}
+
+// ============ 함수 ============
+
+// VM이 직접 구현한 내장 함수 번호 (없으면 -1)
+int compiler_builtin_id(char* name) {
+    if (strcmp(name, "len") == 0) return BUILTIN_LEN;
+    if (strcmp(name, "range") == 0) return BUILTIN_RANGE;
+    return -1;
+}
+
+// 인터프리터에만 있는 내장 함수인지 (이름이 같은 사용자 함수보다 우선하므로 VM에서 흉내낼 수 없음)
+int compiler_is_interpreter_builtin(char* name) {
+    static const char* names[] = {
+        "sum", "keys", "values", "typeof", "map", "filter", "reduce",
+        "is_null", "is_number", "is_string", "is_bool", "is_array", "is_dict", "is_matrix",
+        NULL
+    };
+    for (int i = 0; names[i]; i++) {
+        if (strcmp(name, names[i]) == 0) return 1;
+    }
+    return 0;
+}
+
+// 함수 본문에서 대입되는 이름을 지역 변수로 선언 (블록은 스코프를 만들지 않음)
+static void declare_assigned_locals(Compiler* compiler, ASTNode* node) {
+    if (!node) return;
+    
+    switch (node->type) {
+        case AST_LET:
+        case AST_ASSIGN:
+            if (resolve_local(compiler, node->data.assign.name) < 0) {
+                add_local(compiler, node->data.assign.name);
+            }
+            break;
+        case AST_FOR:
+            if (resolve_local(compiler, node->data.for_loop.iterator) < 0) {
+                add_local(compiler, node->data.for_loop.iterator);
+            }
+            declare_assigned_locals(compiler, node->data.for_loop.body);
+            break;
+        case AST_IF:
+            declare_assigned_locals(compiler, node->data.if_stmt.then_branch);
+            declare_assigned_locals(compiler, node->data.if_stmt.else_branch);
+            break;
+        case AST_WHILE:
+            declare_assigned_locals(compiler, node->data.while_loop.body);
+            break;
+        case AST_TRY_CATCH:
+            if (node->data.try_catch.exception_var && 
+                resolve_local(compiler, node->data.try_catch.exception_var) < 0) {
+                add_local(compiler, node->data.try_catch.exception_var);
+            }
+            declare_assigned_locals(compiler, node->data.try_catch.try_block);
+            declare_assigned_locals(compiler, node->data.try_catch.catch_block);
+            declare_assigned_locals(compiler, node->data.try_catch.finally_block);
+            break;
+        case AST_BLOCK:
+            for (int i = 0; i < node->data.block.statement_count; i++) {
+                declare_assigned_locals(compiler, node->data.block.statements[i]);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+// fn name(params) { body } → 별도 청크로 컴파일해서 함수 값을 변수에 저장
+// 프레임 슬롯: 0 = 호출된 함수, 1..arity = 인자, 그 다음 = 본문의 지역 변수
+static void compile_function(Compiler* compiler, ASTNode* node) {
+    if (compiler->enclosing) {
+        // 중첩 함수는 바깥 지역 변수를 캡처해야 하므로 아직 지원하지 않음
+        compiler_error(compiler, "nested function definitions");
+        return;
+    }
+    
+    int param_count = node->data.function_def.param_count;
+    if (param_count > UINT8_MAX) {
+        compiler_error(compiler, "too many parameters");
+        return;
+    }
+    
+    Compiler* function = compiler_create();
+    function->enclosing = compiler;
+    function->chunk->name = strdup(node->data.function_def.name);
+    function->chunk->arity = param_count;
+    
+    add_local(function, "");
+    for (int i = 0; i < param_count; i++) {
+        add_local(function, node->data.function_def.params[i]);
+    }
+    declare_assigned_locals(function, node->data.function_def.body);
+    function->chunk->local_count = function->local_count - 1 - param_count;
+    
+    compile_statement(function, node->data.function_def.body);
+    
+    // return 없이 끝나면 null 반환
+    bytecode_emit(function->chunk, OP_LOAD_NULL);
+    bytecode_emit(function->chunk, OP_RETURN);
+    
+    // 이미 에러가 난 청크는 미완성이라 깊이를 계산하지 않음, 깊이가 맞지 않으면 지원하지 않는 식
+    if (!root_compiler(compiler)->error && bytecode_compute_max_stack(function->chunk) < 0) {
+        compiler_error(compiler, "unsupported expression");
+    }
+    
+    BytecodeChunk* chunk = function->chunk;
+    function->chunk = NULL;
+    compiler_free(function);
+    
+    // 함수 값 (인터프리터 함수와 같은 VAL_FUNCTION, 본문은 청크)
+    Value* func = value_alloc(VAL_FUNCTION);
+    func->data.function->param_count = param_count;
+    func->data.function->params = malloc(sizeof(char*) * param_count);
+    for (int i = 0; i < param_count; i++) {
+        func->data.function->params[i] = node->data.function_def.params[i];
+    }
+    func->data.function->body = node->data.function_def.body;
+    func->data.function->closure = NULL;
+    func->data.function->chunk = chunk;
+    func->data.function->reg_chunk = NULL;
+    
+    int index = bytecode_add_constant(compiler->chunk, func);
+    bytecode_emit_with_operand(compiler->chunk, OP_LOAD_CONST, index);
+    emit_store_variable(compiler, node->data.function_def.name);
+    bytecode_emit(compiler->chunk, OP_POP);
+}
+
 // 표현식 컴파일
 void compile_expression(Compiler* compiler, ASTNode* node) {
     if (!node) return;
+    bytecode_set_line(compiler->chunk, node->line);
     
     switch (node->type) {
         case AST_NUMBER: {
@@ -52,14 +349,32 @@ void compile_expression(Compiler* compiler, ASTNode* node) {
         }
         
         case AST_IDENTIFIER: {
-            // 변수 로드
-            Value* value = value_create_string(node->data.string);
-            int index = bytecode_add_constant(compiler->chunk, value);
-            bytecode_emit_with_operand(compiler->chunk, OP_LOAD_VAR, index);
+            // 변수 로드 (슬롯 번호로 해석)
+            emit_load_variable(compiler, node->data.string);
             break;
         }
         
         case AST_BINARY_OP: {
+            if (!node->data.binary.right) {
+                // 파서가 오른쪽 피연산자를 비워 둔 식 (2 ** 10 등, 인터프리터로 대체 실행)
+                compiler_error(compiler, "unsupported expression");
+                break;
+            }
+            
+            // x + 상수 → ADD_CONST (양쪽이 다 상수면 핍홀 단계의 상수 폴딩에 맡김)
+            if (strcmp(node->data.binary.op, "+") == 0 && is_literal(node->data.binary.right) &&
+                !is_literal(node->data.binary.left)) {
+                ASTNode* right = node->data.binary.right;
+                Value* value = right->type == AST_NUMBER ? value_create_number(right->data.number)
+                                                         : value_create_string(right->data.string);
+                int index = bytecode_add_constant(compiler->chunk, value);
+                if (index <= UINT8_MAX) {
+                    compile_expression(compiler, node->data.binary.left);
+                    bytecode_emit_with_operand(compiler->chunk, OP_ADD_CONST, index);
+                    break;
+                }
+            }
+            
             // 왼쪽/오른쪽 컴파일
             compile_expression(compiler, node->data.binary.left);
             compile_expression(compiler, node->data.binary.right);
@@ -71,12 +386,14 @@ void compile_expression(Compiler* compiler, ASTNode* node) {
             else if (strcmp(op, "*") == 0) bytecode_emit(compiler->chunk, OP_MULTIPLY);
             else if (strcmp(op, "/") == 0) bytecode_emit(compiler->chunk, OP_DIVIDE);
             else if (strcmp(op, "%") == 0) bytecode_emit(compiler->chunk, OP_MODULO);
+            else if (strcmp(op, "//") == 0) bytecode_emit(compiler->chunk, OP_FLOOR_DIV);
             else if (strcmp(op, "==") == 0) bytecode_emit(compiler->chunk, OP_EQUAL);
             else if (strcmp(op, "!=") == 0) bytecode_emit(compiler->chunk, OP_NOT_EQUAL);
             else if (strcmp(op, "<") == 0) bytecode_emit(compiler->chunk, OP_LESS);
             else if (strcmp(op, "<=") == 0) bytecode_emit(compiler->chunk, OP_LESS_EQUAL);
             else if (strcmp(op, ">") == 0) bytecode_emit(compiler->chunk, OP_GREATER);
             else if (strcmp(op, ">=") == 0) bytecode_emit(compiler->chunk, OP_GREATER_EQUAL);
+            else compiler_error(compiler, "unsupported binary operator");
             break;
         }
         
@@ -86,22 +403,54 @@ void compile_expression(Compiler* compiler, ASTNode* node) {
             char* op = node->data.unary.op;
             if (strcmp(op, "-") == 0) bytecode_emit(compiler->chunk, OP_NEGATE);
             else if (strcmp(op, "!") == 0) bytecode_emit(compiler->chunk, OP_NOT);
+            else compiler_error(compiler, "unsupported unary operator");
             break;
         }
         
         case AST_FUNCTION_CALL: {
+            char* name = node->data.function_call.name;
+            int arg_count = node->data.function_call.arg_count;
+            
             // print 함수 특별 처리
-            if (strcmp(node->data.function_call.name, "print") == 0) {
-                for (int i = 0; i < node->data.function_call.arg_count; i++) {
+            if (strcmp(name, "print") == 0) {
+                for (int i = 0; i < arg_count; i++) {
                     compile_expression(compiler, node->data.function_call.args[i]);
                 }
                 // 인자 개수만큼 PRINT (역순으로 팝되므로)
-                for (int i = 0; i < node->data.function_call.arg_count; i++) {
+                for (int i = 0; i < arg_count; i++) {
                     bytecode_emit(compiler->chunk, OP_PRINT);
                 }
                 // print는 값을 반환하지 않으므로 null 푸시
                 bytecode_emit(compiler->chunk, OP_LOAD_NULL);
+                break;
+            }
+            
+            // 내장 함수는 사용자 함수보다 우선 (인터프리터와 동일)
+            int builtin = compiler_builtin_id(name);
+            if (builtin >= 0) {
+                for (int i = 0; i < arg_count; i++) {
+                    compile_expression(compiler, node->data.function_call.args[i]);
+                }
+                bytecode_emit_with_operands(compiler->chunk, OP_CALL_BUILTIN, 
+                                            (uint8_t)builtin, (uint8_t)arg_count);
+                break;
+            }
+            if (compiler_is_interpreter_builtin(name)) {
+                compiler_error(compiler, "builtin function not available in the VM");
+                break;
+            }
+            
+            if (arg_count > UINT8_MAX) {
+                compiler_error(compiler, "too many arguments");
+                break;
+            }
+            
+            // 사용자 함수: 함수 값, 인자들을 스택에 올리고 CALL
+            emit_load_variable(compiler, name);
+            for (int i = 0; i < arg_count; i++) {
+                compile_expression(compiler, node->data.function_call.args[i]);
             }
+            bytecode_emit_with_operand(compiler->chunk, OP_CALL, arg_count);
             break;
         }
         
@@ -114,6 +463,9 @@ void compile_expression(Compiler* compiler, ASTNode* node) {
         }
         
         case AST_INDEX: {
+            if (emit_variable_index(compiler, node->data.index.array, node->data.index.index)) {
+                break;
+            }
             compile_expression(compiler, node->data.index.array);
             compile_expression(compiler, node->data.index.index);
             bytecode_emit(compiler->chunk, OP_INDEX);
@@ -121,7 +473,8 @@ void compile_expression(Compiler* compiler, ASTNode* node) {
         }
         
         default:
-            // 지원하지 않는 표현식은 무시
+            // VM이 지원하지 않는 표현식 (run_file_vm이 인터프리터로 실행)
+            compiler_error(compiler, "unsupported expression");
             break;
     }
 }
@@ -129,6 +482,7 @@ void compile_expression(Compiler* compiler, ASTNode* node) {
 // 문장 컴파일
 void compile_statement(Compiler* compiler, ASTNode* node) {
     if (!node) return;
+    bytecode_set_line(compiler->chunk, node->line);
     
     switch (node->type) {
         case AST_LET: {
@@ -139,48 +493,44 @@ void compile_statement(Compiler* compiler, ASTNode* node) {
                 bytecode_emit(compiler->chunk, OP_LOAD_NULL);
             }
             
-            Value* name = value_create_string(node->data.assign.name);
-            int index = bytecode_add_constant(compiler->chunk, name);
-            bytecode_emit_with_operand(compiler->chunk, OP_STORE_VAR, index);
+            emit_store_variable(compiler, node->data.assign.name);
+            bytecode_emit(compiler->chunk, OP_POP);
             break;
         }
         
         case AST_ASSIGN: {
+            // x = x + 1 → INCR
+            if (emit_increment(compiler, node->data.assign.name, node->data.assign.value)) {
+                break;
+            }
+            
             // x = 값
             compile_expression(compiler, node->data.assign.value);
-            
-            Value* name = value_create_string(node->data.assign.name);
-            int index = bytecode_add_constant(compiler->chunk, name);
-            bytecode_emit_with_operand(compiler->chunk, OP_STORE_VAR, index);
+            emit_store_variable(compiler, node->data.assign.name);
+            bytecode_emit(compiler->chunk, OP_POP);
             break;
         }
         
         case AST_IF: {
-            // 조건식
-            compile_expression(compiler, node->data.if_stmt.condition);
-            
-            // JUMP_IF_FALSE
-            int jump_to_else = compiler->chunk->count;
-            bytecode_emit_with_operand(compiler->chunk, OP_JUMP_IF_FALSE, 0);
+            // 조건식 + JUMP_IF_FALSE (조건 값은 점프 명령어가 pop함)
+            int jump_to_else = emit_condition_jump(compiler, node->data.if_stmt.condition);
             
             // then 블록
-            bytecode_emit(compiler->chunk, OP_POP);
             compile_statement(compiler, node->data.if_stmt.then_branch);
             
-            // JUMP (else 건너뛰기)
-            int jump_to_end = compiler->chunk->count;
-            bytecode_emit_with_operand(compiler->chunk, OP_JUMP, 0);
-            
-            // else 시작
-            compiler->chunk->instructions[jump_to_else].operand.int_operand = compiler->chunk->count;
-            bytecode_emit(compiler->chunk, OP_POP);
-            
             if (node->data.if_stmt.else_branch) {
+                // JUMP (else 건너뛰기)
+                int jump_to_end = bytecode_emit_jump(compiler->chunk, OP_JUMP);
+                
+                // else 시작
+                bytecode_patch_jump(compiler->chunk, jump_to_else);
                 compile_statement(compiler, node->data.if_stmt.else_branch);
+                
+                // 끝
+                bytecode_patch_jump(compiler->chunk, jump_to_end);
+            } else {
+                bytecode_patch_jump(compiler->chunk, jump_to_else);
             }
-            
-            // 끝
-            compiler->chunk->instructions[jump_to_end].operand.int_operand = compiler->chunk->count;
             break;
         }
         
@@ -188,69 +538,49 @@ void compile_statement(Compiler* compiler, ASTNode* node) {
             // 루프 시작
             int loop_start = compiler->chunk->count;
             
-            // 조건식
-            compile_expression(compiler, node->data.while_loop.condition);
-            
-            // JUMP_IF_FALSE
-            int jump_to_end = compiler->chunk->count;
-            bytecode_emit_with_operand(compiler->chunk, OP_JUMP_IF_FALSE, 0);
+            // 조건식 + JUMP_IF_FALSE
+            int jump_to_end = emit_condition_jump(compiler, node->data.while_loop.condition);
             
             // 본문
-            bytecode_emit(compiler->chunk, OP_POP);
             compiler->loop_start = loop_start;
             compiler->loop_depth++;
             compile_statement(compiler, node->data.while_loop.body);
             compiler->loop_depth--;
             
-            // 루프 시작으로
-            bytecode_emit_with_operand(compiler->chunk, OP_JUMP, loop_start);
+            // 루프 시작으로 (역방향 점프는 항상 OP_LOOP)
+            bytecode_emit_loop(compiler->chunk, loop_start);
             
             // 끝
-            compiler->chunk->instructions[jump_to_end].operand.int_operand = compiler->chunk->count;
-            bytecode_emit(compiler->chunk, OP_POP);
+            bytecode_patch_jump(compiler->chunk, jump_to_end);
             break;
         }
         
         case AST_FOR: {
             // for (item in iterable) 형태를 while 루프로 변환
-            // 간단한 구현: 배열에 대한 반복만 지원
+            // 배열과 인덱스는 이름 없는 지역 슬롯(스택)에 보관하므로 중첩 루프도 안전함
             
-            // iterable 평가하고 임시 변수에 저장
+            // iterable 평가 → 숨은 지역 변수 (배열)
             compile_expression(compiler, node->data.for_loop.iterable);
-            Value* tmp_array = value_create_string("__tmp_array__");
-            int array_idx = bytecode_add_constant(compiler->chunk, tmp_array);
-            bytecode_emit_with_operand(compiler->chunk, OP_STORE_VAR, array_idx);
-            bytecode_emit(compiler->chunk, OP_POP);  // 스택에서 값 제거
+            int array_slot = add_local(compiler, "(for array)");
             
-            // 인덱스 = 0
-            Value* tmp_index = value_create_string("__tmp_idx__");
-            int idx_var = bytecode_add_constant(compiler->chunk, tmp_index);
+            // 인덱스 = 0 → 숨은 지역 변수 (인덱스)
             int zero_const = bytecode_add_constant(compiler->chunk, value_create_number(0));
             bytecode_emit_with_operand(compiler->chunk, OP_LOAD_CONST, zero_const);
-            bytecode_emit_with_operand(compiler->chunk, OP_STORE_VAR, idx_var);
-            bytecode_emit(compiler->chunk, OP_POP);  // 스택에서 값 제거
+            int index_slot = add_local(compiler, "(for index)");
             
             // 루프 시작
             int loop_start = compiler->chunk->count;
             
-            // 조건: __tmp_idx__ < 배열.길이
-            bytecode_emit_with_operand(compiler->chunk, OP_LOAD_VAR, idx_var);
-            bytecode_emit_with_operand(compiler->chunk, OP_LOAD_VAR, array_idx);
+            // 조건: 인덱스 < 배열.길이
+            bytecode_emit_with_operand(compiler->chunk, OP_LOAD_LOCAL, index_slot);
+            bytecode_emit_with_operand(compiler->chunk, OP_LOAD_LOCAL, array_slot);
             bytecode_emit(compiler->chunk, OP_ARRAY_LENGTH);
-            bytecode_emit(compiler->chunk, OP_LESS);
-            
-            int jump_to_end = compiler->chunk->count;
-            bytecode_emit_with_operand(compiler->chunk, OP_JUMP_IF_FALSE, 0);
-            // POP 제거: JUMP_IF_FALSE가 이미 pop함
-            
-            // iterator = __tmp_array__[__tmp_idx__]
-            bytecode_emit_with_operand(compiler->chunk, OP_LOAD_VAR, array_idx);
-            bytecode_emit_with_operand(compiler->chunk, OP_LOAD_VAR, idx_var);
-            bytecode_emit(compiler->chunk, OP_INDEX);
+            int jump_to_end = bytecode_emit_jump(compiler->chunk, OP_JUMP_IF_NOT_LESS);
             
-            Value* iter = value_create_string(node->data.for_loop.iterator);
-            int iter_idx = bytecode_add_constant(compiler->chunk, iter);
-            bytecode_emit_with_operand(compiler->chunk, OP_STORE_VAR, iter_idx);
+            // iterator = 배열[인덱스]
+            bytecode_emit_with_operands(compiler->chunk, OP_INDEX_LOCALS, 
+                                        (uint8_t)array_slot, (uint8_t)index_slot);
+            emit_store_variable(compiler, node->data.for_loop.iterator);
             bytecode_emit(compiler->chunk, OP_POP);  // 스택에서 값 제거
             
             // 본문 실행
@@ -259,19 +589,17 @@ void compile_statement(Compiler* compiler, ASTNode* node) {
             compile_statement(compiler, node->data.for_loop.body);
             compiler->loop_depth--;
             
-            // __tmp_idx__ = __tmp_idx__ + 1
-            bytecode_emit_with_operand(compiler->chunk, OP_LOAD_VAR, idx_var);
-            int one_const = bytecode_add_constant(compiler->chunk, value_create_number(1));
-            bytecode_emit_with_operand(compiler->chunk, OP_LOAD_CONST, one_const);
-            bytecode_emit(compiler->chunk, OP_ADD);
-            bytecode_emit_with_operand(compiler->chunk, OP_STORE_VAR, idx_var);
-            bytecode_emit(compiler->chunk, OP_POP);  // 스택에서 값 제거
+            // 인덱스 = 인덱스 + 1
+            bytecode_emit_with_operands(compiler->chunk, OP_INCR_LOCAL, (uint8_t)index_slot, 1);
             
-            // 루프 시작으로
-            bytecode_emit_with_operand(compiler->chunk, OP_JUMP, loop_start);
+            // 루프 시작으로 (역방향 점프는 항상 OP_LOOP)
+            bytecode_emit_loop(compiler->chunk, loop_start);
             
-            // 끝 (POP 불필요: JUMP_IF_FALSE가 이미 pop함)
-            compiler->chunk->instructions[jump_to_end].operand.int_operand = compiler->chunk->count;
+            // 끝: 숨은 지역 변수 두 개 정리
+            bytecode_patch_jump(compiler->chunk, jump_to_end);
+            bytecode_emit(compiler->chunk, OP_POP);
+            bytecode_emit(compiler->chunk, OP_POP);
+            compiler->local_count -= 2;
             break;
         }
         
@@ -282,6 +610,63 @@ void compile_statement(Compiler* compiler, ASTNode* node) {
             break;
         }
         
+        case AST_FUNCTION_DEF:
+            compile_function(compiler, node);
+            break;
+        
+        case AST_RETURN: {
+            if (node->data.return_stmt.value) {
+                compile_expression(compiler, node->data.return_stmt.value);
+            } else {
+                bytecode_emit(compiler->chunk, OP_LOAD_NULL);
+            }
+            bytecode_emit(compiler->chunk, OP_RETURN);
+            break;
+        }
+        
+        case AST_TRY_CATCH: {
+            // try 블록은 그대로 이어서 실행하고 catch 블록은 건너뜀 (예외 핸들러 테이블로만 들어감)
+            // 문장 사이의 스택에는 숨은 지역 변수만 있으므로 그 개수가 핸들러가 남길 깊이
+            int depth = compiler->local_count;
+            int start = compiler->chunk->count;
+            compile_statement(compiler, node->data.try_catch.try_block);
+            int end = compiler->chunk->count;
+            
+            if (node->data.try_catch.catch_block && end > start) {
+                int jump_over_catch = bytecode_emit_jump(compiler->chunk, OP_JUMP);
+                
+                int type = -1;
+                if (node->data.try_catch.exception_type) {
+                    type = bytecode_add_constant(compiler->chunk, 
+                        value_create_string(node->data.try_catch.exception_type));
+                }
+                bytecode_add_handler(compiler->chunk, start, end, compiler->chunk->count, depth, type);
+                
+                // 핸들러: 예외 값이 top (변수에 저장하거나 버림)
+                if (node->data.try_catch.exception_var) {
+                    emit_store_variable(compiler, node->data.try_catch.exception_var);
+                }
+                bytecode_emit(compiler->chunk, OP_POP);
+                compile_statement(compiler, node->data.try_catch.catch_block);
+                
+                bytecode_patch_jump(compiler->chunk, jump_over_catch);
+            }
+            
+            // finally는 정상 종료와 잡힌 예외 뒤에만 실행 (인터프리터와 같이, 전파되는 예외는 바로 빠져나감)
+            compile_statement(compiler, node->data.try_catch.finally_block);
+            break;
+        }
+        
+        case AST_THROW:
+            compile_expression(compiler, node->data.throw_stmt.exception_value);
+            bytecode_emit(compiler->chunk, OP_THROW);
+            break;
+        
+        case AST_EXPORT:
+            // 단일 파일 실행에서는 export 대상만 그대로 컴파일
+            compile_statement(compiler, node->data.export_stmt.node);
+            break;
+        
         default:
             // 표현식으로 처리 (함수 호출은 제외)
             if (node->type != AST_FUNCTION_CALL) {
@@ -311,14 +696,401 @@ BytecodeChunk* compile(ASTNode* node) {
     // HALT 추가
     bytecode_emit(compiler->chunk, OP_HALT);
     
+    // 깊이가 맞지 않는 청크 (파서가 피연산자를 비워 둔 식 등)도 컴파일 에러로 (호출한 쪽이 인터프리터로 실행)
+    if (!compiler->error && bytecode_compute_max_stack(compiler->chunk) < 0) {
+        compiler_error(compiler, "unsupported expression");
+    }
+    
+    if (compiler->error) {
+        fprintf(stderr, "Compile error: %s\n", compiler->error);
+        bytecode_chunk_free(compiler->chunk);
+        compiler_free(compiler);
+        return NULL;
+    }
+    
+    // 전역 슬롯 테이블을 청크로 넘김 (VM이 전역 배열 크기와 에러 메시지에 사용)
     BytecodeChunk* chunk = compiler->chunk;
+    chunk->global_names = compiler->globals;
+    chunk->global_count = compiler->global_count;
+    compiler->globals = NULL;
+    compiler->global_count = 0;
     compiler->chunk = NULL;
     compiler_free(compiler);
     
     return chunk;
 }
 
-// 최적화 (나중에 구현)
+// ============ 핍홀 최적화 ============
+//
+// 바이트 스트림을 명령어 배열로 풀어서 패턴을 고친 뒤 다시 인코딩한다.
+// 점프는 명령어 인덱스로 들고 있다가 재인코딩할 때 새 오프셋으로 옮긴다.
+//  - 상수 접기: LOAD_CONST a; LOAD_CONST b; ADD → LOAD_CONST (a+b), LOAD_CONST n; NEGATE,
+//               LOAD_CONST a; ADD_CONST b
+//  - 상수 조건: LOAD_TRUE; JUMP_IF_FALSE → 제거, LOAD_FALSE; JUMP_IF_FALSE → JUMP
+//  - 쓸모없는 푸시: LOAD_*; POP → 제거
+//  - 저장 후 재로드: STORE x; POP; LOAD x → STORE x
+//  - 점프 스레딩: JUMP → JUMP → L 을 JUMP → L 로, 바로 다음으로 가는 점프 제거
+//  - 죽은 코드: 무조건 점프/HALT/RETURN 뒤에서 다음 점프 목적지까지 제거
+// 점프 목적지인 명령어는 패턴 중간에 끼지 않도록 검사한다.
+// 예외 핸들러의 범위와 목적지도 명령어 인덱스로 바꿔 두고 점프 목적지처럼 취급한다.
+
+typedef struct {
+    OpCode opcode;
+    int64_t operand;
+    int target;       // 점프 목적지 (명령어 인덱스, 점프가 아니면 -1)
+    int is_target;    // 다른 점프의 목적지인지
+    int removed;
+    int line;         // 소스 라인 (재인코딩할 때 라인 테이블을 다시 만듦)
+} OptInstr;
+
+// _LONG 변형은 기본 opcode로 (재인코딩할 때 피연산자 크기를 다시 고름)
+static OpCode base_opcode(OpCode opcode) {
+    switch (opcode) {
+        case OP_LOAD_CONST_LONG: return OP_LOAD_CONST;
+        case OP_LOAD_GLOBAL_LONG: return OP_LOAD_GLOBAL;
+        case OP_STORE_GLOBAL_LONG: return OP_STORE_GLOBAL;
+        case OP_BUILD_ARRAY_LONG: return OP_BUILD_ARRAY;
+        default: return opcode;
+    }
+}
+
+static int is_forward_jump(OpCode opcode) {
+    return opcode == OP_JUMP || opcode == OP_JUMP_IF_FALSE || opcode == OP_JUMP_IF_TRUE ||
+           opcode == OP_JUMP_IF_NOT_LESS;
+}
+
+// i 다음의 살아있는 명령어 (없으면 count)
+static int next_live(OptInstr* code, int count, int i) {
+    for (i++; i < count && code[i].removed; i++);
+    return i;
+}
+
+// target 이후 첫 살아있는 명령어
+static int resolve_target(OptInstr* code, int count, int target) {
+    while (target < count && code[target].removed) target++;
+    return target;
+}
+
+// 명령어 제거 (점프 목적지였다면 다음 살아있는 명령어가 목적지가 됨)
+static void remove_instr(OptInstr* code, int count, int i) {
+    code[i].removed = 1;
+    if (code[i].is_target) {
+        int next = next_live(code, count, i);
+        if (next < count) code[next].is_target = 1;
+    }
+}
+
+// 점프 목적지 표시 다시 계산 (예외 핸들러의 경계와 목적지 포함)
+static void mark_jump_targets(BytecodeChunk* chunk, OptInstr* code, int count) {
+    for (int i = 0; i < count; i++) {
+        code[i].is_target = 0;
+    }
+    for (int i = 0; i < count; i++) {
+        if (!code[i].removed && code[i].target >= 0) {
+            code[i].target = resolve_target(code, count, code[i].target);
+            code[code[i].target].is_target = 1;
+        }
+    }
+    for (int i = 0; i < chunk->handler_count; i++) {
+        BytecodeHandler* entry = &chunk->handlers[i];
+        entry->start = resolve_target(code, count, entry->start);
+        entry->end = resolve_target(code, count, entry->end);
+        entry->handler = resolve_target(code, count, entry->handler);
+        code[entry->start].is_target = 1;
+        code[entry->end].is_target = 1;
+        code[entry->handler].is_target = 1;
+    }
+}
+
+// 상수 두 개에 이항 연산 적용 (접을 수 없으면 0 반환)
+static int fold_binary(BytecodeChunk* chunk, OpCode opcode, Value* left, Value* right, OptInstr* out) {
+    if (left->type == VAL_NUMBER && right->type == VAL_NUMBER) {
+        double l = left->data.number;
+        double r = right->data.number;
+        double result;
+        
+        switch (opcode) {
+            case OP_ADD: result = l + r; break;
+            case OP_SUBTRACT: result = l - r; break;
+            case OP_MULTIPLY: result = l * r; break;
+            case OP_DIVIDE: if (r == 0) return 0; result = l / r; break;
+            case OP_MODULO: if (r == 0) return 0; result = fmod(l, r); break;
+            case OP_FLOOR_DIV: if (r == 0) return 0; result = floor(l / r); break;
+            
+            // 비교 결과는 LOAD_TRUE/LOAD_FALSE
+            case OP_EQUAL: out->opcode = (l == r) ? OP_LOAD_TRUE : OP_LOAD_FALSE; return 1;
+            case OP_NOT_EQUAL: out->opcode = (l != r) ? OP_LOAD_TRUE : OP_LOAD_FALSE; return 1;
+            case OP_LESS: out->opcode = (l < r) ? OP_LOAD_TRUE : OP_LOAD_FALSE; return 1;
+            case OP_LESS_EQUAL: out->opcode = (l <= r) ? OP_LOAD_TRUE : OP_LOAD_FALSE; return 1;
+            case OP_GREATER: out->opcode = (l > r) ? OP_LOAD_TRUE : OP_LOAD_FALSE; return 1;
+            case OP_GREATER_EQUAL: out->opcode = (l >= r) ? OP_LOAD_TRUE : OP_LOAD_FALSE; return 1;
+            default: return 0;
+        }
+        
+        out->opcode = OP_LOAD_CONST;
+        out->operand = bytecode_add_constant(chunk, value_create_number(result));
+        return 1;
+    }
+    
+    if (left->type == VAL_STRING && right->type == VAL_STRING && opcode == OP_ADD) {
+        char* result = (char*)malloc(strlen(left->data.string) + strlen(right->data.string) + 1);
+        strcpy(result, left->data.string);
+        strcat(result, right->data.string);
+        out->opcode = OP_LOAD_CONST;
+        out->operand = bytecode_add_constant(chunk, value_create_string(result));
+        free(result);
+        return 1;
+    }
+    
+    return 0;
+}
+
+// 스택에 값 하나만 올리고 부작용이 없는 명령어
+static int is_pure_push(OpCode opcode) {
+    switch (opcode) {
+        case OP_LOAD_CONST:
+        case OP_LOAD_TRUE:
+        case OP_LOAD_FALSE:
+        case OP_LOAD_NULL:
+        case OP_LOAD_LOCAL:
+        case OP_DUP:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+// STORE에 대응하는 LOAD
+static int load_for_store(OpCode opcode) {
+    switch (opcode) {
+        case OP_STORE_GLOBAL: return OP_LOAD_GLOBAL;
+        case OP_STORE_LOCAL: return OP_LOAD_LOCAL;
+        default: return -1;
+    }
+}
+
+// 패턴 한 바퀴 (바뀐 게 있으면 1)
+static int peephole_pass(BytecodeChunk* chunk, OptInstr* code, int count) {
+    int changed = 0;
+    mark_jump_targets(chunk, code, count);
+    
+    for (int i = 0; i < count; i++) {
+        OptInstr* a = &code[i];
+        if (a->removed) continue;
+        
+        int j = next_live(code, count, i);
+        int k = j < count ? next_live(code, count, j) : count;
+        OptInstr* b = j < count && !code[j].is_target ? &code[j] : NULL;
+        OptInstr* c = b && k < count && !code[k].is_target ? &code[k] : NULL;
+        
+        // 상수 접기 (이항)
+        if (a->opcode == OP_LOAD_CONST && b && b->opcode == OP_LOAD_CONST && c) {
+            OptInstr folded = *a;
+            if (fold_binary(chunk, c->opcode, chunk->constants[a->operand], 
+                            chunk->constants[b->operand], &folded)) {
+                *a = folded;
+                remove_instr(code, count, j);
+                remove_instr(code, count, k);
+                changed = 1;
+                continue;
+            }
+        }
+        
+        // 상수 접기 (LOAD_CONST a; ADD_CONST b)
+        if (a->opcode == OP_LOAD_CONST && b && b->opcode == OP_ADD_CONST) {
+            OptInstr folded = *a;
+            if (fold_binary(chunk, OP_ADD, chunk->constants[a->operand], 
+                            chunk->constants[b->operand], &folded)) {
+                *a = folded;
+                remove_instr(code, count, j);
+                changed = 1;
+                continue;
+            }
+        }
+        
+        // 상수 접기 (단항 -)
+        if (a->opcode == OP_LOAD_CONST && b && b->opcode == OP_NEGATE &&
+            chunk->constants[a->operand]->type == VAL_NUMBER) {
+            a->operand = bytecode_add_constant(chunk, 
+                value_create_number(-chunk->constants[a->operand]->data.number));
+            remove_instr(code, count, j);
+            changed = 1;
+            continue;
+        }
+        
+        // 상수 조건 분기
+        if ((a->opcode == OP_LOAD_TRUE || a->opcode == OP_LOAD_FALSE) && 
+            b && b->opcode == OP_JUMP_IF_FALSE) {
+            if (a->opcode == OP_LOAD_TRUE) {
+                remove_instr(code, count, j);
+            } else {
+                b->opcode = OP_JUMP;
+            }
+            remove_instr(code, count, i);
+            changed = 1;
+            continue;
+        }
+        
+        // 쓸모없는 푸시
+        if (is_pure_push(a->opcode) && b && b->opcode == OP_POP) {
+            remove_instr(code, count, i);
+            remove_instr(code, count, j);
+            changed = 1;
+            continue;
+        }
+        
+        // STORE x; POP; LOAD x → STORE x
+        if (load_for_store(a->opcode) >= 0 && b && b->opcode == OP_POP && c &&
+            (int)c->opcode == load_for_store(a->opcode) && c->operand == a->operand) {
+            remove_instr(code, count, j);
+            remove_instr(code, count, k);
+            changed = 1;
+            continue;
+        }
+        
+        // 점프 스레딩 (앞쪽 무조건 점프만 따라감)
+        if (is_forward_jump(a->opcode)) {
+            a->target = resolve_target(code, count, a->target);
+            int target = a->target;
+            int hops = 0;
+            while (code[target].opcode == OP_JUMP && code[target].target != target && hops++ < count) {
+                target = resolve_target(code, count, code[target].target);
+            }
+            if (target != a->target) {
+                a->target = target;
+                changed = 1;
+            }
+            
+            // 바로 다음 명령어로 가는 점프 (피연산자 두 개를 쓰는 비교-분기는 제외)
+            if (a->target == j && a->opcode != OP_JUMP_IF_NOT_LESS) {
+                if (a->opcode == OP_JUMP) {
+                    remove_instr(code, count, i);
+                } else {
+                    a->opcode = OP_POP;  // 조건 값은 여전히 버려야 함
+                    a->target = -1;
+                }
+                changed = 1;
+                continue;
+            }
+        }
+        
+        // 죽은 코드 (마지막 HALT는 남김)
+        if (a->opcode == OP_JUMP || a->opcode == OP_LOOP || a->opcode == OP_HALT || 
+            a->opcode == OP_RETURN || a->opcode == OP_THROW) {
+            for (int d = j; d < count - 1 && !code[d].is_target; d = next_live(code, count, d)) {
+                remove_instr(code, count, d);
+                changed = 1;
+            }
+        }
+    }
+    
+    return changed;
+}
+
+// 명령어 배열 → 바이트 스트림 (피연산자 크기를 다시 고르고 점프 오프셋 재계산)
+static void reencode_chunk(BytecodeChunk* chunk, OptInstr* code, int count) {
+    int* new_offset = (int*)malloc(sizeof(int) * (count + 1));
+    int offset = 0;
+    
+    for (int i = 0; i < count; i++) {
+        new_offset[i] = offset;
+        if (code[i].removed) continue;
+        
+        int width = bytecode_operand_width(code[i].opcode);
+        if (width == 1 && code[i].operand > UINT8_MAX) width = 4;  // _LONG 변형
+        offset += 1 + width;
+    }
+    new_offset[count] = offset;
+    
+    uint8_t* old_code = chunk->code;
+    chunk->code = NULL;
+    chunk->count = 0;
+    chunk->capacity = 0;
+    chunk->line_count = 0;
+    
+    for (int i = 0; i < count; i++) {
+        OptInstr* instr = &code[i];
+        if (instr->removed) continue;
+        
+        bytecode_set_line(chunk, instr->line);
+        if (instr->target >= 0) {
+            int end = new_offset[i] + 3;
+            int target = new_offset[resolve_target(code, count, instr->target)];
+            int jump = instr->opcode == OP_LOOP ? end - target : target - end;
+            if (jump > JUMP_MAX) {
+                fprintf(stderr, "Too much code to jump over\n");
+                exit(1);
+            }
+            bytecode_emit_with_operand(chunk, instr->opcode, jump);
+        } else if (bytecode_operand_width(instr->opcode) > 0) {
+            bytecode_emit_with_operand(chunk, instr->opcode, instr->operand);
+        } else {
+            bytecode_emit(chunk, instr->opcode);
+        }
+    }
+    
+    // 예외 핸들러 (try 블록이 통째로 지워졌으면 항목도 버림)
+    int handler_count = 0;
+    for (int i = 0; i < chunk->handler_count; i++) {
+        BytecodeHandler entry = chunk->handlers[i];
+        entry.start = new_offset[resolve_target(code, count, entry.start)];
+        entry.end = new_offset[resolve_target(code, count, entry.end)];
+        entry.handler = new_offset[resolve_target(code, count, entry.handler)];
+        if (entry.start < entry.end) {
+            chunk->handlers[handler_count++] = entry;
+        }
+    }
+    chunk->handler_count = handler_count;
+    
+    free(old_code);
+    free(new_offset);
+}
+
+// 최적화 (함수 청크도 같이)
 void optimize_chunk(BytecodeChunk* chunk) {
-    // TODO
+    for (int i = 0; i < chunk->constant_count; i++) {
+        Value* constant = chunk->constants[i];
+        if (constant->type == VAL_FUNCTION && constant->data.function->chunk) {
+            optimize_chunk(constant->data.function->chunk);
+        }
+    }
+    
+    // 바이트 오프셋 → 명령어 인덱스
+    int* index_of = (int*)malloc(sizeof(int) * (chunk->count + 1));
+    OptInstr* code = (OptInstr*)malloc(sizeof(OptInstr) * (chunk->count + 1));
+    int count = 0;
+    
+    for (int offset = 0; offset < chunk->count; 
+         offset += bytecode_instruction_length(chunk, offset)) {
+        index_of[offset] = count;
+        code[count].opcode = base_opcode((OpCode)chunk->code[offset]);
+        code[count].operand = bytecode_read_operand(chunk, offset);
+        code[count].target = bytecode_jump_target(chunk, offset);
+        code[count].is_target = 0;
+        code[count].removed = 0;
+        code[count].line = bytecode_line_at(chunk, offset);
+        count++;
+    }
+    index_of[chunk->count] = count;
+    
+    // 점프 목적지와 예외 핸들러 오프셋을 명령어 인덱스로
+    for (int i = 0; i < count; i++) {
+        if (code[i].target >= 0) {
+            code[i].target = index_of[code[i].target];
+        }
+    }
+    for (int i = 0; i < chunk->handler_count; i++) {
+        BytecodeHandler* entry = &chunk->handlers[i];
+        entry->start = index_of[entry->start];
+        entry->end = index_of[entry->end];
+        entry->handler = index_of[entry->handler];
+    }
+    
+    while (peephole_pass(chunk, code, count));
+    
+    reencode_chunk(chunk, code, count);
+    bytecode_compute_max_stack(chunk);  // 죽은 코드 제거/상수 접기로 깊이가 바뀔 수 있음
+    
+    free(code);
+    free(index_of);
 }
@@ -5,23 +5,46 @@
 #include "parser.h"
 #include "interpreter.h"
 
-// 컴파일러 구조체
+#define LOCALS_MAX 256
+
+// 지역 변수 (VM 스택 슬롯에 저장)
 typedef struct {
+    char* name;
+} Local;
+
+// 컴파일러 구조체 (함수마다 하나, enclosing으로 바깥 컴파일러 연결)
+typedef struct Compiler {
+    struct Compiler* enclosing;  // 함수 컴파일 중이면 스크립트 컴파일러, 아니면 NULL
     BytecodeChunk* chunk;
-    Environment* env;
     int loop_start;     // 루프 시작 위치
     int loop_depth;     // 중첩 루프 깊이
+
+    // 전역 변수 슬롯 테이블 (이름 → 슬롯 번호, 최상위 컴파일러만 사용)
+    char** globals;
+    int global_count;
+    int global_capacity;
+
+    // 지역 변수 (프레임 기준 스택 슬롯)
+    Local locals[LOCALS_MAX];
+    int local_count;
+    
+    // 컴파일 에러 (VM이 지원하지 않는 구문, 최상위 컴파일러에 기록)
+    const char* error;
 } Compiler;
 
 // 컴파일러 함수
 Compiler* compiler_create();
 void compiler_free(Compiler* compiler);
 
-// AST → 바이트코드 컴파일
+// AST → 바이트코드 컴파일 (VM이 지원하지 않는 구문이 있으면 NULL)
 BytecodeChunk* compile(ASTNode* node);
 void compile_statement(Compiler* compiler, ASTNode* node);
 void compile_expression(Compiler* compiler, ASTNode* node);
 
+// 내장 함수 분류 (레지스터 컴파일러와 공용)
+int compiler_builtin_id(char* name);              // VM이 구현한 내장 함수 번호, 없으면 -1
+int compiler_is_interpreter_builtin(char* name);  // 인터프리터에만 있는 내장 함수인지
+
 // 최적화 (선택적)
 void optimize_chunk(BytecodeChunk* chunk);
 
@@ -0,0 +1,484 @@
+#include "gc.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// 값의 gc_next 아래 두 비트 (값 헤더는 슬랩 칸이라 8바이트 정렬, 아래 비트가 비어 있음)
+#define GC_MARKED ((uintptr_t)1)
+#define GC_PINNED ((uintptr_t)2)
+#define GC_FLAGS  (GC_MARKED | GC_PINNED)
+
+#define NEXT_OF(value)  ((Value*)((uintptr_t)(value)->gc_next & ~GC_FLAGS))
+#define FLAGS_OF(value) ((uintptr_t)(value)->gc_next & GC_FLAGS)
+
+static void set_next(Value* value, Value* next) {
+    value->gc_next = (Value*)((uintptr_t)next | FLAGS_OF(value));
+}
+
+static void set_flag(Value* value, uintptr_t flag) {
+    value->gc_next = (Value*)((uintptr_t)value->gc_next | flag);
+}
+
+static void clear_mark(Value* value) {
+    value->gc_next = (Value*)((uintptr_t)value->gc_next & ~GC_MARKED);
+}
+
+size_t gc_allocated = 0;
+size_t gc_threshold = GC_MIN_THRESHOLD;
+int gc_marking = 0;
+GCStats gc_stats;
+Slab gc_value_slab;
+static Slab body_slabs[GC_BODY_CLASSES];
+
+static Value* values = NULL;
+static Environment* environments = NULL;
+
+// 점진 모드 상태
+typedef enum {
+    GC_IDLE,   // 수집 중이 아님
+    GC_MARK,   // 표시 중 (쓰기 장벽 켜짐)
+    GC_SWEEP   // 스윕 중 (표시가 끝난 목록을 떼어 두고 조금씩 해제)
+} GCPhase;
+
+static int incremental = 0;
+static long pause_budget_us = GC_DEFAULT_PAUSE_US;
+static GCPhase phase = GC_IDLE;
+
+static Value* sweep_values = NULL;              // 아직 스윕하지 않은 값 (스윕 중 새 값은 values로)
+static Environment* sweep_environments = NULL;
+static size_t sweep_live = 0;                   // 스윕하면서 살아남은 양
+static size_t allocated_at_sweep = 0;           // 스윕을 시작할 때의 gc_allocated
+
+// 임시 루트 (환경은 아래 비트 1로 구분)
+#define ENV_ROOT(env) ((void*)((uintptr_t)(env) | 1))
+
+static void** temp_roots = NULL;
+static int temp_count = 0;
+static int temp_capacity = 0;
+static int scope_depth = 0;  // 열린 스코프가 없으면 (VM 실행 중 등) 임시 루트를 쌓지 않음
+
+static Value** pinned = NULL;
+static int pinned_count = 0;
+static int pinned_capacity = 0;
+
+typedef struct {
+    GCRootMarker marker;
+    void* context;
+} RootSource;
+
+static RootSource* root_sources = NULL;
+static int root_source_count = 0;
+static int root_source_capacity = 0;
+
+// 표시할 값 (재귀 대신 명시적 스택, 깊은 배열/환경 사슬에서도 C 스택을 쓰지 않음)
+static Value** gray = NULL;
+static int gray_count = 0;
+static int gray_capacity = 0;
+
+static void push_temp_root(void* root) {
+    if (temp_count >= temp_capacity) {
+        temp_capacity = temp_capacity < 8 ? 8 : temp_capacity * 2;
+        temp_roots = (void**)realloc(temp_roots, sizeof(void*) * temp_capacity);
+    }
+    temp_roots[temp_count++] = root;
+}
+
+Value* gc_alloc_value(void) {
+    if (gc_value_slab.object_size == 0) slab_init(&gc_value_slab, sizeof(Value));
+
+    Value* value = (Value*)slab_alloc(&gc_value_slab);
+    value->gc_next = values;
+    values = value;
+    gc_allocated += sizeof(Value);
+    if (scope_depth > 0) push_temp_root(value);
+    return value;
+}
+
+void* gc_alloc_body(size_t size) {
+    gc_allocated += size;
+    size_t index = (size + GC_BODY_CLASS - 1) / GC_BODY_CLASS - 1;
+    if (index >= GC_BODY_CLASSES) return calloc(1, size);
+
+    Slab* slab = &body_slabs[index];
+    if (slab->object_size == 0) slab_init(slab, (index + 1) * GC_BODY_CLASS);
+    void* body = slab_alloc(slab);
+    memset(body, 0, slab->object_size);
+    return body;
+}
+
+void gc_free_body(void* body, size_t size) {
+    size_t index = (size + GC_BODY_CLASS - 1) / GC_BODY_CLASS - 1;
+    if (index >= GC_BODY_CLASSES) {
+        free(body);
+        return;
+    }
+    slab_free(&body_slabs[index], body);
+}
+
+// 환경 하나가 차지하는 바이트 (배열을 따로 할당했으면 배열과 이름 해시 테이블까지)
+static size_t environment_size(Environment* env) {
+    size_t size = sizeof(Environment);
+    if (!ENV_IS_INLINE(env)) size += (sizeof(char*) + sizeof(Value*)) * (size_t)env->capacity;
+    return size + sizeof(int) * (size_t)env->index_capacity;
+}
+
+void gc_track_environment(Environment* env) {
+    env->gc_next = environments;
+    env->gc_marked = 0;
+    environments = env;
+    gc_allocated += environment_size(env);
+    if (scope_depth > 0) push_temp_root(ENV_ROOT(env));
+}
+
+void gc_account(size_t size) {
+    gc_allocated += size;
+}
+
+void gc_pin(Value* value) {
+    if (FLAGS_OF(value) & GC_PINNED) return;
+    set_flag(value, GC_PINNED);
+
+    if (pinned_count >= pinned_capacity) {
+        pinned_capacity = pinned_capacity < 8 ? 8 : pinned_capacity * 2;
+        pinned = (Value**)realloc(pinned, sizeof(Value*) * pinned_capacity);
+    }
+    pinned[pinned_count++] = value;
+}
+
+int gc_scope_begin(void) {
+    scope_depth++;
+    return temp_count;
+}
+
+void gc_scope_end(int mark) {
+    scope_depth--;
+    temp_count = mark;
+}
+
+void gc_keep(Value* value) {
+    if (scope_depth > 0 && value) push_temp_root(value);
+}
+
+void gc_add_roots(GCRootMarker marker, void* context) {
+    if (root_source_count >= root_source_capacity) {
+        root_source_capacity = root_source_capacity < 8 ? 8 : root_source_capacity * 2;
+        root_sources = (RootSource*)realloc(root_sources, sizeof(RootSource) * root_source_capacity);
+    }
+    root_sources[root_source_count].marker = marker;
+    root_sources[root_source_count].context = context;
+    root_source_count++;
+}
+
+void gc_remove_roots(GCRootMarker marker, void* context) {
+    for (int i = 0; i < root_source_count; i++) {
+        if (root_sources[i].marker == marker && root_sources[i].context == context) {
+            root_sources[i] = root_sources[--root_source_count];
+            return;
+        }
+    }
+}
+
+void gc_mark_value(Value* value) {
+    if (!value || (FLAGS_OF(value) & GC_MARKED)) return;
+    set_flag(value, GC_MARKED);
+
+    // 자식이 없는 값은 회색 스택에 넣지 않음
+    switch (value->type) {
+        case VAL_ARRAY:
+        case VAL_DICT:
+        case VAL_FUNCTION:
+        case VAL_INSTANCE:
+        case VAL_MODULE:
+            break;
+        default:
+            return;
+    }
+
+    if (gray_count >= gray_capacity) {
+        gray_capacity = gray_capacity < 64 ? 64 : gray_capacity * 2;
+        gray = (Value**)realloc(gray, sizeof(Value*) * gray_capacity);
+    }
+    gray[gray_count++] = value;
+}
+
+void gc_mark_environment(Environment* env) {
+    // 부모 사슬은 반복으로 (이미 표시된 환경에서 멈춤)
+    for (; env && !env->gc_marked; env = env->parent) {
+        env->gc_marked = 1;
+        for (int i = 0; i < env->count; i++) gc_mark_value(env->values[i]);
+    }
+}
+
+// 회색 값의 자식 표시
+static void blacken(Value* value) {
+    switch (value->type) {
+        case VAL_ARRAY:
+            for (int i = 0; i < value->data.array->count; i++) {
+                gc_mark_value(value->data.array->elements[i]);
+            }
+            break;
+        case VAL_DICT:
+            for (int i = 0; i < value->data.dict->count; i++) {
+                gc_mark_value(value->data.dict->values[i]);
+            }
+            break;
+        case VAL_FUNCTION:
+            gc_mark_environment(value->data.function->closure);
+            break;
+        case VAL_INSTANCE:
+            for (int i = 0; i < value->data.instance->field_count; i++) {
+                gc_mark_value(value->data.instance->field_values[i]);
+            }
+            break;
+        case VAL_MODULE:
+            gc_mark_environment(value->data.module->exports);
+            break;
+        default:
+            break;
+    }
+}
+
+static void mark_roots(void) {
+    for (int i = 0; i < root_source_count; i++) {
+        root_sources[i].marker(root_sources[i].context);
+    }
+    for (int i = 0; i < pinned_count; i++) {
+        gc_mark_value(pinned[i]);
+    }
+    for (int i = 0; i < temp_count; i++) {
+        uintptr_t root = (uintptr_t)temp_roots[i];
+        if (root & 1) {
+            gc_mark_environment((Environment*)(root & ~(uintptr_t)1));
+        } else {
+            gc_mark_value((Value*)root);
+        }
+    }
+}
+
+// 값 하나가 차지하는 대략의 바이트 (수집 뒤 살아남은 양 계산용)
+static size_t value_size(Value* value) {
+    size_t size = sizeof(Value) + value_body_size(value->type);
+    switch (value->type) {
+        case VAL_ARRAY:
+            size += sizeof(Value*) * (size_t)value->data.array->count;
+            break;
+        case VAL_DICT:
+            size += (sizeof(char*) + sizeof(Value*)) * (size_t)value->data.dict->count;
+            break;
+        case VAL_INSTANCE:
+            size += (sizeof(char*) + sizeof(Value*)) * (size_t)value->data.instance->field_count;
+            break;
+        case VAL_MATRIX:
+            size += sizeof(double) * (size_t)value->data.matrix->rows * (size_t)value->data.matrix->cols;
+            break;
+        default:
+            break;
+    }
+    return size;
+}
+
+static double now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+// 한 단계에서 처리한 값/환경 수 (gc_step이 0으로 되돌림)
+// 멈춤 목표가 아주 짧아도 단계마다 GC_STEP_MIN_WORK까지는 시간을 보지 않고 진행해서,
+// 단계 사이의 할당(GC_STEP_SIZE)이 수집을 계속 앞질러 한 주기도 끝나지 않는 일이 없게 한다
+#define GC_STEP_MIN_WORK ((long)(2 * GC_STEP_SIZE / sizeof(Value)))
+static long step_work = 0;
+
+// 시간이 다 됐으면 1 (deadline이 0이면 끝까지)
+static int out_of_time(double deadline) {
+    return deadline > 0 && ++step_work >= GC_STEP_MIN_WORK && (step_work & 63) == 0 &&
+           now_us() >= deadline;
+}
+
+static void record_pause(double us) {
+    gc_stats.pauses++;
+    gc_stats.total_pause_us += us;
+    if (us > gc_stats.max_pause_us) gc_stats.max_pause_us = us;
+
+    int bucket = 0;
+    while (bucket < GC_PAUSE_BUCKETS - 1 && us >= (double)(1L << bucket)) bucket++;
+    gc_stats.histogram[bucket]++;
+}
+
+// 회색 값을 검게 (deadline이 0이면 끝까지, 아니면 시간이 다 되면 멈춤), 다 비우면 1
+static int drain_gray(double deadline) {
+    while (gray_count > 0) {
+        blacken(gray[--gray_count]);
+        if (out_of_time(deadline)) {
+            return gray_count == 0;
+        }
+    }
+    return 1;
+}
+
+// 표시가 끝난 목록을 스윕 목록으로 떼어 냄 (이후 새로 만든 값/환경은 원래 목록으로 감)
+static void begin_sweep(void) {
+    gc_marking = 0;
+    phase = GC_SWEEP;
+    sweep_values = values;
+    sweep_environments = environments;
+    values = NULL;
+    environments = NULL;
+    sweep_live = 0;
+    allocated_at_sweep = gc_allocated;
+}
+
+// 스윕 목록에서 표시된 것은 표시를 지우고 원래 목록으로 되돌리고, 나머지는 해제. 다 끝나면 1
+static int sweep_some(double deadline) {
+    while (sweep_values) {
+        Value* value = sweep_values;
+        sweep_values = NEXT_OF(value);
+        size_t size = value_size(value);
+        if (FLAGS_OF(value) & GC_MARKED) {
+            clear_mark(value);
+            set_next(value, values);
+            values = value;
+            sweep_live += size;
+        } else {
+            gc_stats.freed_bytes += size;
+            value_destroy(value);
+            slab_free(&gc_value_slab, value);
+        }
+        if (out_of_time(deadline)) return 0;
+    }
+
+    while (sweep_environments) {
+        Environment* env = sweep_environments;
+        sweep_environments = env->gc_next;
+        size_t size = environment_size(env);
+        if (env->gc_marked) {
+            env->gc_marked = 0;
+            env->gc_next = environments;
+            environments = env;
+            sweep_live += size;
+        } else {
+            gc_stats.freed_bytes += size;
+            environment_free(env);
+        }
+        if (out_of_time(deadline)) return 0;
+    }
+
+    return 1;
+}
+
+// 스윕이 끝남: 살아남은 양 + 스윕 중에 새로 할당한 양을 기준으로 다음 문턱
+static void finish_cycle(void) {
+    phase = GC_IDLE;
+    gc_allocated = sweep_live + (gc_allocated - allocated_at_sweep);
+    gc_threshold = sweep_live * 2 < GC_MIN_THRESHOLD ? GC_MIN_THRESHOLD : sweep_live * 2;
+    gc_stats.cycles++;
+}
+
+// 큰 구조가 죽어서 다음 주기까지 쓸 칸보다 슬랩 페이지가 두 배 넘게 많으면 빈 페이지를 OS에 돌려줌
+// slab_trim은 자유 목록 전체를 훑으므로 마지막 정리 뒤로 페이지가 늘었을 때만, 한 번에 다 스윕한 뒤에만 부름
+static void trim_value_slab(void) {
+    static size_t trimmed_pages = 0;
+    size_t per_page = SLAB_PAGE_SIZE / sizeof(Value);
+    size_t needed = (slab_live(&gc_value_slab) + gc_threshold / sizeof(Value)) / per_page + 1;
+
+    if (gc_value_slab.page_count > 2 * needed && gc_value_slab.page_count > trimmed_pages) {
+        slab_trim(&gc_value_slab);
+        trimmed_pages = gc_value_slab.page_count;
+    }
+}
+
+void gc_set_incremental(long pause_us) {
+    incremental = 1;
+    if (pause_us > 0) pause_budget_us = pause_us;
+}
+
+void gc_collect(void) {
+    double start = now_us();
+
+    // 점진 표시 중이었으면 루트를 다시 훑는 것으로 마무리 (처음부터면 그냥 표시)
+    if (phase != GC_SWEEP) {
+        mark_roots();
+        drain_gray(0);
+        begin_sweep();
+    }
+    sweep_some(0);
+    finish_cycle();
+
+    trim_value_slab();
+
+    record_pause(now_us() - start);
+}
+
+void gc_step(void) {
+    if (!incremental) {
+        gc_collect();
+        return;
+    }
+
+    double start = now_us();
+    double deadline = start + (double)pause_budget_us;
+    step_work = 0;
+
+    do {
+        if (phase == GC_IDLE) {
+            // 루트를 회색으로 칠하고 표시 시작
+            mark_roots();
+            phase = GC_MARK;
+            gc_marking = 1;
+        } else if (phase == GC_MARK) {
+            if (drain_gray(deadline)) {
+                // 마무리 (한 번에): 장벽 없이 바뀐 루트를 다시 훑고 새로 닿은 것까지 표시
+                mark_roots();
+                drain_gray(0);
+                begin_sweep();
+            }
+        } else if (sweep_some(deadline)) {
+            finish_cycle();
+            break;
+        }
+    } while (step_work < GC_STEP_MIN_WORK || now_us() < deadline);
+
+    // 수집이 안 끝났으면 GC_STEP_SIZE만큼 더 할당한 뒤 다음 단계
+    if (phase != GC_IDLE) gc_threshold = gc_allocated + GC_STEP_SIZE;
+
+    record_pause(now_us() - start);
+}
+
+// 히스토그램에서 백분위가 들어 있는 칸의 위쪽 경계 (마이크로초)
+static long pause_percentile(double fraction) {
+    long target = (long)(fraction * gc_stats.pauses + 0.5);
+    long seen = 0;
+    for (int i = 0; i < GC_PAUSE_BUCKETS; i++) {
+        seen += gc_stats.histogram[i];
+        if (seen >= target && seen > 0) return 1L << i;
+    }
+    return 1L << (GC_PAUSE_BUCKETS - 1);
+}
+
+void gc_print_stats(FILE* out) {
+    fprintf(out, "\n=== GC Stats ===\n");
+    if (incremental) {
+        fprintf(out, "mode:        incremental (pause budget %ldus)\n", pause_budget_us);
+    } else {
+        fprintf(out, "mode:        stop-the-world\n");
+    }
+    fprintf(out, "cycles:      %ld\n", gc_stats.cycles);
+    fprintf(out, "pauses:      %ld\n", gc_stats.pauses);
+    fprintf(out, "freed:       %zu KB\n", gc_stats.freed_bytes / 1024);
+    fprintf(out, "heap:        %zu KB\n", gc_allocated / 1024);
+    fprintf(out, "values:      %zu allocated, %zu live, %zu slab pages\n",
+            gc_value_slab.allocations, slab_live(&gc_value_slab), gc_value_slab.page_count);
+    for (int i = 0; i < GC_BODY_CLASSES; i++) {
+        if (body_slabs[i].allocations == 0) continue;
+        fprintf(out, "bodies %2d B: %zu allocated, %zu live, %zu slab pages\n", (i + 1) * GC_BODY_CLASS,
+                body_slabs[i].allocations, slab_live(&body_slabs[i]), body_slabs[i].page_count);
+    }
+    if (gc_stats.pauses == 0) return;
+
+    fprintf(out, "pause total: %.3f ms\n", gc_stats.total_pause_us / 1000.0);
+    fprintf(out, "pause mean:  %.1f us\n", gc_stats.total_pause_us / gc_stats.pauses);
+    fprintf(out, "pause max:   %.1f us\n", gc_stats.max_pause_us);
+    fprintf(out, "pause p50:   < %ld us\n", pause_percentile(0.50));
+    fprintf(out, "pause p99:   < %ld us\n", pause_percentile(0.99));
+}
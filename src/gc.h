@@ -0,0 +1,103 @@
+#ifndef GC_H
+#define GC_H
+
+#include <stddef.h>
+#include <stdio.h>
+#include "interpreter.h"
+#include "slab.h"
+
+// 정밀 마크-스윕 가비지 컬렉터
+//
+// value_create_*/value_alloc과 environment_create로 만든 값/환경은 모두 GC 목록에 들어가고,
+// 루트에서 닿지 않으면 수집 때 해제된다 (value_free는 아무것도 하지 않음).
+//
+// 루트:
+//   - gc_add_roots로 등록한 함수 (인터프리터: 전역/현재 환경, 반환값, 예외, 모듈 캐시 /
+//     VM: 스택, 전역 슬롯, 던질 예외 / 레지스터 VM: 프레임 창의 레지스터)
+//   - 고정된 값 (gc_pin: 바이트코드 상수, 인턴된 문자열)
+//   - 임시 루트 스택: 스코프가 열려 있는 동안 새로 만든 값/환경과 gc_keep으로 넣은 값
+//
+// 수집은 할당 중에는 일어나지 않고 안전 지점(gc_safepoint)에서만 일어난다.
+// 인터프리터는 문장 사이와 반복마다, VM/레지스터 VM/JIT는 역방향 점프와 함수 호출에서 부르고,
+// 그 시점에 살아 있는 값은 모두 위의 루트에서 닿아야 한다.
+// 마지막 수집 뒤 할당한 양이 살아남은 양의 두 배(최소 GC_MIN_THRESHOLD)를 넘으면 수집한다.
+//
+// 점진 모드 (gc_set_incremental):
+//   삼색 표시(흰색: 표시 안 됨, 회색: 표시됐지만 자식을 아직 안 봄, 검은색: 자식까지 봄)를
+//   안전 지점마다 정해진 시간(마이크로초) 안에서 조금씩 진행하고, 스윕도 조금씩 한다.
+//   시간이 아무리 짧아도 한 단계는 단계 사이 할당량의 두 배쯤은 처리해서 수집이 할당을 따라잡는다.
+//   표시 중에 이미 있는 배열/딕셔너리/인스턴스/환경에 값을 넣으면 gc_write_barrier로 새 값을
+//   회색으로 만든다 (검은 객체가 흰 객체를 가리키는 일이 없게).
+//   루트(스택, 전역 슬롯, 임시 루트)는 장벽 없이 바뀌므로 표시 마지막에 한 번에 다시 훑는다.
+//   새로 만든 값은 흰색으로 시작하고, 루트나 장벽을 통해서만 살아남는다.
+
+#define GC_MIN_THRESHOLD (1024 * 1024)
+#define GC_DEFAULT_PAUSE_US 1000         // 점진 모드의 한 번 멈춤 시간 목표
+#define GC_STEP_SIZE (64 * 1024)         // 점진 수집 중 이만큼 더 할당할 때마다 한 단계 진행
+#define GC_PAUSE_BUCKETS 24              // 멈춤 시간 히스토그램 (i번째 칸: 2^i 마이크로초 미만)
+
+extern size_t gc_allocated;  // 추적 중인 바이트 (대략, 값 헤더 + 본문)
+extern size_t gc_threshold;  // 이만큼 넘으면 다음 안전 지점에서 수집 (점진 수집 중에는 다음 단계)
+extern int gc_marking;       // 점진 표시 중 (쓰기 장벽이 켜져 있음)
+
+// 멈춤 통계 (수집/단계 하나가 멈춘 시간)
+typedef struct {
+    long cycles;                      // 끝난 수집 횟수
+    long pauses;                      // 멈춘 횟수 (전체 수집 또는 점진 단계)
+    double total_pause_us;
+    double max_pause_us;
+    long histogram[GC_PAUSE_BUCKETS];
+    size_t freed_bytes;               // 지금까지 회수한 양 (대략)
+} GCStats;
+
+extern GCStats gc_stats;
+
+// 값 헤더는 GC의 슬랩에서 받아 바로 GC 목록에 넣음 (value_alloc이 부름, 스윕이 슬랩으로 돌려줌)
+Value* gc_alloc_value(void);
+extern Slab gc_value_slab;  // 할당 통계 (--gc-stats)
+
+// 값 본문 (배열/함수/인스턴스 등, 0으로 채움): 크기별 슬랩(GC_BODY_CLASS 바이트 단위)에서 받음
+#define GC_BODY_CLASS 16
+#define GC_BODY_CLASSES 3  // 16, 32, 48바이트 (더 크면 malloc)
+void* gc_alloc_body(size_t size);
+void gc_free_body(void* body, size_t size);
+
+// 새 환경을 GC 목록에 넣음 (environment_create가 부름)
+void gc_track_environment(Environment* env);
+void gc_account(size_t size);  // 이미 추적 중인 값이 본문을 늘렸을 때
+
+// 고정: 수집되지 않고 루트로 취급 (바이트코드 상수, 인턴된 문자열)
+void gc_pin(Value* value);
+
+// 임시 루트 스코프 (begin이 돌려준 표시를 end에 넘김, 스코프 안에서 만든 값은 end까지 루트)
+int gc_scope_begin(void);
+void gc_scope_end(int mark);
+void gc_keep(Value* value);  // 이미 있던 값을 현재 스코프가 끝날 때까지 루트로
+
+// 루트 제공 함수 (수집할 때마다 context를 넘겨 부름, 안에서 gc_mark_*로 표시)
+typedef void (*GCRootMarker)(void* context);
+void gc_add_roots(GCRootMarker marker, void* context);
+void gc_remove_roots(GCRootMarker marker, void* context);
+
+void gc_mark_value(Value* value);
+void gc_mark_environment(Environment* env);
+
+// 점진 모드 켜기 (pause_us: 한 단계에 쓸 시간, 0 이하면 지금 값 유지 - 처음에는 GC_DEFAULT_PAUSE_US)
+void gc_set_incremental(long pause_us);
+
+void gc_collect(void);  // 전체 수집 (점진 수집 중이면 끝까지 진행)
+void gc_step(void);     // 안전 지점에서 문턱을 넘었을 때 (모드에 따라 전체 수집 또는 한 단계)
+
+void gc_print_stats(FILE* out);
+
+// 안전 지점 (할당량이 문턱을 넘었을 때만 수집)
+static inline void gc_safepoint(void) {
+    if (gc_allocated >= gc_threshold) gc_step();
+}
+
+// 쓰기 장벽: 이미 있는 객체/환경에 value를 넣을 때 부름
+static inline void gc_write_barrier(Value* value) {
+    if (gc_marking) gc_mark_value(value);
+}
+
+#endif
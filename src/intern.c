@@ -0,0 +1,130 @@
+#include "intern.h"
+#include "interpreter.h"
+#include "gc.h"
+#include <stdlib.h>
+#include <string.h>
+
+// 심볼 (해시와 길이 바로 뒤에 문자열, 바깥에는 chars 포인터만 보임)
+typedef struct Symbol {
+    uint32_t hash;
+    uint32_t length;
+    char chars[];
+} Symbol;
+
+#define SYMBOL_OF(string) ((Symbol*)((char*)(string) - offsetof(Symbol, chars)))
+
+// 두 테이블 모두 열린 주소법 (용량은 2의 거듭제곱, 3/4를 넘으면 두 배로)
+static Symbol** symbols = NULL;
+static int symbol_count = 0;
+static int symbol_capacity = 0;
+
+static Value** entries = NULL;
+static int entry_count = 0;
+static int entry_capacity = 0;
+
+uint32_t intern_hash(const char* chars, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (uint8_t)chars[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// hash로 찾기 시작하는 빈 자리 또는 같은 심볼의 자리
+static Symbol** find_symbol(Symbol** table, int capacity, const char* chars, size_t length, uint32_t hash) {
+    uint32_t index = hash & (uint32_t)(capacity - 1);
+    for (;;) {
+        Symbol** slot = &table[index];
+        Symbol* symbol = *slot;
+        if (!symbol || (symbol->hash == hash && symbol->length == length &&
+                        memcmp(symbol->chars, chars, length) == 0)) {
+            return slot;
+        }
+        index = (index + 1) & (uint32_t)(capacity - 1);
+    }
+}
+
+static void grow_symbols(void) {
+    int capacity = symbol_capacity < 256 ? 256 : symbol_capacity * 2;
+    Symbol** table = (Symbol**)calloc(capacity, sizeof(Symbol*));
+
+    for (int i = 0; i < symbol_capacity; i++) {
+        Symbol* symbol = symbols[i];
+        if (symbol) {
+            *find_symbol(table, capacity, symbol->chars, symbol->length, symbol->hash) = symbol;
+        }
+    }
+
+    free(symbols);
+    symbols = table;
+    symbol_capacity = capacity;
+}
+
+char* symbol_intern(const char* chars, size_t length) {
+    if ((symbol_count + 1) * 4 > symbol_capacity * 3) grow_symbols();
+
+    uint32_t hash = intern_hash(chars, length);
+    Symbol** slot = find_symbol(symbols, symbol_capacity, chars, length, hash);
+    if (!*slot) {
+        Symbol* symbol = (Symbol*)malloc(sizeof(Symbol) + length + 1);
+        symbol->hash = hash;
+        symbol->length = (uint32_t)length;
+        memcpy(symbol->chars, chars, length);
+        symbol->chars[length] = '\0';
+        *slot = symbol;
+        symbol_count++;
+    }
+    return (*slot)->chars;
+}
+
+char* symbol_from(const char* chars) {
+    return symbol_intern(chars, strlen(chars));
+}
+
+uint32_t symbol_hash(const char* symbol) {
+    return SYMBOL_OF(symbol)->hash;
+}
+
+// hash로 찾기 시작하는 빈 자리 또는 같은 문자열의 자리
+static Value** find_entry(Value** table, int capacity, const char* chars, uint32_t hash) {
+    uint32_t index = hash & (uint32_t)(capacity - 1);
+    for (;;) {
+        Value** entry = &table[index];
+        if (!*entry || ((*entry)->hash == hash && strcmp((*entry)->data.string, chars) == 0)) {
+            return entry;
+        }
+        index = (index + 1) & (uint32_t)(capacity - 1);
+    }
+}
+
+static void grow_table(void) {
+    int capacity = entry_capacity < 64 ? 64 : entry_capacity * 2;
+    Value** table = (Value**)calloc(capacity, sizeof(Value*));
+
+    for (int i = 0; i < entry_capacity; i++) {
+        Value* value = entries[i];
+        if (value) {
+            *find_entry(table, capacity, value->data.string, value->hash) = value;
+        }
+    }
+
+    free(entries);
+    entries = table;
+    entry_capacity = capacity;
+}
+
+Value* intern_string(const char* chars) {
+    if ((entry_count + 1) * 4 > entry_capacity * 3) grow_table();
+
+    uint32_t hash = intern_hash(chars, strlen(chars));
+    Value** entry = find_entry(entries, entry_capacity, chars, hash);
+    if (!*entry) {
+        Value* value = value_create_string((char*)chars);
+        value->hash = hash;
+        gc_pin(value);  // 테이블이 계속 가리키므로 수집되지 않게
+        *entry = value;
+        entry_count++;
+    }
+    return *entry;
+}
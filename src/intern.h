@@ -0,0 +1,29 @@
+#ifndef INTERN_H
+#define INTERN_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct Value;
+
+// 심볼 테이블 (프로그램 전체에서 하나)
+//
+// 렉서가 모든 토큰 문자열(식별자, 키워드, 리터럴, 연산자)을 여기서 한 번만 만들고,
+// 토큰/AST/환경/클래스와 인스턴스 필드/모듈 이름은 그 포인터를 그대로 나눠 쓴다.
+// 내용이 같은 심볼은 포인터가 같으므로 이름 비교는 포인터 비교로 충분하고,
+// 해시는 문자열 바로 앞에 저장되어 있어 symbol_hash로 다시 계산 없이 꺼낸다.
+// 심볼은 테이블이 소유한다 (프로그램 끝까지 남음, 수정/해제 금지).
+char* symbol_intern(const char* chars, size_t length);
+char* symbol_from(const char* chars);  // symbol_intern(chars, strlen(chars))
+uint32_t symbol_hash(const char* symbol);
+
+// 문자열 인턴 테이블
+//
+// 내용이 같은 문자열은 VAL_STRING 값 하나를 공유하고, 그 값의 hash 필드에 해시를 미리 채워 둔다.
+// 바이트코드 상수 풀의 문자열 상수는 모두 인턴되므로 상수끼리의 비교는 포인터 비교로 충분하다.
+// 인턴된 값은 테이블이 소유한다 (청크를 해제해도 남음, 수정 금지).
+
+uint32_t intern_hash(const char* chars, size_t length);  // FNV-1a 32비트
+struct Value* intern_string(const char* chars);
+
+#endif
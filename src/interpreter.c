@@ -1,11 +1,53 @@
 #include "interpreter.h"
 #include "module.h"
+#include "intern.h"
+#include "gc.h"
+#include "resolver.h"
 #include <string.h>
 #include <stdio.h>
 #include <math.h>
 
+// 인터프리터가 직접 쓰는 이름의 심볼 (interpreter_create에서 만듦)
+static char* symbol_this = NULL;
+static char* symbol_constructor = NULL;
+
+static Value** environment_slot(Environment* env, char* name);
+static Value** environment_at(Environment* env, int depth, int slot, char* name);
+
+// 리졸버가 정한 자리로 읽고, 정하지 못했거나 값이 아직 없으면 이름으로 찾음
+static Value* environment_lookup(Environment* env, ASTNode* node, char* name) {
+    Value** slot = environment_at(env, node->depth, node->slot, name);
+    return slot ? *slot : environment_get(env, name);
+}
+
+// 함수/메서드 본문이나 catch 블록을 실행할 환경 (리졸버가 남긴 자리 배치로)
+static Environment* scope_env_create(Environment* parent, ASTNode* body) {
+    if (body && body->type == AST_BLOCK && body->data.block.local_count > 0) {
+        return environment_create_slots(parent, body->data.block.locals, body->data.block.local_count);
+    }
+    return environment_create(parent);
+}
+
+// GC 루트: 전역/현재 환경, 반환값, 예외, 로드한 모듈의 exports
+// (함수 호출 중인 바깥 환경과 계산 중인 값은 임시 루트 스코프가 잡고 있음)
+static void mark_interpreter_roots(void* context) {
+    Interpreter* interp = (Interpreter*)context;
+    gc_mark_environment(interp->global_env);
+    gc_mark_environment(interp->current_env);
+    gc_mark_value(interp->return_value);
+    gc_mark_value(interp->current_exception);
+    
+    ModuleCache* cache = interp->module_cache;
+    for (int i = 0; cache && i < cache->count; i++) {
+        gc_mark_environment(cache->modules[i]->exports);
+    }
+}
+
 // 인터프리터 생성
 Interpreter* interpreter_create() {
+    symbol_this = symbol_from("this");
+    symbol_constructor = symbol_from("constructor");
+    
     Interpreter* interp = (Interpreter*)malloc(sizeof(Interpreter));
     interp->global_env = environment_create(NULL);
     interp->current_env = interp->global_env;
@@ -18,18 +60,33 @@ Interpreter* interpreter_create() {
     interp->max_stack_depth = 1000;
     interp->current_file = strdup("<input>");
     interp->module_cache = module_cache_create();
+    interp->programs = NULL;
+    interp->program_count = 0;
+    interp->program_capacity = 0;
+    gc_add_roots(mark_interpreter_roots, interp);
     return interp;
 }
 
-// 인터프리터 메모리 해제
-void interpreter_free(Interpreter* interp) {
-    environment_free(interp->global_env);
-    if (interp->return_value) {
-        value_free(interp->return_value);
+// 실행한 프로그램의 AST를 인터프리터가 끝날 때까지 보관
+// 정의한 함수가 본문 노드를, 환경이 블록의 자리 배치를 계속 가리키므로 REPL은 줄마다 여기에 넘긴다
+void interpreter_keep_program(Interpreter* interp, ASTNode* program) {
+    if (interp->program_count >= interp->program_capacity) {
+        interp->program_capacity = interp->program_capacity < 8 ? 8 : interp->program_capacity * 2;
+        interp->programs = (ASTNode**)realloc(interp->programs, sizeof(ASTNode*) * interp->program_capacity);
     }
+    interp->programs[interp->program_count++] = program;
+}
+
+// 인터프리터 메모리 해제 (환경과 값은 다음 수집 때 GC가 회수)
+void interpreter_free(Interpreter* interp) {
+    gc_remove_roots(mark_interpreter_roots, interp);
     if (interp->module_cache) {
         module_cache_free(interp->module_cache);
     }
+    for (int i = 0; i < interp->program_count; i++) {
+        ast_free(interp->programs[i]);
+    }
+    free(interp->programs);
     free(interp);
 }
 
@@ -57,7 +114,7 @@ Value* interpreter_eval(Interpreter* interp, ASTNode* node) {
             return value_create_string(node->data.string);
             
         case AST_IDENTIFIER: {
-            Value* val = environment_get(interp->current_env, node->data.string);
+            Value* val = environment_lookup(interp->current_env, node, node->data.string);
             return val ? value_copy(val) : value_create_null();
         }
             
@@ -90,13 +147,13 @@ Value* interpreter_eval(Interpreter* interp, ASTNode* node) {
             
         case AST_LET: {
             Value* val = interpreter_eval(interp, node->data.assign.value);
-            environment_set(interp->current_env, node->data.assign.name, val);
+            environment_set_at(interp->current_env, node->slot, node->data.assign.name, val);
             return value_create_null();
         }
             
         case AST_ASSIGN: {
             Value* val = interpreter_eval(interp, node->data.assign.value);
-            environment_set(interp->current_env, node->data.assign.name, val);
+            environment_set_at(interp->current_env, node->slot, node->data.assign.name, val);
             return value_copy(val);
         }
         
@@ -108,17 +165,34 @@ Value* interpreter_eval(Interpreter* interp, ASTNode* node) {
                 return value_create_null();
             }
             
-            char* array_name = node->data.index_assign.array->data.string;
-            Value* array = environment_get(interp->current_env, array_name);
+            ASTNode* array_node = node->data.index_assign.array;
+            char* array_name = array_node->data.string;
+            Value* array = environment_lookup(interp->current_env, array_node, array_name);
             
             if (!array) {
                 fprintf(stderr, "Error: Undefined variable '%s'\n", array_name);
                 return value_create_null();
             }
+            gc_keep(array);  // 인덱스/값을 계산하다 변수가 바뀌어도 수집되지 않게
             
             Value* index = interpreter_eval(interp, node->data.index_assign.index);
             Value* val = interpreter_eval(interp, node->data.index_assign.value);
             
+            // 넣을 값을 먼저 담고 (a[0] = a 같은 경우 자기 자신도 공유 중이 됨),
+            // 다른 변수/요소도 담고 있는 배열이면 복제본으로 바꿔서 씀 (copy-on-write)
+            value_retain(val);
+            Value** slot = environment_at(interp->current_env, array_node->depth, array_node->slot, array_name);
+            if (!slot) slot = environment_slot(interp->current_env, array_name);
+            if (slot && (array->type == VAL_ARRAY || array->type == VAL_DICT)) {
+                array = *slot;
+                Value* owned = value_unshare(array);
+                if (owned != array) {
+                    *slot = owned;
+                    gc_write_barrier(owned);
+                    array = owned;
+                }
+            }
+            
             if (array->type == VAL_ARRAY && index->type == VAL_NUMBER) {
                 int idx = (int)index->data.number;
                 if (idx < 0) {
@@ -127,69 +201,78 @@ Value* interpreter_eval(Interpreter* interp, ASTNode* node) {
                     interp->current_exception = value_create_exception("IndexError", msg);
                     exception_attach_stack_trace(interp, interp->current_exception);
                     interp->has_exception = 1;
+                    value_release(val);
                     value_free(index);
                     value_free(val);
                     return value_create_null();
                 }
                 
                 // 배열 자동 확장: 인덱스가 범위를 벗어나면 배열 크기 증가
-                if (idx >= array->data.array.count) {
+                if (idx >= array->data.array->count) {
                     int new_count = idx + 1;
-                    array->data.array.elements = realloc(array->data.array.elements, 
+                    array->data.array->elements = realloc(array->data.array->elements, 
                                                           sizeof(Value*) * new_count);
+                    gc_account(sizeof(Value*) * (new_count - array->data.array->count));
                     
                     // 새로 추가된 공간을 null로 초기화
-                    for (int i = array->data.array.count; i < new_count; i++) {
-                        array->data.array.elements[i] = value_create_null();
+                    for (int i = array->data.array->count; i < new_count; i++) {
+                        array->data.array->elements[i] = value_create_null();
+                        gc_write_barrier(array->data.array->elements[i]);
                     }
                     
-                    array->data.array.count = new_count;
+                    array->data.array->count = new_count;
                 }
                 
-                // 배열 요소 업데이트 (원본 배열을 직접 수정)
-                value_free(array->data.array.elements[idx]);
-                array->data.array.elements[idx] = value_copy(val);
+                // 배열 요소 업데이트 (이 변수만 담고 있는 배열이므로 제자리에서 수정)
+                value_release(array->data.array->elements[idx]);
+                array->data.array->elements[idx] = val;
+                gc_write_barrier(array->data.array->elements[idx]);
                 value_free(index);
                 value_free(val);
-                return value_copy(array->data.array.elements[idx]);
+                return value_copy(array->data.array->elements[idx]);
             } else if (array->type == VAL_DICT && index->type == VAL_STRING) {
                 // 딕셔너리 키 할당
-                for (int i = 0; i < array->data.dict.count; i++) {
-                    if (strcmp(array->data.dict.keys[i], index->data.string) == 0) {
-                        value_free(array->data.dict.values[i]);
-                        array->data.dict.values[i] = value_copy(val);
+                for (int i = 0; i < array->data.dict->count; i++) {
+                    if (strcmp(array->data.dict->keys[i], index->data.string) == 0) {
+                        value_release(array->data.dict->values[i]);
+                        array->data.dict->values[i] = val;
+                        gc_write_barrier(array->data.dict->values[i]);
                         value_free(index);
                         value_free(val);
-                        return value_copy(array->data.dict.values[i]);
+                        return value_copy(array->data.dict->values[i]);
                     }
                 }
                 // 새 키 추가
-                array->data.dict.count++;
-                array->data.dict.keys = realloc(array->data.dict.keys, sizeof(char*) * array->data.dict.count);
-                array->data.dict.values = realloc(array->data.dict.values, sizeof(Value*) * array->data.dict.count);
-                array->data.dict.keys[array->data.dict.count - 1] = strdup(index->data.string);
-                array->data.dict.values[array->data.dict.count - 1] = value_copy(val);
+                array->data.dict->count++;
+                array->data.dict->keys = realloc(array->data.dict->keys, sizeof(char*) * array->data.dict->count);
+                array->data.dict->values = realloc(array->data.dict->values, sizeof(Value*) * array->data.dict->count);
+                array->data.dict->keys[array->data.dict->count - 1] = strdup(index->data.string);
+                array->data.dict->values[array->data.dict->count - 1] = val;
+                gc_write_barrier(array->data.dict->values[array->data.dict->count - 1]);
+                gc_account(sizeof(char*) + sizeof(Value*) + strlen(index->data.string) + 1);
                 value_free(index);
                 value_free(val);
-                return value_copy(array->data.dict.values[array->data.dict.count - 1]);
+                return value_copy(array->data.dict->values[array->data.dict->count - 1]);
             }
             
+            value_release(val);
             value_free(index);
             value_free(val);
             return value_create_null();
         }
             
         case AST_FUNCTION_DEF: {
-            Value* func = (Value*)malloc(sizeof(Value));
-            func->type = VAL_FUNCTION;
-            func->data.function.param_count = node->data.function_def.param_count;
-            func->data.function.params = malloc(sizeof(char*) * node->data.function_def.param_count);
+            Value* func = value_alloc(VAL_FUNCTION);
+            func->data.function->param_count = node->data.function_def.param_count;
+            func->data.function->params = malloc(sizeof(char*) * node->data.function_def.param_count);
             for (int i = 0; i < node->data.function_def.param_count; i++) {
-                func->data.function.params[i] = strdup(node->data.function_def.params[i]);
+                func->data.function->params[i] = node->data.function_def.params[i];
             }
-            func->data.function.body = node->data.function_def.body;
-            func->data.function.closure = interp->current_env;
-            environment_set(interp->current_env, node->data.function_def.name, func);
+            func->data.function->body = node->data.function_def.body;
+            func->data.function->closure = interp->current_env;
+            func->data.function->chunk = NULL;
+            func->data.function->reg_chunk = NULL;
+            environment_set_at(interp->current_env, node->slot, node->data.function_def.name, func);
             return value_create_null();
         }
             
@@ -220,11 +303,14 @@ Value* interpreter_eval(Interpreter* interp, ASTNode* node) {
             Value* iterable = interpreter_eval(interp, node->data.for_loop.iterable);
             
             if (iterable->type == VAL_ARRAY) {
-                for (int i = 0; i < iterable->data.array.count; i++) {
-                    environment_set(interp->current_env, node->data.for_loop.iterator, 
-                                  iterable->data.array.elements[i]);
+                for (int i = 0; i < iterable->data.array->count; i++) {
+                    gc_safepoint();
+                    int scope = gc_scope_begin();
+                    environment_set_at(interp->current_env, node->slot, node->data.for_loop.iterator,
+                                       iterable->data.array->elements[i]);
                     Value* result = interpreter_eval(interp, node->data.for_loop.body);
                     value_free(result);
+                    gc_scope_end(scope);
                     
                     if (interp->has_returned) break;
                 }
@@ -236,6 +322,9 @@ Value* interpreter_eval(Interpreter* interp, ASTNode* node) {
             
         case AST_WHILE: {
             while (1) {
+                // 반복마다 스코프를 닫아 조건/본문의 임시 값이 쌓이지 않게
+                gc_safepoint();
+                int scope = gc_scope_begin();
                 Value* cond = interpreter_eval(interp, node->data.while_loop.condition);
                 int is_true = 0;
                 if (cond->type == VAL_BOOL) {
@@ -245,10 +334,14 @@ Value* interpreter_eval(Interpreter* interp, ASTNode* node) {
                 }
                 value_free(cond);
                 
-                if (!is_true) break;
+                if (!is_true) {
+                    gc_scope_end(scope);
+                    break;
+                }
                 
                 Value* result = interpreter_eval(interp, node->data.while_loop.body);
                 value_free(result);
+                gc_scope_end(scope);
                 
                 if (interp->has_returned) break;
             }
@@ -262,22 +355,36 @@ Value* interpreter_eval(Interpreter* interp, ASTNode* node) {
         }
             
         case AST_BLOCK: {
+            // 문장마다 임시 루트 스코프 (문장이 끝나면 그 안의 임시 값은 루트에서 빠짐)
             Value* last = value_create_null();
             for (int i = 0; i < node->data.block.statement_count; i++) {
+                gc_safepoint();
+                int scope = gc_scope_begin();
                 value_free(last);
                 last = interpreter_eval(interp, node->data.block.statements[i]);
+                gc_scope_end(scope);
                 
                 if (interp->has_returned) break;
             }
+            gc_keep(last);  // 결과는 바깥 스코프로
             return last;
         }
             
         case AST_PROGRAM: {
+            // 루트 환경에 이미 있는 이름 뒤로 자리를 정하고, 새 이름의 자리를 미리 잡아 둠
+            Environment* root = interp->current_env;
+            resolver_resolve(node, root->names, root->count);
+            environment_reserve(root, node->data.block.locals, node->data.block.local_count);
+            
             Value* last = value_create_null();
             for (int i = 0; i < node->data.block.statement_count; i++) {
+                gc_safepoint();
+                int scope = gc_scope_begin();
                 value_free(last);
                 last = interpreter_eval(interp, node->data.block.statements[i]);
+                gc_scope_end(scope);
             }
+            gc_keep(last);
             return last;
         }
             
@@ -299,9 +406,9 @@ Value* interpreter_eval(Interpreter* interp, ASTNode* node) {
                 for (int j = 0; j < node->data.matrix.col_count; j++) {
                     Value* elem = interpreter_eval(interp, row_node->data.array.elements[j]);
                     if (elem->type == VAL_NUMBER) {
-                        matrix->data.matrix.data[i][j] = elem->data.number;
+                        matrix->data.matrix->data[i][j] = elem->data.number;
                     } else {
-                        matrix->data.matrix.data[i][j] = 0.0;
+                        matrix->data.matrix->data[i][j] = 0.0;
                     }
                     value_free(elem);
                 }
@@ -326,7 +433,7 @@ Value* interpreter_eval(Interpreter* interp, ASTNode* node) {
             
             if (array->type == VAL_ARRAY && index->type == VAL_NUMBER) {
                 int idx = (int)index->data.number;
-                if (idx < 0 || idx >= array->data.array.count) {
+                if (idx < 0 || idx >= array->data.array->count) {
                     char msg[100];
                     snprintf(msg, sizeof(msg), "list index out of range: %d", idx);
                     interp->current_exception = value_create_exception("IndexError", msg);
@@ -336,15 +443,15 @@ Value* interpreter_eval(Interpreter* interp, ASTNode* node) {
                     value_free(index);
                     return value_create_null();
                 }
-                Value* result = value_copy(array->data.array.elements[idx]);
+                Value* result = value_copy(array->data.array->elements[idx]);
                 value_free(array);
                 value_free(index);
                 return result;
             } else if (array->type == VAL_DICT && index->type == VAL_STRING) {
                 // 딕셔너리 키로 접근
-                for (int i = 0; i < array->data.dict.count; i++) {
-                    if (strcmp(array->data.dict.keys[i], index->data.string) == 0) {
-                        Value* result = value_copy(array->data.dict.values[i]);
+                for (int i = 0; i < array->data.dict->count; i++) {
+                    if (strcmp(array->data.dict->keys[i], index->data.string) == 0) {
+                        Value* result = value_copy(array->data.dict->values[i]);
                         value_free(array);
                         value_free(index);
                         return result;
@@ -362,7 +469,7 @@ Value* interpreter_eval(Interpreter* interp, ASTNode* node) {
             } else if (array->type == VAL_MATRIX && index->type == VAL_NUMBER) {
                 // 행렬 행 접근 (1차원 인덱스는 행을 반환)
                 int idx = (int)index->data.number;
-                if (idx < 0 || idx >= array->data.matrix.rows) {
+                if (idx < 0 || idx >= array->data.matrix->rows) {
                     char msg[100];
                     snprintf(msg, sizeof(msg), "matrix row index out of range: %d", idx);
                     interp->current_exception = value_create_exception("IndexError", msg);
@@ -373,11 +480,11 @@ Value* interpreter_eval(Interpreter* interp, ASTNode* node) {
                     return value_create_null();
                 }
                 // 행을 배열로 반환
-                Value** row_elements = (Value**)malloc(sizeof(Value*) * array->data.matrix.cols);
-                for (int j = 0; j < array->data.matrix.cols; j++) {
-                    row_elements[j] = value_create_number(array->data.matrix.data[idx][j]);
+                Value** row_elements = (Value**)malloc(sizeof(Value*) * array->data.matrix->cols);
+                for (int j = 0; j < array->data.matrix->cols; j++) {
+                    row_elements[j] = value_create_number(array->data.matrix->data[idx][j]);
                 }
-                Value* result = value_create_array(row_elements, array->data.matrix.cols);
+                Value* result = value_create_array(row_elements, array->data.matrix->cols);
                 value_free(array);
                 value_free(index);
                 return result;
@@ -393,22 +500,22 @@ Value* interpreter_eval(Interpreter* interp, ASTNode* node) {
             
             // 모듈 exports 접근
             if (obj->type == VAL_MODULE) {
-                Value* exported_value = environment_get(obj->data.module.exports, node->data.dot.property);
+                Value* exported_value = environment_get(obj->data.module->exports, node->data.dot.property);
                 if (exported_value) {
                     Value* result = value_copy(exported_value);
                     return result;
                 } else {
                     fprintf(stderr, "Error: Module '%s' has no export '%s'\n", 
-                            obj->data.module.name, node->data.dot.property);
+                            obj->data.module->name, node->data.dot.property);
                     return value_create_null();
                 }
             }
             
             // 인스턴스 필드 접근
             if (obj->type == VAL_INSTANCE) {
-                for (int i = 0; i < obj->data.instance.field_count; i++) {
-                    if (strcmp(obj->data.instance.field_names[i], node->data.dot.property) == 0) {
-                        Value* result = value_copy(obj->data.instance.field_values[i]);
+                for (int i = 0; i < obj->data.instance->field_count; i++) {
+                    if (obj->data.instance->field_names[i] == node->data.dot.property) {
+                        Value* result = value_copy(obj->data.instance->field_values[i]);
                         value_free(obj);
                         return result;
                     }
@@ -428,51 +535,49 @@ Value* interpreter_eval(Interpreter* interp, ASTNode* node) {
             
         case AST_CLASS: {
             // 클래스 정의를 환경에 저장
-            Value* class_val = (Value*)malloc(sizeof(Value));
-            class_val->type = VAL_CLASS;
-            class_val->data.class_def.name = strdup(node->data.class_def.name);
-            class_val->data.class_def.parent_class = node->data.class_def.parent_class ? 
-                strdup(node->data.class_def.parent_class) : NULL;
+            Value* class_val = value_alloc(VAL_CLASS);
+            class_val->data.class_def->name = node->data.class_def.name;
+            class_val->data.class_def->parent_class = node->data.class_def.parent_class;
             
             // 부모 클래스의 필드와 메서드 상속
             int total_fields = node->data.class_def.field_count;
             int total_methods = node->data.class_def.method_count;
             
             Value* parent_val = NULL;
-            if (class_val->data.class_def.parent_class) {
-                parent_val = environment_get(interp->current_env, class_val->data.class_def.parent_class);
+            if (class_val->data.class_def->parent_class) {
+                parent_val = environment_get(interp->current_env, class_val->data.class_def->parent_class);
                 if (parent_val && parent_val->type == VAL_CLASS) {
-                    total_fields += parent_val->data.class_def.field_count;
-                    total_methods += parent_val->data.class_def.method_count;
+                    total_fields += parent_val->data.class_def->field_count;
+                    total_methods += parent_val->data.class_def->method_count;
                 }
             }
             
             // 필드 병합 (부모 + 자식)
-            class_val->data.class_def.field_count = total_fields;
-            class_val->data.class_def.fields = (char**)malloc(sizeof(char*) * total_fields);
+            class_val->data.class_def->field_count = total_fields;
+            class_val->data.class_def->fields = (char**)malloc(sizeof(char*) * total_fields);
             int field_idx = 0;
             
             // 부모 필드 복사
             if (parent_val && parent_val->type == VAL_CLASS) {
-                for (int i = 0; i < parent_val->data.class_def.field_count; i++) {
-                    class_val->data.class_def.fields[field_idx++] = strdup(parent_val->data.class_def.fields[i]);
+                for (int i = 0; i < parent_val->data.class_def->field_count; i++) {
+                    class_val->data.class_def->fields[field_idx++] = parent_val->data.class_def->fields[i];
                 }
             }
             
             // 자식 필드 추가
             for (int i = 0; i < node->data.class_def.field_count; i++) {
-                class_val->data.class_def.fields[field_idx++] = strdup(node->data.class_def.fields[i]);
+                class_val->data.class_def->fields[field_idx++] = node->data.class_def.fields[i];
             }
             
             // 메서드 병합 (부모 + 자식, 오버라이딩 지원)
-            class_val->data.class_def.method_count = total_methods;
-            class_val->data.class_def.methods = (ASTNode**)malloc(sizeof(ASTNode*) * total_methods);
+            class_val->data.class_def->method_count = total_methods;
+            class_val->data.class_def->methods = (ASTNode**)malloc(sizeof(ASTNode*) * total_methods);
             int method_idx = 0;
             
             // 부모 메서드 복사
             if (parent_val && parent_val->type == VAL_CLASS) {
-                for (int i = 0; i < parent_val->data.class_def.method_count; i++) {
-                    class_val->data.class_def.methods[method_idx++] = parent_val->data.class_def.methods[i];
+                for (int i = 0; i < parent_val->data.class_def->method_count; i++) {
+                    class_val->data.class_def->methods[method_idx++] = parent_val->data.class_def->methods[i];
                 }
             }
             
@@ -483,11 +588,11 @@ Value* interpreter_eval(Interpreter* interp, ASTNode* node) {
                 
                 // 부모 메서드 중 같은 이름이 있으면 오버라이드
                 if (parent_val && parent_val->type == VAL_CLASS) {
-                    for (int j = 0; j < parent_val->data.class_def.method_count; j++) {
-                        if (strcmp(parent_val->data.class_def.methods[j]->data.function_def.name,
-                                 child_method->data.function_def.name) == 0) {
+                    for (int j = 0; j < parent_val->data.class_def->method_count; j++) {
+                        if (parent_val->data.class_def->methods[j]->data.function_def.name ==
+                            child_method->data.function_def.name) {
                             // 오버라이드: 부모 메서드를 자식 메서드로 교체
-                            class_val->data.class_def.methods[j] = child_method;
+                            class_val->data.class_def->methods[j] = child_method;
                             overridden = 1;
                             break;
                         }
@@ -496,12 +601,12 @@ Value* interpreter_eval(Interpreter* interp, ASTNode* node) {
                 
                 // 오버라이드하지 않았으면 새 메서드 추가
                 if (!overridden) {
-                    class_val->data.class_def.methods[method_idx++] = child_method;
+                    class_val->data.class_def->methods[method_idx++] = child_method;
                 }
             }
             
             // 실제 메서드 개수 업데이트
-            class_val->data.class_def.method_count = method_idx;
+            class_val->data.class_def->method_count = method_idx;
             
             environment_set(interp->current_env, node->data.class_def.name, class_val);
             return value_create_null();
@@ -513,33 +618,33 @@ Value* interpreter_eval(Interpreter* interp, ASTNode* node) {
             if (!class_val || class_val->type != VAL_CLASS) {
                 return value_create_null();
             }
+            gc_keep(class_val);
             
-            Value* instance = (Value*)malloc(sizeof(Value));
-            instance->type = VAL_INSTANCE;
-            instance->data.instance.class_name = strdup(class_val->data.class_def.name);
-            instance->data.instance.parent_class = class_val->data.class_def.parent_class ? 
-                strdup(class_val->data.class_def.parent_class) : NULL;
-            instance->data.instance.field_count = class_val->data.class_def.field_count;
-            instance->data.instance.field_names = (char**)malloc(sizeof(char*) * instance->data.instance.field_count);
-            instance->data.instance.field_values = (Value**)malloc(sizeof(Value*) * instance->data.instance.field_count);
+            Value* instance = value_alloc(VAL_INSTANCE);
+            instance->data.instance->class_name = class_val->data.class_def->name;
+            instance->data.instance->parent_class = class_val->data.class_def->parent_class;
+            instance->data.instance->field_count = class_val->data.class_def->field_count;
+            instance->data.instance->field_names = (char**)malloc(sizeof(char*) * instance->data.instance->field_count);
+            instance->data.instance->field_values = (Value**)malloc(sizeof(Value*) * instance->data.instance->field_count);
+            gc_account((sizeof(char*) + sizeof(Value*)) * instance->data.instance->field_count);
             
             // 필드 초기화
-            for (int i = 0; i < instance->data.instance.field_count; i++) {
-                instance->data.instance.field_names[i] = strdup(class_val->data.class_def.fields[i]);
+            for (int i = 0; i < instance->data.instance->field_count; i++) {
+                instance->data.instance->field_names[i] = class_val->data.class_def->fields[i];
                 // 기본값으로 초기화
-                instance->data.instance.field_values[i] = value_create_null();
+                instance->data.instance->field_values[i] = value_create_null();
             }
             
             // constructor 메서드 찾아서 실행
-            for (int i = 0; i < class_val->data.class_def.method_count; i++) {
-                ASTNode* method = class_val->data.class_def.methods[i];
-                if (strcmp(method->data.function_def.name, "constructor") == 0) {
+            for (int i = 0; i < class_val->data.class_def->method_count; i++) {
+                ASTNode* method = class_val->data.class_def->methods[i];
+                if (method->data.function_def.name == symbol_constructor) {
                     // 생성자 실행
                     Environment* prev_env = interp->current_env;
-                    interp->current_env = environment_create(interp->current_env);
+                    interp->current_env = scope_env_create(interp->current_env, method->data.function_def.body);
                     
                     // this 바인딩
-                    environment_set(interp->current_env, "this", instance);
+                    environment_set(interp->current_env, symbol_this, instance);
                     
                     // 생성자 파라미터 바인딩
                     for (int j = 0; j < method->data.function_def.param_count && j < node->data.new_expr.arg_count; j++) {
@@ -551,7 +656,6 @@ Value* interpreter_eval(Interpreter* interp, ASTNode* node) {
                     Value* result = interpreter_eval(interp, method->data.function_def.body);
                     value_free(result);
                     
-                    environment_free(interp->current_env);
                     interp->current_env = prev_env;
                     break;
                 }
@@ -562,7 +666,7 @@ Value* interpreter_eval(Interpreter* interp, ASTNode* node) {
             
         case AST_THIS: {
             // this는 현재 인스턴스를 참조
-            Value* this_val = environment_get(interp->current_env, "this");
+            Value* this_val = environment_lookup(interp->current_env, node, symbol_this);
             return this_val ? value_copy(this_val) : value_create_null();
         }
             
@@ -578,17 +682,17 @@ Value* interpreter_eval(Interpreter* interp, ASTNode* node) {
                     Value* val = interpreter_eval(interp, node->data.method_call.args[0]);
                     
                     // 새 배열 생성 (원본 크기 + 1)
-                    Value** new_elements = (Value**)malloc(sizeof(Value*) * (obj->data.array.count + 1));
+                    Value** new_elements = (Value**)malloc(sizeof(Value*) * (obj->data.array->count + 1));
                     
                     // 기존 요소 복사
-                    for (int i = 0; i < obj->data.array.count; i++) {
-                        new_elements[i] = value_copy(obj->data.array.elements[i]);
+                    for (int i = 0; i < obj->data.array->count; i++) {
+                        new_elements[i] = value_copy(obj->data.array->elements[i]);
                     }
                     
                     // 새 요소 추가
-                    new_elements[obj->data.array.count] = value_copy(val);
+                    new_elements[obj->data.array->count] = value_copy(val);
                     
-                    Value* result = value_create_array(new_elements, obj->data.array.count + 1);
+                    Value* result = value_create_array(new_elements, obj->data.array->count + 1);
                     value_free(obj);
                     value_free(val);
                     return result;
@@ -596,11 +700,11 @@ Value* interpreter_eval(Interpreter* interp, ASTNode* node) {
                 
                 // reverse() - 배열 뒤집기
                 if (strcmp(method, "reverse") == 0) {
-                    Value** reversed = (Value**)malloc(sizeof(Value*) * obj->data.array.count);
-                    for (int i = 0; i < obj->data.array.count; i++) {
-                        reversed[i] = value_copy(obj->data.array.elements[obj->data.array.count - 1 - i]);
+                    Value** reversed = (Value**)malloc(sizeof(Value*) * obj->data.array->count);
+                    for (int i = 0; i < obj->data.array->count; i++) {
+                        reversed[i] = value_copy(obj->data.array->elements[obj->data.array->count - 1 - i]);
                     }
-                    Value* result = value_create_array(reversed, obj->data.array.count);
+                    Value* result = value_create_array(reversed, obj->data.array->count);
                     value_free(obj);
                     return result;
                 }
@@ -610,8 +714,8 @@ Value* interpreter_eval(Interpreter* interp, ASTNode* node) {
                     Value* search = interpreter_eval(interp, node->data.method_call.args[0]);
                     int found = 0;
                     
-                    for (int i = 0; i < obj->data.array.count; i++) {
-                        Value* elem = obj->data.array.elements[i];
+                    for (int i = 0; i < obj->data.array->count; i++) {
+                        Value* elem = obj->data.array->elements[i];
                         if (elem->type == search->type) {
                             if (elem->type == VAL_NUMBER && elem->data.number == search->data.number) {
                                 found = 1;
@@ -633,8 +737,8 @@ Value* interpreter_eval(Interpreter* interp, ASTNode* node) {
                     Value* search = interpreter_eval(interp, node->data.method_call.args[0]);
                     int index = -1;
                     
-                    for (int i = 0; i < obj->data.array.count; i++) {
-                        Value* elem = obj->data.array.elements[i];
+                    for (int i = 0; i < obj->data.array->count; i++) {
+                        Value* elem = obj->data.array->elements[i];
                         if (elem->type == search->type) {
                             if (elem->type == VAL_NUMBER && elem->data.number == search->data.number) {
                                 index = i;
@@ -652,11 +756,11 @@ Value* interpreter_eval(Interpreter* interp, ASTNode* node) {
                 }
                 
                 // min() - 최솟값
-                if (strcmp(method, "min") == 0 && obj->data.array.count > 0) {
-                    double min_val = obj->data.array.elements[0]->data.number;
-                    for (int i = 1; i < obj->data.array.count; i++) {
-                        if (obj->data.array.elements[i]->type == VAL_NUMBER) {
-                            double val = obj->data.array.elements[i]->data.number;
+                if (strcmp(method, "min") == 0 && obj->data.array->count > 0) {
+                    double min_val = obj->data.array->elements[0]->data.number;
+                    for (int i = 1; i < obj->data.array->count; i++) {
+                        if (obj->data.array->elements[i]->type == VAL_NUMBER) {
+                            double val = obj->data.array->elements[i]->data.number;
                             if (val < min_val) {
                                 min_val = val;
                             }
@@ -667,11 +771,11 @@ Value* interpreter_eval(Interpreter* interp, ASTNode* node) {
                 }
                 
                 // max() - 최댓값
-                if (strcmp(method, "max") == 0 && obj->data.array.count > 0) {
-                    double max_val = obj->data.array.elements[0]->data.number;
-                    for (int i = 1; i < obj->data.array.count; i++) {
-                        if (obj->data.array.elements[i]->type == VAL_NUMBER) {
-                            double val = obj->data.array.elements[i]->data.number;
+                if (strcmp(method, "max") == 0 && obj->data.array->count > 0) {
+                    double max_val = obj->data.array->elements[0]->data.number;
+                    for (int i = 1; i < obj->data.array->count; i++) {
+                        if (obj->data.array->elements[i]->type == VAL_NUMBER) {
+                            double val = obj->data.array->elements[i]->data.number;
                             if (val > max_val) {
                                 max_val = val;
                             }
@@ -721,9 +825,10 @@ Value* interpreter_eval(Interpreter* interp, ASTNode* node) {
             // 모듈 함수 호출
             if (obj->type == VAL_MODULE) {
                 // 모듈의 exports에서 함수 찾기
-                Value* func = environment_get(obj->data.module.exports, node->data.method_call.method_name);
+                Value* func = environment_get(obj->data.module->exports, node->data.method_call.method_name);
                 
                 if (func && func->type == VAL_FUNCTION) {
+                    gc_keep(func);
                     // 함수 호출 환경 생성
                     Environment* prev_env = interp->current_env;
                     
@@ -734,11 +839,11 @@ Value* interpreter_eval(Interpreter* interp, ASTNode* node) {
                     }
                     
                     // 이제 함수 환경으로 전환
-                    interp->current_env = environment_create(func->data.function.closure);
+                    interp->current_env = scope_env_create(func->data.function->closure, func->data.function->body);
                     
                     // 인자 바인딩
-                    for (int i = 0; i < func->data.function.param_count && i < node->data.method_call.arg_count; i++) {
-                        environment_set(interp->current_env, func->data.function.params[i], evaluated_args[i]);
+                    for (int i = 0; i < func->data.function->param_count && i < node->data.method_call.arg_count; i++) {
+                        environment_set(interp->current_env, func->data.function->params[i], evaluated_args[i]);
                     }
                     
                     // 인자 배열 해제
@@ -748,7 +853,7 @@ Value* interpreter_eval(Interpreter* interp, ASTNode* node) {
                     int prev_return = interp->has_returned;
                     interp->has_returned = 0;
                     
-                    Value* result = interpreter_eval(interp, func->data.function.body);
+                    Value* result = interpreter_eval(interp, func->data.function->body);
                     
                     if (interp->has_returned) {
                         value_free(result);
@@ -759,13 +864,12 @@ Value* interpreter_eval(Interpreter* interp, ASTNode* node) {
                     
                     interp->has_returned = prev_return;
                     
-                    environment_free(interp->current_env);
                     interp->current_env = prev_env;
                     
                     return result;
                 } else {
                     fprintf(stderr, "Error: Module '%s' has no function '%s'\n", 
-                            obj->data.module.name, node->data.method_call.method_name);
+                            obj->data.module->name, node->data.method_call.method_name);
                     return value_create_null();
                 }
             }
@@ -773,18 +877,19 @@ Value* interpreter_eval(Interpreter* interp, ASTNode* node) {
             // 인스턴스 메서드 호출
             if (obj->type == VAL_INSTANCE) {
                 // 클래스에서 메서드 찾기
-                Value* class_val = environment_get(interp->current_env, obj->data.instance.class_name);
+                Value* class_val = environment_get(interp->current_env, obj->data.instance->class_name);
                 if (class_val && class_val->type == VAL_CLASS) {
+                    gc_keep(class_val);
                     // 메서드 찾기
-                    for (int i = 0; i < class_val->data.class_def.method_count; i++) {
-                        ASTNode* method = class_val->data.class_def.methods[i];
-                        if (strcmp(method->data.function_def.name, node->data.method_call.method_name) == 0) {
+                    for (int i = 0; i < class_val->data.class_def->method_count; i++) {
+                        ASTNode* method = class_val->data.class_def->methods[i];
+                        if (method->data.function_def.name == node->data.method_call.method_name) {
                             // 메서드 실행
                             Environment* prev_env = interp->current_env;
-                            interp->current_env = environment_create(interp->current_env);
+                            interp->current_env = scope_env_create(interp->current_env, method->data.function_def.body);
                             
                             // this 바인딩 (현재 인스턴스)
-                            environment_set(interp->current_env, "this", obj);
+                            environment_set(interp->current_env, symbol_this, obj);
                             
                             // 파라미터 바인딩
                             for (int j = 0; j < method->data.function_def.param_count && j < node->data.method_call.arg_count; j++) {
@@ -795,7 +900,6 @@ Value* interpreter_eval(Interpreter* interp, ASTNode* node) {
                             // 메서드 바디 실행
                             Value* result = interpreter_eval(interp, method->data.function_def.body);
                             
-                            environment_free(interp->current_env);
                             interp->current_env = prev_env;
                             
                             value_free(obj);
@@ -815,10 +919,11 @@ Value* interpreter_eval(Interpreter* interp, ASTNode* node) {
             
             if (obj->type == VAL_INSTANCE) {
                 // 필드 찾아서 수정
-                for (int i = 0; i < obj->data.instance.field_count; i++) {
-                    if (strcmp(obj->data.instance.field_names[i], node->data.field_assign.field_name) == 0) {
-                        value_free(obj->data.instance.field_values[i]);
-                        obj->data.instance.field_values[i] = value_copy(val);
+                for (int i = 0; i < obj->data.instance->field_count; i++) {
+                    if (obj->data.instance->field_names[i] == node->data.field_assign.field_name) {
+                        value_release(obj->data.instance->field_values[i]);
+                        obj->data.instance->field_values[i] = value_retain(val);
+                        gc_write_barrier(obj->data.instance->field_values[i]);
                         value_free(obj);
                         return val;
                     }
@@ -831,27 +936,29 @@ Value* interpreter_eval(Interpreter* interp, ASTNode* node) {
             
         case AST_SUPER: {
             // super 메서드 호출
-            Value* this_val = environment_get(interp->current_env, "this");
-            if (!this_val || this_val->type != VAL_INSTANCE || !this_val->data.instance.parent_class) {
+            Value* this_val = environment_get(interp->current_env, symbol_this);
+            if (!this_val || this_val->type != VAL_INSTANCE || !this_val->data.instance->parent_class) {
                 return value_create_null();
             }
             
             // 부모 클래스 찾기
-            Value* parent_class = environment_get(interp->global_env, this_val->data.instance.parent_class);
+            Value* parent_class = environment_get(interp->global_env, this_val->data.instance->parent_class);
             if (!parent_class || parent_class->type != VAL_CLASS) {
                 return value_create_null();
             }
+            gc_keep(this_val);
+            gc_keep(parent_class);
             
             // 부모 클래스에서 메서드 찾기
-            for (int i = 0; i < parent_class->data.class_def.method_count; i++) {
-                ASTNode* method = parent_class->data.class_def.methods[i];
-                if (strcmp(method->data.function_def.name, node->data.super_call.method_name) == 0) {
+            for (int i = 0; i < parent_class->data.class_def->method_count; i++) {
+                ASTNode* method = parent_class->data.class_def->methods[i];
+                if (method->data.function_def.name == node->data.super_call.method_name) {
                     // 메서드 실행
                     Environment* prev_env = interp->current_env;
-                    interp->current_env = environment_create(interp->current_env);
+                    interp->current_env = scope_env_create(interp->current_env, method->data.function_def.body);
                     
                     // this 바인딩 (현재 인스턴스 유지)
-                    environment_set(interp->current_env, "this", this_val);
+                    environment_set(interp->current_env, symbol_this, this_val);
                     
                     // 파라미터 바인딩
                     for (int j = 0; j < method->data.function_def.param_count && j < node->data.super_call.arg_count; j++) {
@@ -862,7 +969,6 @@ Value* interpreter_eval(Interpreter* interp, ASTNode* node) {
                     // 메서드 바디 실행
                     Value* result = interpreter_eval(interp, method->data.function_def.body);
                     
-                    environment_free(interp->current_env);
                     interp->current_env = prev_env;
                     
                     return result;
@@ -883,7 +989,7 @@ Value* interpreter_eval(Interpreter* interp, ASTNode* node) {
                 if (node->data.try_catch.exception_type) {
                     // 예외 타입 확인
                     if (interp->current_exception->type == VAL_EXCEPTION) {
-                        char* actual_type = interp->current_exception->data.exception.type;
+                        char* actual_type = interp->current_exception->data.exception->type;
                         char* expected_type = node->data.try_catch.exception_type;
                         type_matches = (strcmp(actual_type, expected_type) == 0);
                     } else {
@@ -894,7 +1000,7 @@ Value* interpreter_eval(Interpreter* interp, ASTNode* node) {
                 if (type_matches) {
                     // catch 블록 실행
                     Environment* prev_env = interp->current_env;
-                    interp->current_env = environment_create(interp->current_env);
+                    interp->current_env = scope_env_create(interp->current_env, node->data.try_catch.catch_block);
                     
                     // 예외 변수 바인딩
                     if (node->data.try_catch.exception_var) {
@@ -910,7 +1016,6 @@ Value* interpreter_eval(Interpreter* interp, ASTNode* node) {
                     // catch 블록 실행
                     Value* catch_result = interpreter_eval(interp, node->data.try_catch.catch_block);
                     
-                    environment_free(interp->current_env);
                     interp->current_env = prev_env;
                     
                     value_free(try_result);
@@ -1164,14 +1269,14 @@ Value* interpreter_eval_binary(Interpreter* interp, ASTNode* node) {
         }
     } else if (left->type == VAL_ARRAY && right->type == VAL_ARRAY) {
         // 벡터 연산
-        if (left->data.array.count == right->data.array.count) {
-            int count = left->data.array.count;
+        if (left->data.array->count == right->data.array->count) {
+            int count = left->data.array->count;
             Value** elements = (Value**)malloc(sizeof(Value*) * count);
             
             if (strcmp(op, "+") == 0 || strcmp(op, "-") == 0 || strcmp(op, "*") == 0) {
                 for (int i = 0; i < count; i++) {
-                    double l = left->data.array.elements[i]->data.number;
-                    double r = right->data.array.elements[i]->data.number;
+                    double l = left->data.array->elements[i]->data.number;
+                    double r = right->data.array->elements[i]->data.number;
                     
                     if (strcmp(op, "+") == 0) elements[i] = value_create_number(l + r);
                     else if (strcmp(op, "-") == 0) elements[i] = value_create_number(l - r);
@@ -1182,8 +1287,8 @@ Value* interpreter_eval_binary(Interpreter* interp, ASTNode* node) {
                 // 내적
                 double sum = 0;
                 for (int i = 0; i < count; i++) {
-                    double l = left->data.array.elements[i]->data.number;
-                    double r = right->data.array.elements[i]->data.number;
+                    double l = left->data.array->elements[i]->data.number;
+                    double r = right->data.array->elements[i]->data.number;
                     sum += l * r;
                 }
                 result = value_create_number(sum);
@@ -1193,22 +1298,22 @@ Value* interpreter_eval_binary(Interpreter* interp, ASTNode* node) {
         // 행렬 연산
         if (strcmp(op, "+") == 0 || strcmp(op, "-") == 0) {
             // 행렬 덧셈/뺄셈: 크기가 같아야 함
-            if (left->data.matrix.rows == right->data.matrix.rows &&
-                left->data.matrix.cols == right->data.matrix.cols) {
+            if (left->data.matrix->rows == right->data.matrix->rows &&
+                left->data.matrix->cols == right->data.matrix->cols) {
                 
-                int rows = left->data.matrix.rows;
-                int cols = left->data.matrix.cols;
+                int rows = left->data.matrix->rows;
+                int cols = left->data.matrix->cols;
                 Value* result_matrix = value_create_matrix(rows, cols);
                 
                 for (int i = 0; i < rows; i++) {
                     for (int j = 0; j < cols; j++) {
-                        double l = left->data.matrix.data[i][j];
-                        double r = right->data.matrix.data[i][j];
+                        double l = left->data.matrix->data[i][j];
+                        double r = right->data.matrix->data[i][j];
                         
                         if (strcmp(op, "+") == 0) {
-                            result_matrix->data.matrix.data[i][j] = l + r;
+                            result_matrix->data.matrix->data[i][j] = l + r;
                         } else {
-                            result_matrix->data.matrix.data[i][j] = l - r;
+                            result_matrix->data.matrix->data[i][j] = l - r;
                         }
                     }
                 }
@@ -1218,8 +1323,8 @@ Value* interpreter_eval_binary(Interpreter* interp, ASTNode* node) {
                 char msg[200];
                 snprintf(msg, sizeof(msg), 
                     "matrix dimension mismatch: (%dx%d) %s (%dx%d)",
-                    left->data.matrix.rows, left->data.matrix.cols, op,
-                    right->data.matrix.rows, right->data.matrix.cols);
+                    left->data.matrix->rows, left->data.matrix->cols, op,
+                    right->data.matrix->rows, right->data.matrix->cols);
                 interp->current_exception = value_create_exception("ValueError", msg);
                 exception_attach_stack_trace(interp, interp->current_exception);
                 interp->has_exception = 1;
@@ -1229,10 +1334,10 @@ Value* interpreter_eval_binary(Interpreter* interp, ASTNode* node) {
             }
         } else if (strcmp(op, "@") == 0) {
             // 행렬 곱셈: A의 열 수 = B의 행 수
-            if (left->data.matrix.cols == right->data.matrix.rows) {
-                int m = left->data.matrix.rows;
-                int n = right->data.matrix.cols;
-                int k = left->data.matrix.cols;
+            if (left->data.matrix->cols == right->data.matrix->rows) {
+                int m = left->data.matrix->rows;
+                int n = right->data.matrix->cols;
+                int k = left->data.matrix->cols;
                 
                 Value* result_matrix = value_create_matrix(m, n);
                 
@@ -1240,9 +1345,9 @@ Value* interpreter_eval_binary(Interpreter* interp, ASTNode* node) {
                     for (int j = 0; j < n; j++) {
                         double sum = 0.0;
                         for (int p = 0; p < k; p++) {
-                            sum += left->data.matrix.data[i][p] * right->data.matrix.data[p][j];
+                            sum += left->data.matrix->data[i][p] * right->data.matrix->data[p][j];
                         }
-                        result_matrix->data.matrix.data[i][j] = sum;
+                        result_matrix->data.matrix->data[i][j] = sum;
                     }
                 }
                 result = result_matrix;
@@ -1251,8 +1356,8 @@ Value* interpreter_eval_binary(Interpreter* interp, ASTNode* node) {
                 char msg[200];
                 snprintf(msg, sizeof(msg), 
                     "matrix dimension mismatch for multiplication: (%dx%d) @ (%dx%d)",
-                    left->data.matrix.rows, left->data.matrix.cols,
-                    right->data.matrix.rows, right->data.matrix.cols);
+                    left->data.matrix->rows, left->data.matrix->cols,
+                    right->data.matrix->rows, right->data.matrix->cols);
                 interp->current_exception = value_create_exception("ValueError", msg);
                 exception_attach_stack_trace(interp, interp->current_exception);
                 interp->has_exception = 1;
@@ -1268,13 +1373,13 @@ Value* interpreter_eval_binary(Interpreter* interp, ASTNode* node) {
             Value* matrix = (left->type == VAL_MATRIX) ? left : right;
             double scalar = (left->type == VAL_NUMBER) ? left->data.number : right->data.number;
             
-            int rows = matrix->data.matrix.rows;
-            int cols = matrix->data.matrix.cols;
+            int rows = matrix->data.matrix->rows;
+            int cols = matrix->data.matrix->cols;
             Value* result_matrix = value_create_matrix(rows, cols);
             
             for (int i = 0; i < rows; i++) {
                 for (int j = 0; j < cols; j++) {
-                    result_matrix->data.matrix.data[i][j] = matrix->data.matrix.data[i][j] * scalar;
+                    result_matrix->data.matrix->data[i][j] = matrix->data.matrix->data[i][j] * scalar;
                 }
             }
             result = result_matrix;
@@ -1326,11 +1431,11 @@ Value* interpreter_eval_function_call(Interpreter* interp, ASTNode* node) {
         if (node->data.function_call.arg_count > 0) {
             Value* arg = interpreter_eval(interp, node->data.function_call.args[0]);
             if (arg->type == VAL_ARRAY) {
-                Value* result = value_create_number(arg->data.array.count);
+                Value* result = value_create_number(arg->data.array->count);
                 value_free(arg);
                 return result;
             } else if (arg->type == VAL_DICT) {
-                Value* result = value_create_number(arg->data.dict.count);
+                Value* result = value_create_number(arg->data.dict->count);
                 value_free(arg);
                 return result;
             }
@@ -1343,8 +1448,8 @@ Value* interpreter_eval_function_call(Interpreter* interp, ASTNode* node) {
             Value* arg = interpreter_eval(interp, node->data.function_call.args[0]);
             if (arg->type == VAL_ARRAY) {
                 double sum = 0;
-                for (int i = 0; i < arg->data.array.count; i++) {
-                    sum += arg->data.array.elements[i]->data.number;
+                for (int i = 0; i < arg->data.array->count; i++) {
+                    sum += arg->data.array->elements[i]->data.number;
                 }
                 value_free(arg);
                 return value_create_number(sum);
@@ -1357,11 +1462,11 @@ Value* interpreter_eval_function_call(Interpreter* interp, ASTNode* node) {
         if (node->data.function_call.arg_count > 0) {
             Value* arg = interpreter_eval(interp, node->data.function_call.args[0]);
             if (arg->type == VAL_DICT) {
-                Value** elements = (Value**)malloc(sizeof(Value*) * arg->data.dict.count);
-                for (int i = 0; i < arg->data.dict.count; i++) {
-                    elements[i] = value_create_string(arg->data.dict.keys[i]);
+                Value** elements = (Value**)malloc(sizeof(Value*) * arg->data.dict->count);
+                for (int i = 0; i < arg->data.dict->count; i++) {
+                    elements[i] = value_create_string(arg->data.dict->keys[i]);
                 }
-                Value* result = value_create_array(elements, arg->data.dict.count);
+                Value* result = value_create_array(elements, arg->data.dict->count);
                 value_free(arg);
                 return result;
             }
@@ -1373,11 +1478,11 @@ Value* interpreter_eval_function_call(Interpreter* interp, ASTNode* node) {
         if (node->data.function_call.arg_count > 0) {
             Value* arg = interpreter_eval(interp, node->data.function_call.args[0]);
             if (arg->type == VAL_DICT) {
-                Value** elements = (Value**)malloc(sizeof(Value*) * arg->data.dict.count);
-                for (int i = 0; i < arg->data.dict.count; i++) {
-                    elements[i] = value_copy(arg->data.dict.values[i]);
+                Value** elements = (Value**)malloc(sizeof(Value*) * arg->data.dict->count);
+                for (int i = 0; i < arg->data.dict->count; i++) {
+                    elements[i] = value_copy(arg->data.dict->values[i]);
                 }
-                Value* result = value_create_array(elements, arg->data.dict.count);
+                Value* result = value_create_array(elements, arg->data.dict->count);
                 value_free(arg);
                 return result;
             }
@@ -1491,25 +1596,25 @@ Value* interpreter_eval_function_call(Interpreter* interp, ASTNode* node) {
             Value* arr = interpreter_eval(interp, node->data.function_call.args[1]);
             
             if (func->type == VAL_FUNCTION && arr->type == VAL_ARRAY) {
-                Value** new_elements = (Value**)malloc(sizeof(Value*) * arr->data.array.count);
+                Value** new_elements = (Value**)malloc(sizeof(Value*) * arr->data.array->count);
                 
-                for (int i = 0; i < arr->data.array.count; i++) {
+                for (int i = 0; i < arr->data.array->count; i++) {
                     // 함수 호출을 위한 임시 AST 노드 생성
                     ASTNode** args = (ASTNode**)malloc(sizeof(ASTNode*) * 1);
                     args[0] = (ASTNode*)malloc(sizeof(ASTNode));
                     args[0]->type = AST_NUMBER;
-                    args[0]->data.number = arr->data.array.elements[i]->data.number;
+                    args[0]->data.number = arr->data.array->elements[i]->data.number;
                     args[0]->line = node->line;
                     
                     // 함수 환경 생성 및 매개변수 바인딩
-                    Environment* func_env = environment_create(func->data.function.closure);
-                    environment_set(func_env, func->data.function.params[0], arr->data.array.elements[i]);
+                    Environment* func_env = scope_env_create(func->data.function->closure, func->data.function->body);
+                    environment_set(func_env, func->data.function->params[0], arr->data.array->elements[i]);
                     
                     Environment* prev_env = interp->current_env;
                     interp->current_env = func_env;
                     interp->has_returned = 0;
                     
-                    Value* result = interpreter_eval(interp, func->data.function.body);
+                    Value* result = interpreter_eval(interp, func->data.function->body);
                     
                     if (interp->has_returned) {
                         new_elements[i] = value_copy(interp->return_value);
@@ -1522,12 +1627,11 @@ Value* interpreter_eval_function_call(Interpreter* interp, ASTNode* node) {
                     }
                     
                     interp->current_env = prev_env;
-                    environment_free(func_env);
                     free(args[0]);
                     free(args);
                 }
                 
-                Value* result = value_create_array(new_elements, arr->data.array.count);
+                Value* result = value_create_array(new_elements, arr->data.array->count);
                 value_free(func);
                 value_free(arr);
                 return result;
@@ -1545,19 +1649,19 @@ Value* interpreter_eval_function_call(Interpreter* interp, ASTNode* node) {
             Value* arr = interpreter_eval(interp, node->data.function_call.args[1]);
             
             if (func->type == VAL_FUNCTION && arr->type == VAL_ARRAY) {
-                Value** temp_elements = (Value**)malloc(sizeof(Value*) * arr->data.array.count);
+                Value** temp_elements = (Value**)malloc(sizeof(Value*) * arr->data.array->count);
                 int count = 0;
                 
-                for (int i = 0; i < arr->data.array.count; i++) {
+                for (int i = 0; i < arr->data.array->count; i++) {
                     // 함수 환경 생성 및 매개변수 바인딩
-                    Environment* func_env = environment_create(func->data.function.closure);
-                    environment_set(func_env, func->data.function.params[0], arr->data.array.elements[i]);
+                    Environment* func_env = scope_env_create(func->data.function->closure, func->data.function->body);
+                    environment_set(func_env, func->data.function->params[0], arr->data.array->elements[i]);
                     
                     Environment* prev_env = interp->current_env;
                     interp->current_env = func_env;
                     interp->has_returned = 0;
                     
-                    Value* result = interpreter_eval(interp, func->data.function.body);
+                    Value* result = interpreter_eval(interp, func->data.function->body);
                     
                     int keep = 0;
                     if (interp->has_returned) {
@@ -1572,11 +1676,10 @@ Value* interpreter_eval_function_call(Interpreter* interp, ASTNode* node) {
                     }
                     
                     if (keep) {
-                        temp_elements[count++] = value_copy(arr->data.array.elements[i]);
+                        temp_elements[count++] = value_copy(arr->data.array->elements[i]);
                     }
                     
                     interp->current_env = prev_env;
-                    environment_free(func_env);
                 }
                 
                 Value** new_elements = (Value**)malloc(sizeof(Value*) * count);
@@ -1606,17 +1709,17 @@ Value* interpreter_eval_function_call(Interpreter* interp, ASTNode* node) {
             if (func->type == VAL_FUNCTION && arr->type == VAL_ARRAY) {
                 Value* accumulator = value_copy(initial);
                 
-                for (int i = 0; i < arr->data.array.count; i++) {
+                for (int i = 0; i < arr->data.array->count; i++) {
                     // 함수 환경 생성 및 매개변수 바인딩
-                    Environment* func_env = environment_create(func->data.function.closure);
-                    environment_set(func_env, func->data.function.params[0], accumulator);
-                    environment_set(func_env, func->data.function.params[1], arr->data.array.elements[i]);
+                    Environment* func_env = scope_env_create(func->data.function->closure, func->data.function->body);
+                    environment_set(func_env, func->data.function->params[0], accumulator);
+                    environment_set(func_env, func->data.function->params[1], arr->data.array->elements[i]);
                     
                     Environment* prev_env = interp->current_env;
                     interp->current_env = func_env;
                     interp->has_returned = 0;
                     
-                    Value* result = interpreter_eval(interp, func->data.function.body);
+                    Value* result = interpreter_eval(interp, func->data.function->body);
                     
                     value_free(accumulator);
                     if (interp->has_returned) {
@@ -1630,7 +1733,6 @@ Value* interpreter_eval_function_call(Interpreter* interp, ASTNode* node) {
                     }
                     
                     interp->current_env = prev_env;
-                    environment_free(func_env);
                 }
                 
                 value_free(func);
@@ -1646,8 +1748,9 @@ Value* interpreter_eval_function_call(Interpreter* interp, ASTNode* node) {
     }
     
     // 사용자 정의 함수
-    Value* func = environment_get(interp->current_env, name);
+    Value* func = environment_lookup(interp->current_env, node, name);
     if (func && func->type == VAL_FUNCTION) {
+        gc_keep(func);  // 인자를 계산하다 이름이 다시 묶여도 호출이 끝날 때까지 살아 있게
         // 스택에 함수 호출 정보 추가
         Value* stack_error = stack_push(interp, name, interp->current_file, node->line);
         if (stack_error) {
@@ -1656,21 +1759,21 @@ Value* interpreter_eval_function_call(Interpreter* interp, ASTNode* node) {
             return value_create_null();  // RecursionError 발생
         }
         
-        Environment* func_env = environment_create(func->data.function.closure);
+        Environment* func_env = scope_env_create(func->data.function->closure, func->data.function->body);
         
         // 매개변수 바인딩
-        for (int i = 0; i < func->data.function.param_count; i++) {
+        for (int i = 0; i < func->data.function->param_count; i++) {
             Value* arg = (i < node->data.function_call.arg_count) ?
                 interpreter_eval(interp, node->data.function_call.args[i]) :
                 value_create_null();
-            environment_set(func_env, func->data.function.params[i], arg);
+            environment_set(func_env, func->data.function->params[i], arg);
         }
         
         Environment* prev_env = interp->current_env;
         interp->current_env = func_env;
         interp->has_returned = 0;
         
-        Value* result = interpreter_eval(interp, func->data.function.body);
+        Value* result = interpreter_eval(interp, func->data.function->body);
         
         if (interp->has_returned) {
             value_free(result);
@@ -1681,7 +1784,6 @@ Value* interpreter_eval_function_call(Interpreter* interp, ASTNode* node) {
         }
         
         interp->current_env = prev_env;
-        environment_free(func_env);
         
         // 스택에서 함수 호출 정보 제거
         stack_pop(interp);
@@ -1692,192 +1794,379 @@ Value* interpreter_eval_function_call(Interpreter* interp, ASTNode* node) {
     return value_create_null();
 }
 
-// 환경 생성
+// 환경 생성 (처음에는 구조체 안의 배열만 씀)
 Environment* environment_create(Environment* parent) {
     Environment* env = (Environment*)malloc(sizeof(Environment));
-    env->capacity = 10;
-    env->names = (char**)malloc(sizeof(char*) * env->capacity);
-    env->values = (Value**)malloc(sizeof(Value*) * env->capacity);
+    env->names = env->inline_names;
+    env->values = env->inline_values;
+    env->capacity = ENV_INLINE;
     env->count = 0;
+    env->index = NULL;
+    env->index_capacity = 0;
     env->parent = parent;
+    gc_track_environment(env);
     return env;
 }
 
-// 환경 메모리 해제
+// 리졸버가 정한 자리 배치로 환경 생성 (names[i]가 자리 i, 값은 대입할 때 채움)
+Environment* environment_create_slots(Environment* parent, char** names, int count) {
+    Environment* env = environment_create(parent);
+    environment_reserve(env, names, count);
+    return env;
+}
+
+// 환경 메모리 해제 (이름은 심볼, 값은 GC가 따로 수집하므로 배열만 해제)
 void environment_free(Environment* env) {
     if (!env) return;
-    for (int i = 0; i < env->count; i++) {
-        free(env->names[i]);
-        value_free(env->values[i]);
+    if (!ENV_IS_INLINE(env)) {
+        free(env->names);
+        free(env->values);
     }
-    free(env->names);
-    free(env->values);
+    free(env->index);
     free(env);
 }
 
-// 변수 설정
-void environment_set(Environment* env, char* name, Value* value) {
-    for (int i = 0; i < env->count; i++) {
-        if (strcmp(env->names[i], name) == 0) {
-            value_free(env->values[i]);
-            env->values[i] = value;
-            return;
+// 이름 해시 테이블에 자리 하나 넣기 (칸이 남아 있고 이름이 없을 때만)
+static void environment_index_insert(Environment* env, int slot) {
+    int mask = env->index_capacity - 1;
+    int i = (int)(symbol_hash(env->names[slot]) & (uint32_t)mask);
+    while (env->index[i] >= 0) i = (i + 1) & mask;
+    env->index[i] = slot;
+}
+
+// 이름 해시 테이블을 capacity 칸으로 다시 만듦
+static void environment_reindex(Environment* env, int capacity) {
+    gc_account(sizeof(int) * (size_t)(capacity - env->index_capacity));
+    free(env->index);
+    env->index = (int*)malloc(sizeof(int) * capacity);
+    env->index_capacity = capacity;
+    for (int i = 0; i < capacity; i++) env->index[i] = -1;
+    for (int i = 0; i < env->count; i++) environment_index_insert(env, i);
+}
+
+// 이 환경에서만 name의 자리 번호 찾기 (값이 아직 없는 자리도, 없으면 -1)
+static int environment_find(Environment* env, char* name) {
+    if (!env->index) {
+        for (int i = 0; i < env->count; i++) {
+            if (env->names[i] == name) return i;
         }
+        return -1;
     }
     
-    if (env->count >= env->capacity) {
-        env->capacity *= 2;
-        env->names = (char**)realloc(env->names, sizeof(char*) * env->capacity);
-        env->values = (Value**)realloc(env->values, sizeof(Value*) * env->capacity);
+    int mask = env->index_capacity - 1;
+    for (int i = (int)(symbol_hash(name) & (uint32_t)mask); env->index[i] >= 0; i = (i + 1) & mask) {
+        if (env->names[env->index[i]] == name) return env->index[i];
     }
-    
-    env->names[env->count] = strdup(name);
-    env->values[env->count] = value;
-    env->count++;
+    return -1;
 }
 
-// 변수 가져오기
-Value* environment_get(Environment* env, char* name) {
-    for (int i = 0; i < env->count; i++) {
-        if (strcmp(env->names[i], name) == 0) {
-            return env->values[i];
+// 맨 뒤 자리에 새 이름 넣기 (name이 없을 때만)
+static void environment_append(Environment* env, char* name, Value* value) {
+    if (env->count == env->capacity) {
+        int capacity = env->capacity * 2;
+        gc_account((sizeof(char*) + sizeof(Value*)) * (size_t)(capacity - (ENV_IS_INLINE(env) ? 0 : env->capacity)));
+        if (ENV_IS_INLINE(env)) {
+            env->names = (char**)malloc(sizeof(char*) * capacity);
+            env->values = (Value**)malloc(sizeof(Value*) * capacity);
+            memcpy(env->names, env->inline_names, sizeof(char*) * env->count);
+            memcpy(env->values, env->inline_values, sizeof(Value*) * env->count);
+        } else {
+            env->names = (char**)realloc(env->names, sizeof(char*) * capacity);
+            env->values = (Value**)realloc(env->values, sizeof(Value*) * capacity);
         }
+        env->capacity = capacity;
     }
     
-    if (env->parent) {
-        return environment_get(env->parent, name);
+    int slot = env->count++;
+    env->names[slot] = name;
+    env->values[slot] = value;
+    
+    // ENV_INLINE개를 넘으면 이름으로 찾을 때 해시 테이블을 씀 (절반 넘게 차면 두 배로)
+    if (env->count <= ENV_INLINE) return;
+    if (env->count * 2 > env->index_capacity) {
+        environment_reindex(env, env->index_capacity ? env->index_capacity * 2 : ENV_INLINE * 4);
+    } else {
+        environment_index_insert(env, slot);
     }
+}
+
+// 뒤에 자리 덧붙이기 (이미 있는 이름은 건너뜀 - 리졸버가 이 환경의 이름 순서를 이어서 자리를
+// 정했으므로 보통은 그대로 맞고, 어긋나도 environment_set_at이 이름으로 처리함)
+void environment_reserve(Environment* env, char** names, int count) {
+    for (int i = 0; i < count; i++) {
+        if (i < env->count && env->names[i] == names[i]) continue;
+        if (environment_find(env, names[i]) < 0) environment_append(env, names[i], NULL);
+    }
+}
+
+// 변수 설정 (name은 심볼, 복사하지 않고 그대로 저장)
+void environment_set(Environment* env, char* name, Value* value) {
+    gc_write_barrier(value);  // 점진 표시 중이면 이미 표시된 환경이 흰 값을 가리키지 않게
+    value_retain(value);
     
+    int slot = environment_find(env, name);
+    if (slot >= 0) {
+        value_release(env->values[slot]);
+        env->values[slot] = value;
+        return;
+    }
+    environment_append(env, name, value);
+}
+
+// 리졸버가 정한 자리에 변수 설정 (그 자리가 name이 아니면 이름으로 찾음)
+void environment_set_at(Environment* env, int slot, char* name, Value* value) {
+    if (slot < 0 || slot >= env->count || env->names[slot] != name) {
+        environment_set(env, name, value);
+        return;
+    }
+    gc_write_barrier(value);
+    value_retain(value);
+    value_release(env->values[slot]);
+    env->values[slot] = value;
+}
+
+// 리졸버가 정한 (깊이, 자리)의 변수 자리 (대입된 값이 없거나 배치가 어긋나면 NULL - 이름으로 찾음)
+static Value** environment_at(Environment* env, int depth, int slot, char* name) {
+    if (slot < 0) return NULL;
+    for (int i = 0; i < depth && env; i++) env = env->parent;
+    if (!env || slot >= env->count || env->names[slot] != name || !env->values[slot]) return NULL;
+    return &env->values[slot];
+}
+
+// 변수 자리 찾기 (부모 환경까지, 없으면 NULL) - 쓰기 전에 복제본으로 바꿀 때
+static Value** environment_slot(Environment* env, char* name) {
+    for (; env; env = env->parent) {
+        int slot = environment_find(env, name);
+        if (slot >= 0 && env->values[slot]) return &env->values[slot];
+    }
+    return NULL;
+}
+
+// 변수 가져오기 (name은 심볼, 포인터로 비교)
+Value* environment_get(Environment* env, char* name) {
+    for (; env; env = env->parent) {
+        int slot = environment_find(env, name);
+        if (slot >= 0 && env->values[slot]) return env->values[slot];
+    }
     return NULL;
 }
 
+size_t value_body_size(ValueType type) {
+    switch (type) {
+        case VAL_ARRAY: return sizeof(ArrayBody);
+        case VAL_DICT: return sizeof(DictBody);
+        case VAL_FUNCTION: return sizeof(FunctionBody);
+        case VAL_CLASS: return sizeof(ClassBody);
+        case VAL_INSTANCE: return sizeof(InstanceBody);
+        case VAL_EXCEPTION: return sizeof(ExceptionBody);
+        case VAL_MODULE: return sizeof(ModuleBody);
+        case VAL_MATRIX: return sizeof(MatrixBody);
+        default: return 0;  // 숫자/문자열/불리언/null은 헤더에 바로
+    }
+}
+
+// GC가 관리하는 값 할당 (본문 필드는 호출한 쪽이 채우고 가변 크기 데이터는 gc_account로 더함)
+Value* value_alloc(ValueType type) {
+    Value* val = gc_alloc_value();
+    val->type = type;
+    size_t body_size = value_body_size(type);
+    val->data.body = body_size ? gc_alloc_body(body_size) : NULL;
+    return val;
+}
+
+// 공유 값: 숫자/불리언/null은 만든 뒤 바뀌지 않으므로 자주 쓰는 것은 하나씩만 만들어 고정해 두고
+// 같이 씀 (true/false/null, SMALL_INT_MIN..SMALL_INT_MAX의 정수). 비교 결과, 반복 카운터,
+// 인덱스 같은 값은 연산마다 새로 할당하지 않는다.
+#define SMALL_INT_MIN (-128)
+#define SMALL_INT_MAX 1023
+
+static Value* shared_null = NULL;
+static Value* shared_bools[2] = {NULL, NULL};
+static Value* shared_ints[SMALL_INT_MAX - SMALL_INT_MIN + 1];
+
+static Value* shared_value(ValueType type) {
+    Value* val = value_alloc(type);
+    gc_pin(val);
+    return val;
+}
+
 // 값 생성 함수들
 Value* value_create_number(double num) {
-    Value* val = (Value*)malloc(sizeof(Value));
-    val->type = VAL_NUMBER;
+    // -0은 공유하지 않음 (1 / -0 같은 곳에서 0과 다름)
+    if (num >= SMALL_INT_MIN && num <= SMALL_INT_MAX && num == (int)num && !(num == 0 && signbit(num))) {
+        Value** slot = &shared_ints[(int)num - SMALL_INT_MIN];
+        if (!*slot) {
+            *slot = shared_value(VAL_NUMBER);
+            (*slot)->data.number = num;
+        }
+        return *slot;
+    }
+    
+    Value* val = value_alloc(VAL_NUMBER);
     val->data.number = num;
     return val;
 }
 
 Value* value_create_bool(int boolean) {
-    Value* val = (Value*)malloc(sizeof(Value));
-    val->type = VAL_BOOL;
-    val->data.boolean = boolean ? 1 : 0;
-    return val;
+    Value** slot = &shared_bools[boolean ? 1 : 0];
+    if (!*slot) {
+        *slot = shared_value(VAL_BOOL);
+        (*slot)->data.boolean = boolean ? 1 : 0;
+    }
+    return *slot;
 }
 
 Value* value_create_string(char* str) {
-    Value* val = (Value*)malloc(sizeof(Value));
-    val->type = VAL_STRING;
+    Value* val = value_alloc(VAL_STRING);
     val->data.string = strdup(str);
+    gc_account(strlen(str) + 1);
     return val;
 }
 
 Value* value_create_array(Value** elements, int count) {
-    Value* val = (Value*)malloc(sizeof(Value));
-    val->type = VAL_ARRAY;
-    val->data.array.elements = elements;
-    val->data.array.count = count;
+    Value* val = value_alloc(VAL_ARRAY);
+    val->data.array->elements = elements;
+    val->data.array->count = count;
+    val->data.array->refcount = 0;
+    for (int i = 0; i < count; i++) {
+        value_retain(elements[i]);
+    }
+    gc_account(sizeof(Value*) * (size_t)count);
     return val;
 }
 
 Value* value_create_dict(char** keys, Value** values, int count) {
-    Value* val = (Value*)malloc(sizeof(Value));
-    val->type = VAL_DICT;
-    val->data.dict.keys = keys;
-    val->data.dict.values = values;
-    val->data.dict.count = count;
+    Value* val = value_alloc(VAL_DICT);
+    val->data.dict->keys = keys;
+    val->data.dict->values = values;
+    val->data.dict->count = count;
+    val->data.dict->refcount = 0;
+    for (int i = 0; i < count; i++) {
+        value_retain(values[i]);
+    }
+    gc_account((sizeof(char*) + sizeof(Value*)) * (size_t)count);
     return val;
 }
 
 Value* value_create_null() {
-    Value* val = (Value*)malloc(sizeof(Value));
-    val->type = VAL_NULL;
-    return val;
+    if (!shared_null) shared_null = shared_value(VAL_NULL);
+    return shared_null;
 }
 
 Value* value_create_exception(char* type, char* message) {
-    Value* val = (Value*)malloc(sizeof(Value));
-    val->type = VAL_EXCEPTION;
-    val->data.exception.type = strdup(type);
-    val->data.exception.message = strdup(message);
-    val->data.exception.stack_trace = NULL;
-    val->data.exception.stack_depth = 0;
+    Value* val = value_alloc(VAL_EXCEPTION);
+    val->data.exception->type = strdup(type);
+    val->data.exception->message = strdup(message);
+    val->data.exception->stack_trace = NULL;
+    val->data.exception->stack_depth = 0;
     return val;
 }
 
 Value* value_create_module(char* name, Environment* exports) {
-    Value* val = (Value*)malloc(sizeof(Value));
-    val->type = VAL_MODULE;
-    val->data.module.name = strdup(name);
-    val->data.module.exports = exports;
+    Value* val = value_alloc(VAL_MODULE);
+    val->data.module->name = name;
+    val->data.module->exports = exports;
     return val;
 }
 
 Value* value_create_matrix(int rows, int cols) {
-    Value* val = (Value*)malloc(sizeof(Value));
-    val->type = VAL_MATRIX;
-    val->data.matrix.rows = rows;
-    val->data.matrix.cols = cols;
+    Value* val = value_alloc(VAL_MATRIX);
+    val->data.matrix->rows = rows;
+    val->data.matrix->cols = cols;
     
     // 2차원 배열 할당
-    val->data.matrix.data = (double**)malloc(sizeof(double*) * rows);
+    val->data.matrix->data = (double**)malloc(sizeof(double*) * rows);
     for (int i = 0; i < rows; i++) {
-        val->data.matrix.data[i] = (double*)calloc(cols, sizeof(double));
+        val->data.matrix->data[i] = (double*)calloc(cols, sizeof(double));
     }
+    gc_account(sizeof(double*) * (size_t)rows + sizeof(double) * (size_t)rows * (size_t)cols);
     
     return val;
 }
 
-// 값 복사
+// 공유 수 (배열/딕셔너리만 셈, 그 밖의 값은 NULL)
+static int* refcount_of(Value* val) {
+    if (!val) return NULL;
+    if (val->type == VAL_ARRAY) return &val->data.array->refcount;
+    if (val->type == VAL_DICT) return &val->data.dict->refcount;
+    return NULL;
+}
+
+// 변수/요소/필드에 담을 때 (메모리는 GC가 관리하므로 수는 복제 여부를 정할 때만 씀)
+Value* value_retain(Value* val) {
+    int* refcount = refcount_of(val);
+    if (refcount) (*refcount)++;
+    return val;
+}
+
+// 담고 있던 자리를 덮어쓸 때
+void value_release(Value* val) {
+    int* refcount = refcount_of(val);
+    if (refcount && *refcount > 0) (*refcount)--;
+}
+
+// 쓰기 전 복제 (copy-on-write)
+// 다른 곳에서도 담고 있으면 요소만 얕게 복제하고 자리 하나를 복제본으로 옮김 (자식은 복제본도 담으므로 공유 수 +1)
+Value* value_unshare(Value* val) {
+    int* refcount = refcount_of(val);
+    if (!refcount || *refcount <= 1) return val;
+    
+    Value* copy;
+    if (val->type == VAL_ARRAY) {
+        int count = val->data.array->count;
+        Value** elements = (Value**)malloc(sizeof(Value*) * (count > 0 ? count : 1));
+        memcpy(elements, val->data.array->elements, sizeof(Value*) * count);
+        copy = value_create_array(elements, count);
+    } else {
+        int count = val->data.dict->count;
+        char** keys = (char**)malloc(sizeof(char*) * (count > 0 ? count : 1));
+        Value** values = (Value**)malloc(sizeof(Value*) * (count > 0 ? count : 1));
+        for (int i = 0; i < count; i++) {
+            keys[i] = strdup(val->data.dict->keys[i]);
+            values[i] = val->data.dict->values[i];
+        }
+        copy = value_create_dict(keys, values, count);
+    }
+    
+    (*refcount)--;
+    *refcount_of(copy) = 1;
+    return copy;
+}
+
+// 값 복사 (배열/딕셔너리/행렬은 공유, 쓰는 쪽이 value_unshare로 복제하므로 값 의미는 그대로)
 Value* value_copy(Value* val) {
     if (!val) return value_create_null();
     
     switch (val->type) {
         case VAL_NUMBER:
-            return value_create_number(val->data.number);
         case VAL_BOOL:
-            return value_create_bool(val->data.boolean);
+        case VAL_NULL:
+            // 바뀌지 않는 값은 그대로 같이 씀
+            gc_keep(val);
+            return val;
         case VAL_STRING:
             return value_create_string(val->data.string);
-        case VAL_ARRAY: {
-            Value** elements = (Value**)malloc(sizeof(Value*) * val->data.array.count);
-            for (int i = 0; i < val->data.array.count; i++) {
-                elements[i] = value_copy(val->data.array.elements[i]);
-            }
-            return value_create_array(elements, val->data.array.count);
-        }
-        case VAL_DICT: {
-            char** keys = (char**)malloc(sizeof(char*) * val->data.dict.count);
-            Value** values = (Value**)malloc(sizeof(Value*) * val->data.dict.count);
-            for (int i = 0; i < val->data.dict.count; i++) {
-                keys[i] = strdup(val->data.dict.keys[i]);
-                values[i] = value_copy(val->data.dict.values[i]);
-            }
-            return value_create_dict(keys, values, val->data.dict.count);
-        }
+        case VAL_ARRAY:
+        case VAL_DICT:
+        case VAL_MATRIX:
+            // 행렬은 만든 뒤 바뀌지 않음 (연산마다 새 행렬)
+            gc_keep(val);
+            return val;
         case VAL_FUNCTION: {
             // 함수는 참조로 전달 (클로저를 공유)
+            gc_keep(val);  // 새로 만든 값처럼 현재 스코프가 끝날 때까지 루트로
             return val;
         }
         case VAL_CLASS:
         case VAL_INSTANCE:
         case VAL_MODULE:
             // 클래스, 인스턴스, 모듈은 참조로 전달 (간단한 구현)
+            gc_keep(val);
             return val;
-        case VAL_MATRIX: {
-            Value* copy = value_create_matrix(val->data.matrix.rows, val->data.matrix.cols);
-            for (int i = 0; i < val->data.matrix.rows; i++) {
-                for (int j = 0; j < val->data.matrix.cols; j++) {
-                    copy->data.matrix.data[i][j] = val->data.matrix.data[i][j];
-                }
-            }
-            return copy;
-        }
         case VAL_EXCEPTION: {
-            Value* exc = value_create_exception(val->data.exception.type, val->data.exception.message);
-            exc->data.exception.stack_trace = stack_copy(val->data.exception.stack_trace);
-            exc->data.exception.stack_depth = val->data.exception.stack_depth;
+            Value* exc = value_create_exception(val->data.exception->type, val->data.exception->message);
+            exc->data.exception->stack_trace = stack_copy(val->data.exception->stack_trace);
+            exc->data.exception->stack_depth = val->data.exception->stack_depth;
             return exc;
         }
         default:
@@ -1885,12 +2174,14 @@ Value* value_copy(Value* val) {
     }
 }
 
-// 값 메모리 해제
+// 값 메모리 해제: 값은 여러 곳에서 공유되므로 여기서는 아무것도 하지 않고
+// 닿지 않게 된 값은 GC가 수집한다 (gc.h)
 void value_free(Value* val) {
-    // 간단하게 하기 위해 메모리 해제를 비활성화
-    // 짧은 실행 시간의 스크립트에서는 OS가 정리함
-    return;
-    
+    (void)val;
+}
+
+// 값 본문과 그 데이터 해제 (GC의 sweep만 부름, 헤더는 sweep이 슬랩으로 돌려줌, 자식 값은 각자 따로 수집됨)
+void value_destroy(Value* val) {
     if (!val) return;
     
     switch (val->type) {
@@ -1903,68 +2194,49 @@ void value_free(Value* val) {
             free(val->data.string);
             break;
         case VAL_ARRAY:
-            for (int i = 0; i < val->data.array.count; i++) {
-                value_free(val->data.array.elements[i]);
-            }
-            free(val->data.array.elements);
+            free(val->data.array->elements);
             break;
         case VAL_DICT:
-            for (int i = 0; i < val->data.dict.count; i++) {
-                free(val->data.dict.keys[i]);
-                value_free(val->data.dict.values[i]);
+            for (int i = 0; i < val->data.dict->count; i++) {
+                free(val->data.dict->keys[i]);
             }
-            free(val->data.dict.keys);
-            free(val->data.dict.values);
+            free(val->data.dict->keys);
+            free(val->data.dict->values);
             break;
         case VAL_FUNCTION:
-            // 함수의 파라미터 메모리 해제
-            for (int i = 0; i < val->data.function.param_count; i++) {
-                free(val->data.function.params[i]);
-            }
-            free(val->data.function.params);
+            // 파라미터 이름은 심볼이므로 배열만 해제
+            free(val->data.function->params);
             // body는 AST 노드이므로 여기서 해제하지 않음 (AST에서 관리)
             break;
         case VAL_CLASS:
-            free(val->data.class_def.name);
-            if (val->data.class_def.parent_class) {
-                free(val->data.class_def.parent_class);
-            }
-            for (int i = 0; i < val->data.class_def.field_count; i++) {
-                free(val->data.class_def.fields[i]);
-            }
-            free(val->data.class_def.fields);
-            free(val->data.class_def.methods);
+            // 클래스/필드 이름은 심볼
+            free(val->data.class_def->fields);
+            free(val->data.class_def->methods);
             break;
         case VAL_INSTANCE:
-            free(val->data.instance.class_name);
-            if (val->data.instance.parent_class) {
-                free(val->data.instance.parent_class);
-            }
-            for (int i = 0; i < val->data.instance.field_count; i++) {
-                free(val->data.instance.field_names[i]);
-                value_free(val->data.instance.field_values[i]);
-            }
-            free(val->data.instance.field_names);
-            free(val->data.instance.field_values);
+            // 클래스/필드 이름은 심볼
+            free(val->data.instance->field_names);
+            free(val->data.instance->field_values);
             break;
         case VAL_EXCEPTION:
-            free(val->data.exception.type);
-            free(val->data.exception.message);
-            if (val->data.exception.stack_trace) {
-                stack_frame_free(val->data.exception.stack_trace);
+            free(val->data.exception->type);
+            free(val->data.exception->message);
+            if (val->data.exception->stack_trace) {
+                stack_frame_free(val->data.exception->stack_trace);
             }
             break;
         case VAL_MATRIX:
-            for (int i = 0; i < val->data.matrix.rows; i++) {
-                free(val->data.matrix.data[i]);
+            for (int i = 0; i < val->data.matrix->rows; i++) {
+                free(val->data.matrix->data[i]);
             }
-            free(val->data.matrix.data);
+            free(val->data.matrix->data);
             break;
         default:
             break;
     }
     
-    free(val);
+    size_t body_size = value_body_size(val->type);
+    if (body_size) gc_free_body(val->data.body, body_size);
 }
 
 // 값 출력
@@ -1990,53 +2262,53 @@ void value_print(Value* val) {
             break;
         case VAL_ARRAY:
             printf("[");
-            for (int i = 0; i < val->data.array.count; i++) {
-                value_print(val->data.array.elements[i]);
-                if (i < val->data.array.count - 1) printf(", ");
+            for (int i = 0; i < val->data.array->count; i++) {
+                value_print(val->data.array->elements[i]);
+                if (i < val->data.array->count - 1) printf(", ");
             }
             printf("]");
             break;
         case VAL_DICT:
             printf("{");
-            for (int i = 0; i < val->data.dict.count; i++) {
-                printf("%s: ", val->data.dict.keys[i]);
-                value_print(val->data.dict.values[i]);
-                if (i < val->data.dict.count - 1) printf(", ");
+            for (int i = 0; i < val->data.dict->count; i++) {
+                printf("%s: ", val->data.dict->keys[i]);
+                value_print(val->data.dict->values[i]);
+                if (i < val->data.dict->count - 1) printf(", ");
             }
             printf("}");
             break;
         case VAL_CLASS:
-            printf("<class %s>", val->data.class_def.name);
+            printf("<class %s>", val->data.class_def->name);
             break;
         case VAL_INSTANCE:
-            printf("<%s instance>", val->data.instance.class_name);
+            printf("<%s instance>", val->data.instance->class_name);
             break;
         case VAL_FUNCTION:
             printf("<function>");
             break;
         case VAL_MODULE:
-            printf("<module '%s'>", val->data.module.name);
+            printf("<module '%s'>", val->data.module->name);
             break;
         case VAL_MATRIX:
-            printf("Matrix(%dx%d)[\n", val->data.matrix.rows, val->data.matrix.cols);
-            for (int i = 0; i < val->data.matrix.rows; i++) {
+            printf("Matrix(%dx%d)[\n", val->data.matrix->rows, val->data.matrix->cols);
+            for (int i = 0; i < val->data.matrix->rows; i++) {
                 printf("  [");
-                for (int j = 0; j < val->data.matrix.cols; j++) {
-                    printf("%g", val->data.matrix.data[i][j]);
-                    if (j < val->data.matrix.cols - 1) printf(", ");
+                for (int j = 0; j < val->data.matrix->cols; j++) {
+                    printf("%g", val->data.matrix->data[i][j]);
+                    if (j < val->data.matrix->cols - 1) printf(", ");
                 }
                 printf("]");
-                if (i < val->data.matrix.rows - 1) printf(",");
+                if (i < val->data.matrix->rows - 1) printf(",");
                 printf("\n");
             }
             printf("]");
             break;
         case VAL_EXCEPTION:
             // 스택 트레이스가 있으면 먼저 출력
-            if (val->data.exception.stack_trace) {
-                print_stack_trace(val->data.exception.stack_trace, val->data.exception.stack_depth);
+            if (val->data.exception->stack_trace) {
+                print_stack_trace(val->data.exception->stack_trace, val->data.exception->stack_depth);
             }
-            printf("%s: %s", val->data.exception.type, val->data.exception.message);
+            printf("%s: %s", val->data.exception->type, val->data.exception->message);
             break;
         case VAL_NULL:
             printf("null");
@@ -2156,16 +2428,23 @@ void print_stack_trace(StackFrame* stack, int depth) {
     }
 }
 
+// 잡히지 않은 예외 출력: 인터프리터, 스택 VM, JIT, 레지스터 VM이 모두 이 형식으로 stdout에 출력하고
+// 프로그램은 정상 종료 코드로 끝난다
+void exception_report_uncaught(Value* exception) {
+    value_print(exception);
+    printf("\n");
+}
+
 // 예외에 스택 트레이스 첨부
 void exception_attach_stack_trace(Interpreter* interp, Value* exception) {
     if (!exception || exception->type != VAL_EXCEPTION) return;
     
     // 기존 스택 트레이스가 있으면 해제
-    if (exception->data.exception.stack_trace) {
-        stack_frame_free(exception->data.exception.stack_trace);
+    if (exception->data.exception->stack_trace) {
+        stack_frame_free(exception->data.exception->stack_trace);
     }
     
     // 현재 스택 복사
-    exception->data.exception.stack_trace = stack_copy(interp->call_stack);
-    exception->data.exception.stack_depth = interp->stack_depth;
+    exception->data.exception->stack_trace = stack_copy(interp->call_stack);
+    exception->data.exception->stack_depth = interp->stack_depth;
 }
@@ -3,6 +3,7 @@
 
 #include "parser.h"
 #include <math.h>
+#include <stdint.h>
 
 // 전방 선언
 struct StackFrame;
@@ -25,67 +26,112 @@ typedef enum {
 } ValueType;
 
 // 값 구조체
+//
+// 헤더(타입, 해시, GC 링크) + 8바이트 본문. 숫자/문자열/불리언은 본문에 바로 들어가고,
+// 그보다 큰 값은 따로 할당한 본문을 가리킨다 (value_alloc이 타입에 맞춰 0으로 채워 만들고
+// value_destroy가 해제). 숫자 배열의 원소 하나가 24바이트다.
+struct Value;
+
+typedef struct {
+    struct Value** elements;
+    int count;
+    int refcount;  // 담고 있는 변수/요소/필드 수 (1보다 크면 쓰기 전에 복제, value_unshare)
+} ArrayBody;
+
+typedef struct {
+    char** keys;
+    struct Value** values;
+    int count;
+    int refcount;  // ArrayBody.refcount와 같음
+} DictBody;
+
+typedef struct {
+    char** params;  // 심볼
+    int param_count;
+    ASTNode* body;
+    struct Environment* closure;
+    struct BytecodeChunk* chunk;  // VM용으로 컴파일된 본문 (인터프리터 함수는 NULL)
+    struct RegChunk* reg_chunk;   // 레지스터 VM용으로 컴파일된 본문 (없으면 NULL)
+} FunctionBody;
+
+typedef struct {
+    char* name;     // 심볼 (이름/필드/부모 클래스 모두)
+    char** fields;
+    int field_count;
+    ASTNode** methods;
+    int method_count;
+    char* parent_class;  // 부모 클래스 이름
+} ClassBody;
+
+typedef struct {
+    char* class_name;  // 심볼 (클래스/필드/부모 클래스 이름 모두)
+    struct Value** field_values;
+    int field_count;
+    char** field_names;
+    char* parent_class;  // 부모 클래스 이름
+} InstanceBody;
+
+typedef struct {
+    char* type;     // "TypeError", "ValueError" 등
+    char* message;  // 에러 메시지
+    struct StackFrame* stack_trace;  // 스택 트레이스
+    int stack_depth;          // 스택 깊이
+} ExceptionBody;
+
+typedef struct {
+    char* name;  // 모듈 이름 (심볼)
+    struct Environment* exports;  // 모듈의 export된 심볼들
+} ModuleBody;
+
+typedef struct {
+    double** data;  // 2차원 배열 (행렬 데이터)
+    int rows;       // 행 개수
+    int cols;       // 열 개수
+} MatrixBody;
+
 typedef struct Value {
     ValueType type;
+    uint32_t hash;  // 인턴된 문자열의 해시 (intern_string이 채움, 그 밖의 값에서는 쓰지 않음)
+    struct Value* gc_next;  // GC 목록의 다음 값 (아래 두 비트는 표시/고정 플래그, gc.c만 씀)
     union {
         double number;
         char* string;
         int boolean;  // 0 = false, 1 = true
-        struct {
-            struct Value** elements;
-            int count;
-        } array;
-        struct {
-            char** keys;
-            struct Value** values;
-            int count;
-        } dict;
-        struct {
-            char** params;
-            int param_count;
-            ASTNode* body;
-            struct Environment* closure;
-        } function;
-        struct {
-            char* name;
-            char** fields;
-            int field_count;
-            ASTNode** methods;
-            int method_count;
-            char* parent_class;  // 부모 클래스 이름
-        } class_def;
-        struct {
-            char* class_name;
-            struct Value** field_values;
-            int field_count;
-            char** field_names;
-            char* parent_class;  // 부모 클래스 이름
-        } instance;
-        struct {
-            char* type;     // "TypeError", "ValueError" 등
-            char* message;  // 에러 메시지
-            struct StackFrame* stack_trace;  // 스택 트레이스
-            int stack_depth;          // 스택 깊이
-        } exception;
-        struct {
-            char* name;  // 모듈 이름
-            struct Environment* exports;  // 모듈의 export된 심볼들
-        } module;
-        struct {
-            double** data;  // 2차원 배열 (행렬 데이터)
-            int rows;       // 행 개수
-            int cols;       // 열 개수
-        } matrix;
+        void* body;   // 아래 본문 포인터 중 하나 (타입과 상관없이 해제할 때)
+        ArrayBody* array;
+        DictBody* dict;
+        FunctionBody* function;
+        ClassBody* class_def;
+        InstanceBody* instance;
+        ExceptionBody* exception;
+        ModuleBody* module;
+        MatrixBody* matrix;
     } data;
 } Value;
 
 // 환경 (변수 스코프)
+//
+// 변수는 자리(slot) 순서대로 names/values 배열에 들어간다. 리졸버(resolver.h)가 스코프마다 정한
+// 자리 배치로 만든 환경은 처음부터 이름이 채워져 있고 값은 NULL이다 (아직 대입 전: 이름으로 찾을
+// 때는 없는 것으로 보고 부모로 넘어감). 이름으로 찾을 때는 ENV_INLINE개 이하면 선형 탐색,
+// 넘으면 심볼 해시(symbol_hash)로 이름 → 자리 해시 테이블을 만들어 쓴다 (열린 주소, 선형 탐사).
+// 배열은 ENV_INLINE개까지 구조체 안에 있어서 작은 함수 스코프는 따로 할당하지 않는다.
+// 변수는 지우지 않으므로 자리 번호는 바뀌지 않는다.
+#define ENV_INLINE 8
+#define ENV_IS_INLINE(env) ((env)->names == (env)->inline_names)
+
 typedef struct Environment {
-    char** names;
-    Value** values;
+    char** names;  // 심볼 (intern.h, 포인터로 비교), 자리 순서
+    Value** values;  // NULL이면 자리만 있고 값은 아직 없음
     int count;
     int capacity;
+    int* index;          // 이름 → 자리 해시 테이블 (-1은 빈 칸, 필요할 때 만듦)
+    int index_capacity;  // 2의 거듭제곱
     struct Environment* parent;
+    struct Environment* gc_next;  // GC 목록의 다음 환경
+    int gc_marked;
+    char* inline_names[ENV_INLINE];
+    Value* inline_values[ENV_INLINE];
 } Environment;
 
 // 스택 프레임 (함수 호출 정보) - 전방 선언을 위해 typedef 분리
@@ -110,17 +156,24 @@ typedef struct {
     int max_stack_depth;       // 최대 스택 깊이 (기본: 1000)
     char* current_file;        // 현재 실행 중인 파일
     struct ModuleCache* module_cache;  // 모듈 캐시
+    ASTNode** programs;        // REPL 줄마다의 AST (함수 본문/블록 자리 배치가 아레나를 가리키므로 끝까지 보관)
+    int program_count;
+    int program_capacity;
 } Interpreter;
 
 // 함수 선언
 Interpreter* interpreter_create();
 void interpreter_free(Interpreter* interp);
+void interpreter_keep_program(Interpreter* interp, ASTNode* program);  // interpreter_free가 ast_free
 Value* interpreter_eval(Interpreter* interp, ASTNode* node);
 Value* interpreter_eval_binary(Interpreter* interp, ASTNode* node);
 Value* interpreter_eval_function_call(Interpreter* interp, ASTNode* node);
 Environment* environment_create(Environment* parent);
-void environment_free(Environment* env);
+Environment* environment_create_slots(Environment* parent, char** names, int count);  // 리졸버가 정한 자리 배치로
+void environment_reserve(Environment* env, char** names, int count);  // 뒤에 자리 덧붙이기 (names[i]가 자리 i에 오게)
+void environment_free(Environment* env);  // GC가 수집할 때만 부름 (값은 따로 수집)
 void environment_set(Environment* env, char* name, Value* value);
+void environment_set_at(Environment* env, int slot, char* name, Value* value);  // 자리가 name이 아니면 이름으로
 Value* environment_get(Environment* env, char* name);
 Value* value_create_number(double num);
 Value* value_create_bool(int boolean);
@@ -131,8 +184,14 @@ Value* value_create_exception(char* type, char* message);
 Value* value_create_module(char* name, Environment* exports);
 Value* value_create_matrix(int rows, int cols);
 Value* value_create_null();
-Value* value_copy(Value* val);
-void value_free(Value* val);
+Value* value_alloc(ValueType type);  // GC가 관리하는 빈 값 (본문이 있는 타입은 0으로 채운 본문까지, 필드는 호출한 쪽이 채움)
+size_t value_body_size(ValueType type);  // 따로 할당하는 본문 크기 (본문이 없으면 0)
+Value* value_copy(Value* val);     // 배열/딕셔너리/행렬은 복사하지 않고 공유 (쓰기 때 복제)
+Value* value_retain(Value* val);   // 변수/요소/필드에 담을 때 (공유 수 +1)
+void value_release(Value* val);    // 담고 있던 자리를 덮어쓸 때 (공유 수 -1)
+Value* value_unshare(Value* val);  // 쓰기 전: 공유 중이면 얕은 복제본 (자리는 복제본으로 바꿔야 함)
+void value_free(Value* val);     // 아무것도 하지 않음 (메모리는 GC가 회수, gc.h)
+void value_destroy(Value* val);  // GC가 수집할 때만 부름 (본문만 해제, 자식 값은 따로 수집)
 void value_print(Value* val);
 
 // 스택 프레임 함수
@@ -143,5 +202,6 @@ void stack_pop(Interpreter* interp);
 StackFrame* stack_copy(StackFrame* stack);
 void print_stack_trace(StackFrame* stack, int depth);
 void exception_attach_stack_trace(Interpreter* interp, Value* exception);
+void exception_report_uncaught(Value* exception);  // 잡히지 않은 예외 출력 (모든 실행 모드 공용)
 
 #endif
@@ -0,0 +1,647 @@
+#include "jit.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__)
+
+#include <setjmp.h>
+#include <stdint.h>
+#include <limits.h>
+#include "x64.h"
+#include "gc.h"
+
+// ============ 런타임 헬퍼 (생성된 코드가 호출) ============
+// 스택을 건드리는 헬퍼는 스택 top 포인터를 받아 새 top을 돌려준다.
+
+typedef VMValue (*JitFunction)(VM* vm, VMValue* sp, VMValue* slots);
+
+// 기계어 프레임은 스택 주소를 레지스터에 들고 있어서 실행 중에 스택을 옮길 수 없다.
+// 같은 이유로 예외 핸들러 테이블로 되감을 수도 없으므로 JIT 코드의 런타임 에러는 출력 후 종료한다.
+// 그래서 vm_run처럼 프레임마다 늘리지 않고 jit_run에서 한 번에 확보한다.
+#define JIT_STACK_MAX (FRAMES_MAX * 64)
+
+// 루프 횟수 초과 시 jit_run으로 돌아갈 위치 (중첩된 기계어 프레임을 한 번에 빠져나옴)
+static jmp_buf jit_exit;
+
+// 이항 연산 느린 경로 (숫자가 아닌 피연산자, 0으로 나누기, MOD/EQUAL 등)
+static VMValue* jit_binary(VMValue* sp, int opcode) {
+    sp[-2] = vm_binary_op((OpCode)opcode, sp[-2], sp[-1]);
+    return sp - 1;
+}
+
+static VMValue* jit_unary(VMValue* sp, int opcode) {
+    sp[-1] = vm_unary_op((OpCode)opcode, sp[-1]);
+    return sp;
+}
+
+// x = x + k 느린 경로 (숫자가 아니면 타입 에러)
+static void jit_increment(VMValue* slot, long amount) {
+    if (!IS_NUMBER(*slot)) {
+        vm_runtime_error("TypeError", "unsupported operand types for +");
+    }
+    *slot = NUMBER_VAL(AS_NUMBER(*slot) + amount);
+}
+
+static void jit_undefined_global(VM* vm, long slot) {
+    vm_runtime_error("NameError", "name '%s' is not defined", vm->chunk->global_names[slot]);
+}
+
+static void jit_print(VMValue value) {
+    vm_value_print(value);
+    printf("\n");
+}
+
+static VMValue* jit_build_array(VMValue* sp, long size) {
+    Value** elements = (Value**)malloc(sizeof(Value*) * (size > 0 ? size : 1));
+    for (long i = 0; i < size; i++) {
+        elements[i] = vm_value_to_heap(sp[i - size]);
+    }
+    sp -= size;
+    *sp = OBJ_VAL(value_create_array(elements, size));
+    return sp + 1;
+}
+
+static VMValue* jit_call_builtin(VMValue* sp, long builtin, long arg_count) {
+    VMValue result = vm_call_builtin(builtin, sp - arg_count, arg_count);
+    sp -= arg_count;
+    *sp = result;
+    return sp + 1;
+}
+
+static void jit_loop_limit(VM* vm) {
+    fprintf(stderr, "Too many loop iterations (%ld)! Possible infinite loop.\n",
+            vm->max_loop_iterations);
+    longjmp(jit_exit, 1);
+}
+
+// 역방향 점프의 안전 지점 (할당량이 문턱을 넘었을 때만 불림)
+// 기계어 프레임의 값은 모두 sp 아래 VM 스택에 있으므로 stack_top만 맞추면 mark_vm_roots가 훑는다.
+static void jit_safepoint(VM* vm, VMValue* sp) {
+    vm->stack_top = sp;
+    gc_safepoint();
+}
+
+// OP_CALL: 인자 맞추기, 지역 변수 슬롯 준비 후 함수의 기계어를 C 호출로 실행
+static VMValue* jit_call(VM* vm, VMValue* sp, long arg_count) {
+    VMValue callee = sp[-1 - arg_count];
+    if (!IS_OBJ_TYPE(callee, VAL_FUNCTION) || !AS_OBJ(callee)->data.function->chunk) {
+        vm_runtime_error("TypeError", "value is not callable");
+    }
+    BytecodeChunk* function = AS_OBJ(callee)->data.function->chunk;
+    VMValue* slots = sp - 1 - arg_count;
+
+    // 프레임 하나가 쓰는 스택은 컴파일러가 계산한 max_stack
+    if (vm->frame_count >= FRAMES_MAX || slots + function->max_stack > vm->stack + vm->stack_capacity) {
+        vm_runtime_error("RecursionError", "maximum recursion depth exceeded");
+    }
+
+    // 인자 개수 맞추기 (모자라면 null, 남으면 버림), 나머지 지역 변수 슬롯은 null
+    for (; arg_count < function->arity; arg_count++) *sp++ = NULL_VAL;
+    sp -= arg_count - function->arity;
+    for (int i = 0; i < function->local_count; i++) *sp++ = NULL_VAL;
+
+    vm->frame_count++;
+    jit_safepoint(vm, sp);
+    VMValue result = ((JitFunction)function->jit->code)(vm, sp, slots);
+    vm->frame_count--;
+
+    slots[0] = result;
+    return slots + 1;
+}
+
+// ============ 템플릿 ============
+
+// VM 스택 push rax / top 읽기
+static void emit_push_rax(X64Assembler* as) {
+    x64_store(as, RBX, 0, RAX);
+    x64_alu_imm(as, ALU_ADD, RBX, 8);
+}
+
+// reg가 숫자가 아니면 점프 (rdx = QNAN이어야 함, rsi 사용)
+static int emit_jump_if_not_number(X64Assembler* as, int reg) {
+    x64_mov(as, RSI, reg);
+    x64_alu(as, OPC_AND, RSI, RDX);
+    x64_alu(as, OPC_CMP, RSI, RDX);
+    return x64_jcc(as, CC_E);
+}
+
+// 느린 경로: rbx = helper(rbx, opcode)
+static void emit_stack_helper(X64Assembler* as, void* helper, int opcode) {
+    x64_mov(as, RDI, RBX);
+    x64_mov_imm(as, RSI, (uint64_t)opcode);
+    x64_call(as, helper);
+    x64_mov(as, RBX, RAX);
+}
+
+// 전역 슬롯 값 rax가 미정의면 에러
+static void emit_check_defined(X64Assembler* as, int slot) {
+    x64_mov_imm(as, RCX, UNDEFINED_VAL);
+    x64_alu(as, OPC_CMP, RAX, RCX);
+    int defined = x64_jcc(as, CC_NE);
+    x64_mov(as, RDI, R12);
+    x64_mov_imm(as, RSI, (uint64_t)slot);
+    x64_call(as, (void*)jit_undefined_global);
+    x64_patch_here(as, defined);
+}
+
+// 스택 위 두 숫자를 xmm0, xmm1로 (숫자가 아니면 slow 점프 두 개를 slow_jumps에)
+static void emit_load_number_pair(X64Assembler* as, int slow_jumps[2]) {
+    x64_load(as, RAX, RBX, -16);
+    x64_load(as, RCX, RBX, -8);
+    x64_mov_imm(as, RDX, QNAN);
+    slow_jumps[0] = emit_jump_if_not_number(as, RAX);
+    slow_jumps[1] = emit_jump_if_not_number(as, RCX);
+    x64_movq_to_xmm(as, 0, RAX);
+    x64_movq_to_xmm(as, 1, RCX);
+}
+
+// ADD/SUBTRACT/MULTIPLY/DIVIDE: 숫자면 SSE2, 아니면 vm_binary_op
+static void emit_arithmetic(X64Assembler* as, OpCode opcode) {
+    int slow[3] = { -1, -1, -1 };
+    emit_load_number_pair(as, slow);
+
+    uint8_t sse = opcode == OP_ADD ? SSE_ADDSD : opcode == OP_SUBTRACT ? SSE_SUBSD :
+                  opcode == OP_MULTIPLY ? SSE_MULSD : SSE_DIVSD;
+    if (opcode == OP_DIVIDE) {
+        // 0으로 나누기는 느린 경로에서 에러
+        x64_sse(as, 0x66, SSE_XORPD, 2, 2);
+        x64_sse(as, 0x66, SSE_UCOMISD, 1, 2);
+        slow[2] = x64_jcc(as, CC_E);
+    }
+    x64_sse(as, 0xF2, sse, 0, 1);
+    x64_movq_from_xmm(as, RAX, 0);
+    x64_store(as, RBX, -16, RAX);
+    x64_alu_imm(as, ALU_SUB, RBX, 8);
+    int done = x64_jmp(as);
+
+    for (int i = 0; i < 3; i++) {
+        if (slow[i] >= 0) x64_patch_here(as, slow[i]);
+    }
+    emit_stack_helper(as, (void*)jit_binary, opcode);
+    x64_patch_here(as, done);
+}
+
+// LESS/LESS_EQUAL/GREATER/GREATER_EQUAL의 ucomisd 순서와 조건 (NaN이면 거짓)
+static int comparison_condition(OpCode opcode, int* swap) {
+    *swap = opcode == OP_LESS || opcode == OP_LESS_EQUAL;
+    return (opcode == OP_LESS_EQUAL || opcode == OP_GREATER_EQUAL) ? CC_AE : CC_A;
+}
+
+static void emit_comparison(X64Assembler* as, OpCode opcode) {
+    int slow[2];
+    int swap;
+    int cc = comparison_condition(opcode, &swap);
+    emit_load_number_pair(as, slow);
+
+    // a < b 는 b > a 로 비교 (ucomisd xmm1, xmm0)
+    x64_sse(as, 0x66, SSE_UCOMISD, swap ? 1 : 0, swap ? 0 : 1);
+    x64_byte(as, 0x0F);
+    x64_byte(as, 0x90 | cc);       // setcc al
+    x64_byte(as, 0xC0);
+    x64_byte(as, 0x0F);
+    x64_byte(as, 0xB6);            // movzx eax, al
+    x64_byte(as, 0xC0);
+    x64_mov_imm(as, RCX, FALSE_VAL);
+    x64_alu(as, OPC_ADD, RAX, RCX);   // FALSE_VAL + 1 == TRUE_VAL
+    x64_store(as, RBX, -16, RAX);
+    x64_alu_imm(as, ALU_SUB, RBX, 8);
+    int done = x64_jmp(as);
+
+    x64_patch_here(as, slow[0]);
+    x64_patch_here(as, slow[1]);
+    emit_stack_helper(as, (void*)jit_binary, opcode);
+    x64_patch_here(as, done);
+}
+
+// rax가 거짓(false, 0, -0)이면 점프할 위치 두 개를 jumps에
+static void emit_jump_if_falsey(X64Assembler* as, int jumps[2]) {
+    x64_mov_imm(as, RCX, FALSE_VAL);
+    x64_alu(as, OPC_CMP, RAX, RCX);
+    jumps[0] = x64_jcc(as, CC_E);
+    x64_mov(as, RCX, RAX);
+    x64_byte(as, 0x48);            // shl rcx, 1 (부호 비트 제거, 0이면 ±0.0)
+    x64_byte(as, 0xD1);
+    x64_byte(as, 0xE1);
+    jumps[1] = x64_jcc(as, CC_E);
+}
+
+// slot += amount (숫자면 SSE2, 아니면 jit_increment), base는 r13(전역) 또는 r14(지역)
+static void emit_increment(X64Assembler* as, int base, int slot, int amount) {
+    x64_load(as, RAX, base, slot * 8);
+    if (base == R13) emit_check_defined(as, slot);
+    x64_mov_imm(as, RDX, QNAN);
+    int slow = emit_jump_if_not_number(as, RAX);
+
+    VMValue increment = NUMBER_VAL((double)amount);
+    x64_movq_to_xmm(as, 0, RAX);
+    x64_mov_imm(as, RCX, increment);
+    x64_movq_to_xmm(as, 1, RCX);
+    x64_sse(as, 0xF2, SSE_ADDSD, 0, 1);
+    x64_movq_from_xmm(as, RAX, 0);
+    x64_store(as, base, slot * 8, RAX);
+    int done = x64_jmp(as);
+
+    x64_patch_here(as, slow);
+    x64_mov(as, RDI, base);
+    x64_alu_imm(as, ALU_ADD, RDI, slot * 8);
+    x64_mov_imm(as, RSI, (uint64_t)(int64_t)amount);
+    x64_call(as, (void*)jit_increment);
+    x64_patch_here(as, done);
+}
+
+// 함수 프롤로그/에필로그 (callee-saved 보존, 호출 시 rsp 16바이트 정렬 유지)
+static void emit_prologue(X64Assembler* as) {
+    x64_byte(as, 0x55);                // push rbp
+    x64_mov(as, RBP, RSP);
+    x64_byte(as, 0x53);                // push rbx
+    x64_byte(as, 0x41); x64_byte(as, 0x54);   // push r12
+    x64_byte(as, 0x41); x64_byte(as, 0x55);   // push r13
+    x64_byte(as, 0x41); x64_byte(as, 0x56);   // push r14
+    x64_mov(as, R12, RDI);
+    x64_mov(as, RBX, RSI);
+    x64_mov(as, R14, RDX);
+    x64_load(as, R13, R12, (int32_t)offsetof(VM, globals));
+}
+
+static void emit_epilogue(X64Assembler* as) {
+    x64_byte(as, 0x41); x64_byte(as, 0x5E);   // pop r14
+    x64_byte(as, 0x41); x64_byte(as, 0x5D);   // pop r13
+    x64_byte(as, 0x41); x64_byte(as, 0x5C);   // pop r12
+    x64_byte(as, 0x5B);                // pop rbx
+    x64_byte(as, 0x5D);                // pop rbp
+    x64_byte(as, 0xC3);                // ret
+}
+
+// 나중에 채울 점프 (기계어 rel32 위치 → 바이트코드 목적지)
+typedef struct {
+    int position;
+    int target;
+} JitFixup;
+
+// 기계어 템플릿이 있는 opcode인지
+static int opcode_supported(OpCode opcode) {
+    return opcode != OP_BUILD_DICT && opcode != OP_STORE_INDEX && opcode != OP_THROW;
+}
+
+// 청크 하나 컴파일 (함수 상수는 호출한 쪽이 먼저 컴파일)
+static JitCode* compile_chunk(BytecodeChunk* chunk) {
+    // try/catch가 있는 청크는 vm_run으로 (프로그램 전체가 인터프리트됨)
+    if (chunk->handler_count > 0) return NULL;
+
+    for (int offset = 0; offset < chunk->count;
+         offset += bytecode_instruction_length(chunk, offset)) {
+        if (!opcode_supported((OpCode)chunk->code[offset])) return NULL;
+    }
+
+    X64Assembler as = { NULL, 0, 0 };
+    int* labels = (int*)malloc(sizeof(int) * (chunk->count + 1));
+    JitFixup* fixups = (JitFixup*)malloc(sizeof(JitFixup) * (chunk->count + 1));
+    int fixup_count = 0;
+
+    emit_prologue(&as);
+
+    for (int offset = 0; offset < chunk->count;
+         offset += bytecode_instruction_length(chunk, offset)) {
+        OpCode opcode = bytecode_generic_opcode((OpCode)chunk->code[offset]);
+        int64_t operand = bytecode_read_operand(chunk, offset);
+        uint8_t first = offset + 1 < chunk->count ? chunk->code[offset + 1] : 0;
+        uint8_t second = offset + 2 < chunk->count ? chunk->code[offset + 2] : 0;
+        labels[offset] = as.count;
+
+        switch (opcode) {
+            case OP_LOAD_CONST:
+            case OP_LOAD_CONST_LONG:
+                // 상수는 바뀌지 않으므로 NaN-boxed 값을 즉시값으로 박아 넣음
+                x64_mov_imm(&as, RAX, vm_value_from_heap(chunk->constants[operand]));
+                emit_push_rax(&as);
+                break;
+
+            case OP_LOAD_TRUE:
+            case OP_LOAD_FALSE:
+            case OP_LOAD_NULL:
+                x64_mov_imm(&as, RAX, opcode == OP_LOAD_TRUE ? TRUE_VAL :
+                                       opcode == OP_LOAD_FALSE ? FALSE_VAL : NULL_VAL);
+                emit_push_rax(&as);
+                break;
+
+            case OP_LOAD_GLOBAL:
+            case OP_LOAD_GLOBAL_LONG:
+                x64_load(&as, RAX, R13, (int32_t)(operand * 8));
+                emit_check_defined(&as, (int)operand);
+                emit_push_rax(&as);
+                break;
+
+            case OP_STORE_GLOBAL:
+            case OP_STORE_GLOBAL_LONG:
+                x64_load(&as, RAX, RBX, -8);
+                x64_store(&as, R13, (int32_t)(operand * 8), RAX);
+                break;
+
+            case OP_LOAD_LOCAL:
+                x64_load(&as, RAX, R14, (int32_t)(operand * 8));
+                emit_push_rax(&as);
+                break;
+
+            case OP_STORE_LOCAL:
+                x64_load(&as, RAX, RBX, -8);
+                x64_store(&as, R14, (int32_t)(operand * 8), RAX);
+                break;
+
+            case OP_ADD:
+            case OP_SUBTRACT:
+            case OP_MULTIPLY:
+            case OP_DIVIDE:
+                emit_arithmetic(&as, opcode);
+                break;
+
+            case OP_ADD_CONST:
+                x64_mov_imm(&as, RAX, vm_value_from_heap(chunk->constants[operand]));
+                emit_push_rax(&as);
+                emit_arithmetic(&as, OP_ADD);
+                break;
+
+            case OP_MODULO:
+            case OP_FLOOR_DIV:
+            case OP_EQUAL:
+            case OP_NOT_EQUAL:
+                emit_stack_helper(&as, (void*)jit_binary, opcode);
+                break;
+
+            case OP_LESS:
+            case OP_LESS_EQUAL:
+            case OP_GREATER:
+            case OP_GREATER_EQUAL:
+                emit_comparison(&as, opcode);
+                break;
+
+            case OP_NEGATE: {
+                x64_load(&as, RAX, RBX, -8);
+                x64_mov_imm(&as, RDX, QNAN);
+                int slow = emit_jump_if_not_number(&as, RAX);
+                x64_mov_imm(&as, RCX, SIGN_BIT);
+                x64_alu(&as, OPC_XOR, RAX, RCX);      // xor rax, rcx (부호 반전)
+                x64_store(&as, RBX, -8, RAX);
+                int done = x64_jmp(&as);
+                x64_patch_here(&as, slow);
+                emit_stack_helper(&as, (void*)jit_unary, opcode);
+                x64_patch_here(&as, done);
+                break;
+            }
+
+            case OP_NOT:
+                emit_stack_helper(&as, (void*)jit_unary, opcode);
+                break;
+
+            case OP_BUILD_ARRAY:
+            case OP_BUILD_ARRAY_LONG:
+                emit_stack_helper(&as, (void*)jit_build_array, (int)operand);
+                break;
+
+            case OP_INDEX:
+                x64_load(&as, RDI, RBX, -16);
+                x64_load(&as, RSI, RBX, -8);
+                x64_call(&as, (void*)vm_index_value);
+                x64_alu_imm(&as, ALU_SUB, RBX, 8);
+                x64_store(&as, RBX, -8, RAX);
+                break;
+
+            case OP_ARRAY_LENGTH:
+                x64_load(&as, RDI, RBX, -8);
+                x64_call(&as, (void*)vm_length);
+                x64_byte(&as, 0xF2);               // cvtsi2sd xmm0, eax
+                x64_byte(&as, 0x0F);
+                x64_byte(&as, 0x2A);
+                x64_byte(&as, 0xC0);
+                x64_movq_from_xmm(&as, RAX, 0);
+                x64_store(&as, RBX, -8, RAX);
+                break;
+
+            case OP_JUMP:
+                fixups[fixup_count].position = x64_jmp(&as);
+                fixups[fixup_count++].target = bytecode_jump_target(chunk, offset);
+                break;
+
+            case OP_JUMP_IF_FALSE:
+            case OP_JUMP_IF_TRUE: {
+                int falsey[2];
+                x64_alu_imm(&as, ALU_SUB, RBX, 8);
+                x64_load(&as, RAX, RBX, 0);
+                emit_jump_if_falsey(&as, falsey);
+                if (opcode == OP_JUMP_IF_FALSE) {
+                    for (int i = 0; i < 2; i++) {
+                        fixups[fixup_count].position = falsey[i];
+                        fixups[fixup_count++].target = bytecode_jump_target(chunk, offset);
+                    }
+                } else {
+                    fixups[fixup_count].position = x64_jmp(&as);
+                    fixups[fixup_count++].target = bytecode_jump_target(chunk, offset);
+                    x64_patch_here(&as, falsey[0]);
+                    x64_patch_here(&as, falsey[1]);
+                }
+                break;
+            }
+
+            case OP_JUMP_IF_NOT_LESS: {
+                int slow[2];
+                emit_load_number_pair(&as, slow);
+                x64_alu_imm(&as, ALU_SUB, RBX, 16);
+                x64_sse(&as, 0x66, SSE_UCOMISD, 1, 0);
+                // !(a < b) == !(b > a): 같거나 작거나 NaN이면 점프
+                fixups[fixup_count].position = x64_jcc(&as, CC_BE);
+                fixups[fixup_count++].target = bytecode_jump_target(chunk, offset);
+                int done = x64_jmp(&as);
+                // 숫자가 아니면 LESS의 타입 에러로 종료
+                x64_patch_here(&as, slow[0]);
+                x64_patch_here(&as, slow[1]);
+                emit_stack_helper(&as, (void*)jit_binary, OP_LESS);
+                x64_patch_here(&as, done);
+                break;
+            }
+
+            case OP_LOOP: {
+                // 역방향 점프마다 남은 횟수를 줄이고, 0이 되면 jit_run으로 빠져나감
+                x64_byte(&as, 0x49);               // dec qword [r12 + budget]
+                x64_byte(&as, 0xFF);
+                x64_modrm_mem(&as, 1, R12, (int32_t)offsetof(VM, jit_loop_budget));
+                int exhausted = x64_jcc(&as, CC_E);
+                // gc_allocated < gc_threshold면 바로 점프, 아니면 안전 지점을 거쳐 점프
+                x64_mov_imm(&as, RCX, (uint64_t)&gc_allocated);
+                x64_load(&as, RAX, RCX, 0);
+                x64_mov_imm(&as, RCX, (uint64_t)&gc_threshold);
+                x64_load(&as, RCX, RCX, 0);
+                x64_alu(&as, OPC_CMP, RAX, RCX);
+                fixups[fixup_count].position = x64_jcc(&as, CC_B);
+                fixups[fixup_count++].target = bytecode_jump_target(chunk, offset);
+                x64_mov(&as, RDI, R12);
+                x64_mov(&as, RSI, RBX);
+                x64_call(&as, (void*)jit_safepoint);
+                fixups[fixup_count].position = x64_jmp(&as);
+                fixups[fixup_count++].target = bytecode_jump_target(chunk, offset);
+                x64_patch_here(&as, exhausted);
+                x64_mov(&as, RDI, R12);
+                x64_call(&as, (void*)jit_loop_limit);
+                break;
+            }
+
+            case OP_CALL:
+                x64_mov(&as, RDI, R12);
+                x64_mov(&as, RSI, RBX);
+                x64_mov_imm(&as, RDX, (uint64_t)operand);
+                x64_call(&as, (void*)jit_call);
+                x64_mov(&as, RBX, RAX);
+                break;
+
+            case OP_RETURN:
+                x64_load(&as, RAX, RBX, -8);
+                emit_epilogue(&as);
+                break;
+
+            case OP_CALL_BUILTIN:
+                x64_mov(&as, RDI, RBX);
+                x64_mov_imm(&as, RSI, first);
+                x64_mov_imm(&as, RDX, second);
+                x64_call(&as, (void*)jit_call_builtin);
+                x64_mov(&as, RBX, RAX);
+                break;
+
+            case OP_PRINT:
+                x64_alu_imm(&as, ALU_SUB, RBX, 8);
+                x64_load(&as, RDI, RBX, 0);
+                x64_call(&as, (void*)jit_print);
+                break;
+
+            case OP_POP:
+                x64_alu_imm(&as, ALU_SUB, RBX, 8);
+                break;
+
+            case OP_DUP:
+                x64_load(&as, RAX, RBX, -8);
+                emit_push_rax(&as);
+                break;
+
+            case OP_INCR_LOCAL:
+                emit_increment(&as, R14, first, (int8_t)second);
+                break;
+
+            case OP_INCR_GLOBAL:
+                emit_increment(&as, R13, first, (int8_t)second);
+                break;
+
+            case OP_INDEX_LOCALS:
+            case OP_INDEX_GLOBALS: {
+                int base = opcode == OP_INDEX_LOCALS ? R14 : R13;
+                if (base == R13) {
+                    x64_load(&as, RAX, R13, first * 8);
+                    emit_check_defined(&as, first);
+                    x64_load(&as, RAX, R13, second * 8);
+                    emit_check_defined(&as, second);
+                }
+                x64_load(&as, RDI, base, first * 8);
+                x64_load(&as, RSI, base, second * 8);
+                x64_call(&as, (void*)vm_index_value);
+                emit_push_rax(&as);
+                break;
+            }
+
+            case OP_HALT:
+                emit_epilogue(&as);
+                break;
+
+            default:
+                break;
+        }
+    }
+    // 끝까지 실행되면 null 반환 (끝으로 가는 점프도 여기로)
+    labels[chunk->count] = as.count;
+    x64_mov_imm(&as, RAX, NULL_VAL);
+    emit_epilogue(&as);
+
+    for (int i = 0; i < fixup_count; i++) {
+        x64_patch_rel32(&as, fixups[i].position, labels[fixups[i].target]);
+    }
+    free(labels);
+    free(fixups);
+
+    JitCode* code = NULL;
+    size_t size;
+    uint8_t* memory = x64_finalize(&as, &size);
+    if (memory) {
+        code = (JitCode*)malloc(sizeof(JitCode));
+        code->code = memory;
+        code->size = size;
+    }
+    return code;
+}
+
+// 청크와 함수 청크들 컴파일
+int jit_compile(BytecodeChunk* chunk) {
+    if (chunk->jit) return 1;
+
+    for (int i = 0; i < chunk->constant_count; i++) {
+        Value* constant = chunk->constants[i];
+        if (constant->type == VAL_FUNCTION && constant->data.function->chunk &&
+            !jit_compile(constant->data.function->chunk)) {
+            return 0;
+        }
+    }
+
+    chunk->jit = compile_chunk(chunk);
+    return chunk->jit != NULL;
+}
+
+// 컴파일된 스크립트 실행
+int jit_run(VM* vm, BytecodeChunk* chunk) {
+    if (!bytecode_verify(chunk)) {
+        fprintf(stderr, "Invalid bytecode chunk, refusing to run\n");
+        return 0;
+    }
+
+    if (!chunk->jit || chunk->max_stack > JIT_STACK_MAX) {
+        return vm_run(vm, chunk);
+    }
+
+    vm->chunk = chunk;
+    if (chunk->global_count > vm->global_count) {
+        vm->globals = (VMValue*)realloc(vm->globals, sizeof(VMValue) * chunk->global_count);
+        for (int i = vm->global_count; i < chunk->global_count; i++) {
+            vm->globals[i] = UNDEFINED_VAL;
+        }
+        vm->global_count = chunk->global_count;
+    }
+
+    // OP_LOOP가 (max + 1)번째에 0이 되도록 (0이면 사실상 무제한)
+    vm->jit_loop_budget = vm->max_loop_iterations > 0 ? vm->max_loop_iterations + 1 : LONG_MAX;
+    vm->frame_count = 1;
+    vm->stack_top = vm->stack;
+    vm_reserve_stack(vm, JIT_STACK_MAX);
+
+    if (setjmp(jit_exit) == 0) {
+        ((JitFunction)chunk->jit->code)(vm, vm->stack, vm->stack);
+    }
+    return 1;
+}
+
+void jit_code_free(JitCode* code) {
+    if (!code) return;
+    x64_free_code(code->code, code->size);
+    free(code);
+}
+
+#else
+
+// x86-64가 아니면 JIT 없음 (항상 vm_run으로)
+int jit_compile(BytecodeChunk* chunk) {
+    (void)chunk;
+    return 0;
+}
+
+int jit_run(VM* vm, BytecodeChunk* chunk) {
+    return vm_run(vm, chunk);
+}
+
+void jit_code_free(JitCode* code) {
+    (void)code;
+}
+
+#endif
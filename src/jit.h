@@ -0,0 +1,33 @@
+#ifndef JIT_H
+#define JIT_H
+
+#include <stddef.h>
+#include "bytecode.h"
+#include "vm.h"
+
+// 베이스라인 템플릿 JIT (x86-64 전용)
+//
+// BytecodeChunk의 명령어마다 정해진 기계어 템플릿을 이어 붙여 함수 하나를 만든다.
+// 숫자 연산/비교/점프/변수 접근은 기계어로 바로 처리하고, 문자열·배열·에러 같은
+// 나머지 경우는 vm.c의 런타임 헬퍼(vm_binary_op, vm_index_value 등)를 직접 호출한다.
+// 명령어 디스패치가 없어지고 점프는 기계어 점프가 된다.
+//
+// 생성된 함수의 레지스터 규약 (System V):
+//   rbx = VM 스택 top 포인터, r12 = VM*, r13 = 전역 슬롯 배열, r14 = 프레임 슬롯 (LOAD_LOCAL 기준)
+
+// 청크 하나의 기계어 (mmap한 실행 메모리)
+typedef struct JitCode {
+    uint8_t* code;
+    size_t size;
+} JitCode;
+
+// 청크와 함수 청크들을 컴파일 (x86-64가 아니거나 지원하지 않는 opcode가 있으면 0)
+int jit_compile(BytecodeChunk* chunk);
+
+// 컴파일된 스크립트 실행 (vm_run과 같은 의미, 검증에 실패해서 실행하지 않았으면 0)
+int jit_run(VM* vm, BytecodeChunk* chunk);
+
+// 기계어 해제 (bytecode_chunk_free가 호출)
+void jit_code_free(JitCode* code);
+
+#endif
@@ -1,4 +1,7 @@
 #include "lexer.h"
+#include "intern.h"
+
+static Token* token_make(Lexer* lexer, TokenType type, char* symbol, int line, int column);
 
 // 렉서 생성
 Lexer* lexer_create(char* source) {
@@ -8,11 +11,13 @@ Lexer* lexer_create(char* source) {
     lexer->line = 1;
     lexer->column = 1;
     lexer->current_char = source[0];
+    lexer->arena = arena_create();
     return lexer;
 }
 
 // 렉서 메모리 해제
 void lexer_free(Lexer* lexer) {
+    arena_free(lexer->arena);
     free(lexer);
 }
 
@@ -63,14 +68,9 @@ Token* lexer_read_number(Lexer* lexer) {
         lexer_advance(lexer);
     }
     
-    int length = lexer->position - start_pos;
-    char* value = (char*)malloc(length + 1);
-    strncpy(value, &lexer->source[start_pos], length);
-    value[length] = '\0';
-    
-    Token* token = token_create(TOKEN_NUMBER, value, lexer->line, start_column);
-    free(value);
-    return token;
+    // 소스 조각을 그대로 심볼로 (복사본을 따로 만들지 않음)
+    char* value = symbol_intern(&lexer->source[start_pos], lexer->position - start_pos);
+    return token_make(lexer, TOKEN_NUMBER, value, lexer->line, start_column);
 }
 
 // 문자열 읽기
@@ -81,13 +81,13 @@ Token* lexer_read_string(Lexer* lexer) {
     // 동적 버퍼로 문자열 구성 (이스케이프 처리 위해)
     int capacity = 64;
     int length = 0;
-    char* value = (char*)malloc(capacity);
+    char* value = (char*)arena_alloc(lexer->arena, capacity);
     
     while (lexer->current_char != '"' && lexer->current_char != '\0') {
         // 버퍼 확장 필요시
         if (length >= capacity - 1) {
+            value = (char*)arena_grow(lexer->arena, value, capacity, capacity * 2);
             capacity *= 2;
-            value = (char*)realloc(value, capacity);
         }
         
         // 이스케이프 시퀀스 처리
@@ -120,9 +120,8 @@ Token* lexer_read_string(Lexer* lexer) {
         lexer_advance(lexer); // 닫는 따옴표 건너뛰기
     }
     
-    Token* token = token_create(TOKEN_STRING, value, lexer->line, start_column);
-    free(value);
-    return token;
+    // 이스케이프를 푼 버퍼는 심볼로 복사되고 아레나에 남음
+    return token_create(lexer, TOKEN_STRING, value, lexer->line, start_column);
 }
 
 // 식별자 또는 키워드 읽기
@@ -134,10 +133,7 @@ Token* lexer_read_identifier(Lexer* lexer) {
         lexer_advance(lexer);
     }
     
-    int length = lexer->position - start_pos;
-    char* value = (char*)malloc(length + 1);
-    strncpy(value, &lexer->source[start_pos], length);
-    value[length] = '\0';
+    char* value = symbol_intern(&lexer->source[start_pos], lexer->position - start_pos);
     
     // 키워드 확인
     TokenType type = TOKEN_IDENTIFIER;
@@ -173,9 +169,7 @@ Token* lexer_read_identifier(Lexer* lexer) {
     else if (strcmp(value, "true") == 0) type = TOKEN_TRUE;
     else if (strcmp(value, "false") == 0) type = TOKEN_FALSE;
     
-    Token* token = token_create(type, value, lexer->line, start_column);
-    free(value);
-    return token;
+    return token_make(lexer, type, value, lexer->line, start_column);
 }
 
 // 다음 토큰 가져오기
@@ -192,7 +186,7 @@ Token* lexer_next_token(Lexer* lexer) {
         }
         
         if (lexer->current_char == '\n') {
-            Token* token = token_create(TOKEN_NEWLINE, "\n", lexer->line, lexer->column);
+            Token* token = token_create(lexer, TOKEN_NEWLINE, "\n", lexer->line, lexer->column);
             lexer_advance(lexer);
             return token;
         }
@@ -214,80 +208,81 @@ Token* lexer_next_token(Lexer* lexer) {
         lexer_advance(lexer);
         
         switch (ch) {
-            case '+': return token_create(TOKEN_PLUS, "+", lexer->line, column);
+            case '+': return token_create(lexer, TOKEN_PLUS, "+", lexer->line, column);
             case '-':
                 if (lexer->current_char == '>') {
                     lexer_advance(lexer);
-                    return token_create(TOKEN_ARROW, "->", lexer->line, column);
+                    return token_create(lexer, TOKEN_ARROW, "->", lexer->line, column);
                 }
-                return token_create(TOKEN_MINUS, "-", lexer->line, column);
-            case '*': return token_create(TOKEN_MULTIPLY, "*", lexer->line, column);
+                return token_create(lexer, TOKEN_MINUS, "-", lexer->line, column);
+            case '*': return token_create(lexer, TOKEN_MULTIPLY, "*", lexer->line, column);
             case '/':
                 if (lexer->current_char == '/') {
                     // 몫 연산자 //
                     lexer_advance(lexer);  // 두 번째 / 건너뛰기
-                    return token_create(TOKEN_FLOOR_DIV, "//", lexer->line, column);
+                    return token_create(lexer, TOKEN_FLOOR_DIV, "//", lexer->line, column);
                 }
-                return token_create(TOKEN_DIVIDE, "/", lexer->line, column);
-            case '%': return token_create(TOKEN_MODULO, "%", lexer->line, column);
-            case '@': return token_create(TOKEN_AT, "@", lexer->line, column);
-            case '(': return token_create(TOKEN_LPAREN, "(", lexer->line, column);
-            case ')': return token_create(TOKEN_RPAREN, ")", lexer->line, column);
-            case '{': return token_create(TOKEN_LBRACE, "{", lexer->line, column);
-            case '}': return token_create(TOKEN_RBRACE, "}", lexer->line, column);
-            case '[': return token_create(TOKEN_LBRACKET, "[", lexer->line, column);
-            case ']': return token_create(TOKEN_RBRACKET, "]", lexer->line, column);
-            case ',': return token_create(TOKEN_COMMA, ",", lexer->line, column);
-            case '.': return token_create(TOKEN_DOT, ".", lexer->line, column);
-            case ':': return token_create(TOKEN_COLON, ":", lexer->line, column);
+                return token_create(lexer, TOKEN_DIVIDE, "/", lexer->line, column);
+            case '%': return token_create(lexer, TOKEN_MODULO, "%", lexer->line, column);
+            case '@': return token_create(lexer, TOKEN_AT, "@", lexer->line, column);
+            case '(': return token_create(lexer, TOKEN_LPAREN, "(", lexer->line, column);
+            case ')': return token_create(lexer, TOKEN_RPAREN, ")", lexer->line, column);
+            case '{': return token_create(lexer, TOKEN_LBRACE, "{", lexer->line, column);
+            case '}': return token_create(lexer, TOKEN_RBRACE, "}", lexer->line, column);
+            case '[': return token_create(lexer, TOKEN_LBRACKET, "[", lexer->line, column);
+            case ']': return token_create(lexer, TOKEN_RBRACKET, "]", lexer->line, column);
+            case ',': return token_create(lexer, TOKEN_COMMA, ",", lexer->line, column);
+            case '.': return token_create(lexer, TOKEN_DOT, ".", lexer->line, column);
+            case ':': return token_create(lexer, TOKEN_COLON, ":", lexer->line, column);
             case '=':
                 if (lexer->current_char == '=') {
                     lexer_advance(lexer);
-                    return token_create(TOKEN_EQUAL, "==", lexer->line, column);
+                    return token_create(lexer, TOKEN_EQUAL, "==", lexer->line, column);
                 }
-                return token_create(TOKEN_ASSIGN, "=", lexer->line, column);
+                return token_create(lexer, TOKEN_ASSIGN, "=", lexer->line, column);
             case '!':
                 if (lexer->current_char == '=') {
                     lexer_advance(lexer);
-                    return token_create(TOKEN_NOT_EQUAL, "!=", lexer->line, column);
+                    return token_create(lexer, TOKEN_NOT_EQUAL, "!=", lexer->line, column);
                 }
                 break;
             case '<':
                 if (lexer->current_char == '=') {
                     lexer_advance(lexer);
-                    return token_create(TOKEN_LESS_EQUAL, "<=", lexer->line, column);
+                    return token_create(lexer, TOKEN_LESS_EQUAL, "<=", lexer->line, column);
                 }
-                return token_create(TOKEN_LESS, "<", lexer->line, column);
+                return token_create(lexer, TOKEN_LESS, "<", lexer->line, column);
             case '>':
                 if (lexer->current_char == '=') {
                     lexer_advance(lexer);
-                    return token_create(TOKEN_GREATER_EQUAL, ">=", lexer->line, column);
+                    return token_create(lexer, TOKEN_GREATER_EQUAL, ">=", lexer->line, column);
                 }
-                return token_create(TOKEN_GREATER, ">", lexer->line, column);
+                return token_create(lexer, TOKEN_GREATER, ">", lexer->line, column);
         }
         
-        return token_create(TOKEN_ERROR, "Unknown character", lexer->line, column);
+        return token_create(lexer, TOKEN_ERROR, "Unknown character", lexer->line, column);
     }
     
-    return token_create(TOKEN_EOF, "", lexer->line, lexer->column);
+    return token_create(lexer, TOKEN_EOF, "", lexer->line, lexer->column);
 }
 
-// 토큰 생성
-Token* token_create(TokenType type, char* value, int line, int column) {
-    Token* token = (Token*)malloc(sizeof(Token));
+// 토큰 생성 (value는 심볼 테이블에 넣고, 토큰은 그 심볼을 가리킴)
+Token* token_create(Lexer* lexer, TokenType type, char* value, int line, int column) {
+    return token_make(lexer, type, symbol_from(value), line, column);
+}
+
+static Token* token_make(Lexer* lexer, TokenType type, char* symbol, int line, int column) {
+    Token* token = (Token*)arena_alloc(lexer->arena, sizeof(Token));
     token->type = type;
-    token->value = strdup(value);
+    token->value = symbol;
     token->line = line;
     token->column = column;
     return token;
 }
 
-// 토큰 메모리 해제
+// 토큰 메모리 해제 (토큰은 렉서의 아레나에, value는 심볼이므로 할 일 없음)
 void token_free(Token* token) {
-    if (token) {
-        free(token->value);
-        free(token);
-    }
+    (void)token;
 }
 
 // 토큰 타입을 문자열로 변환
@@ -5,6 +5,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include "arena.h"
 
 // 토큰 타입 정의
 typedef enum {
@@ -74,7 +75,7 @@ typedef enum {
 // 토큰 구조체
 typedef struct {
     TokenType type;
-    char* value;
+    char* value;  // 심볼 (intern.h, 토큰을 해제해도 남음)
     int line;
     int column;
 } Token;
@@ -86,6 +87,7 @@ typedef struct {
     int line;
     int column;
     char current_char;
+    Arena* arena;  // 토큰과 문자열 버퍼 (lexer_free가 한 번에 해제)
 } Lexer;
 
 // 함수 선언
@@ -98,8 +100,8 @@ Token* lexer_next_token(Lexer* lexer);
 Token* lexer_read_number(Lexer* lexer);
 Token* lexer_read_string(Lexer* lexer);
 Token* lexer_read_identifier(Lexer* lexer);
-Token* token_create(TokenType type, char* value, int line, int column);
-void token_free(Token* token);
+Token* token_create(Lexer* lexer, TokenType type, char* value, int line, int column);
+void token_free(Token* token);  // 아레나가 가지므로 아무것도 하지 않음
 const char* token_type_to_string(TokenType type);
 
 #endif
@@ -6,7 +6,12 @@
 #include "interpreter.h"
 #include "compiler.h"
 #include "vm.h"
+#include "regcompiler.h"
+#include "regvm.h"
+#include "jit.h"
 #include "bytecode.h"
+#include "cache.h"
+#include "gc.h"
 
 // 파일 읽기
 char* read_file(const char* filename) {
@@ -54,8 +59,7 @@ void repl() {
         
         // 예외 처리
         if (interp->has_exception && interp->current_exception) {
-            value_print(interp->current_exception);
-            printf("\n");
+            exception_report_uncaught(interp->current_exception);
             interp->has_exception = 0;
             value_free(interp->current_exception);
             interp->current_exception = NULL;
@@ -65,7 +69,7 @@ void repl() {
         }
         
         value_free(result);
-        ast_free(ast);
+        interpreter_keep_program(interp, ast);  // 이 줄에서 정의한 함수가 다음 줄에서도 불릴 수 있음
         parser_free(parser);
         lexer_free(lexer);
     }
@@ -89,27 +93,69 @@ void run_file(const char* filename) {
     
     // 예외 처리
     if (interp->has_exception && interp->current_exception) {
-        value_print(interp->current_exception);
-        printf("\n");
+        exception_report_uncaught(interp->current_exception);
     }
     
     // 프로그램 정상 종료 - OS가 메모리 정리
     exit(0);
 }
 
+// VM 모드 실행 옵션
+typedef struct {
+    long max_loops;     // 역방향 점프 허용 횟수 (0이면 무제한)
+    int opt_level;      // 0: 최적화 없음, 1: 핍홀 최적화
+    int jit;            // 1이면 바이트코드를 기계어로 컴파일해서 실행
+    int trace;          // 0이면 vm_run의 트레이스 JIT를 끔
+    int cache;          // 0이면 .finec 바이트코드 캐시를 읽지도 쓰지도 않음
+} VMOptions;
+
 // 파일 실행 (VM 모드)
-void run_file_vm(const char* filename) {
+void run_file_vm(const char* filename, VMOptions* options) {
     char* source = read_file(filename);
     if (!source) {
         exit(1);
     }
     
-    Lexer* lexer = lexer_create(source);
-    Parser* parser = parser_create(lexer);
-    ASTNode* ast = parser_parse(parser);
+    // 소스가 바뀌지 않았으면 캐시된 바이트코드 사용 (렉싱/파싱/컴파일 생략)
+    char* cache_file = cache_path(filename);
+    CacheFile* cache = NULL;
+    BytecodeChunk* chunk = NULL;
+    if (options->cache) {
+        chunk = cache_load(cache_file, source, options->opt_level, &cache);
+    }
+    
+    Lexer* lexer = NULL;
+    Parser* parser = NULL;
+    ASTNode* ast = NULL;
     
-    // AST를 bytecode로 컴파일
-    BytecodeChunk* chunk = compile(ast);
+    if (!chunk) {
+        lexer = lexer_create(source);
+        parser = parser_create(lexer);
+        ast = parser_parse(parser);
+        
+        // AST를 bytecode로 컴파일
+        chunk = compile(ast);
+        
+        // VM이 지원하지 않는 구문이 있으면 인터프리터로 실행
+        if (!chunk) {
+            fprintf(stderr, "Falling back to interpreter mode\n");
+            ast_free(ast);
+            parser_free(parser);
+            lexer_free(lexer);
+            free(cache_file);
+            free(source);
+            run_file(filename);
+        }
+        
+        if (options->opt_level > 0) {
+            optimize_chunk(chunk);
+        }
+        
+        // 다음 실행을 위해 저장 (디렉터리에 쓸 수 없으면 조용히 넘어감)
+        if (options->cache) {
+            cache_save(cache_file, chunk, source, options->opt_level);
+        }
+    }
     
     printf("\n=== Bytecode Disassembly ===\n");
     bytecode_disassemble(chunk, filename);
@@ -117,16 +163,73 @@ void run_file_vm(const char* filename) {
     
     // VM 실행
     VM* vm = vm_create();
-    vm_run(vm, chunk);
+    vm->max_loop_iterations = options->max_loops;
+    vm->trace_enabled = options->trace;
+    int ran;
+    if (options->jit && jit_compile(chunk)) {
+        ran = jit_run(vm, chunk);
+    } else {
+        if (options->jit) {
+            fprintf(stderr, "JIT unavailable for this program, falling back to VM\n");
+        }
+        ran = vm_run(vm, chunk);
+    }
     
     vm_free(vm);
     bytecode_chunk_free(chunk);
+    cache_close(cache);
+    if (ast) {
+        ast_free(ast);
+        parser_free(parser);
+        lexer_free(lexer);
+    }
+    free(cache_file);
+    free(source);
+    
+    // 검증에 실패한 청크 (손상된 캐시 등)는 실행하지 않았으므로 실패로 종료
+    exit(ran ? 0 : 1);
+}
+
+// 파일 실행 (레지스터 VM 모드)
+void run_file_regvm(const char* filename, VMOptions* options) {
+    char* source = read_file(filename);
+    if (!source) {
+        exit(1);
+    }
+    
+    Lexer* lexer = lexer_create(source);
+    Parser* parser = parser_create(lexer);
+    ASTNode* ast = parser_parse(parser);
+    
+    // AST를 레지스터 코드로 컴파일
+    RegChunk* chunk = reg_compile(ast);
+    
+    // 레지스터 컴파일러가 지원하지 않는 구문이면 스택 VM으로 실행
+    if (!chunk) {
+        fprintf(stderr, "Falling back to stack VM mode\n");
+        ast_free(ast);
+        parser_free(parser);
+        lexer_free(lexer);
+        free(source);
+        run_file_vm(filename, options);
+    }
+    
+    printf("\n=== Register Code Disassembly ===\n");
+    reg_disassemble(chunk, filename);
+    printf("\n=== Execution ===\n");
+    
+    RegVM* vm = regvm_create();
+    vm->max_loop_iterations = options->max_loops;
+    int ran = regvm_run(vm, chunk);
+    
+    regvm_free(vm);
+    reg_chunk_free(chunk);
     ast_free(ast);
     parser_free(parser);
     lexer_free(lexer);
     free(source);
     
-    exit(0);
+    exit(ran ? 0 : 1);
 }
 
 // 사용법 출력
@@ -137,37 +240,93 @@ void print_usage(const char* program) {
     printf("  %s <file.fine>     Run a FineLang program (interpreter mode)\n", program);
     printf("  %s --vm <file.fine> Run a FineLang program (VM mode)\n", program);
     printf("  %s -v <file.fine>   Run a FineLang program (VM mode, short)\n", program);
+    printf("  %s --reg <file.fine> Run a FineLang program (register VM mode)\n", program);
+    printf("  %s --jit <file.fine> Run a FineLang program (VM mode, x86-64 JIT)\n", program);
     printf("  %s -h, --help      Show this help message\n", program);
+    printf("\nVM options:\n");
+    printf("  --max-loops <n>    Abort after n loop back-edges (0 = unlimited, default %ld)\n", 
+           VM_DEFAULT_MAX_LOOPS);
+    printf("  -O0, -O1           Bytecode optimization level (default -O1)\n");
+    printf("  --no-trace         Do not compile hot loops to machine code (tracing JIT)\n");
+    printf("  --no-cache         Do not read or write the <file>.finec bytecode cache\n");
+    printf("\nGC options:\n");
+    printf("  --gc-incremental   Collect incrementally in short pauses instead of stop-the-world\n");
+    printf("  --gc-pause <us>    Pause budget per incremental step in microseconds (default %d)\n",
+           GC_DEFAULT_PAUSE_US);
+    printf("  --gc-stats         Print GC cycle and pause statistics to stderr on exit\n");
     printf("\nExamples:\n");
     printf("  %s                 # Start REPL\n", program);
     printf("  %s hello.fine      # Run hello.fine (interpreter)\n", program);
     printf("  %s --vm test.fine  # Run test.fine (bytecode VM)\n", program);
     printf("  %s -v test.fine    # Run test.fine (bytecode VM)\n", program);
+    printf("  %s --reg test.fine # Run test.fine (register VM)\n", program);
+    printf("  %s --jit test.fine # Run test.fine (bytecode compiled to machine code)\n", program);
+}
+
+// --gc-stats: 종료할 때 (run_file*이 exit로 끝나므로 atexit으로) 출력
+static void print_gc_stats(void) {
+    gc_print_stats(stderr);
 }
 
 int main(int argc, char** argv) {
     if (argc == 1) {
         // REPL 모드
         repl();
-    } else if (argc == 2) {
-        if (strcmp(argv[1], "-h") == 0 || strcmp(argv[1], "--help") == 0) {
+        return 0;
+    }
+    
+    int use_vm = 0;
+    VMOptions options = { VM_DEFAULT_MAX_LOOPS, 1, 0, 1, 1 };
+    const char* filename = NULL;
+    
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
             print_usage(argv[0]);
-        } else {
-            // 파일 실행 (인터프리터 모드)
-            run_file(argv[1]);
-        }
-    } else if (argc == 3) {
-        if (strcmp(argv[1], "--vm") == 0 || strcmp(argv[1], "-v") == 0) {
-            // 파일 실행 (VM 모드)
-            run_file_vm(argv[2]);
+            return 0;
+        } else if (strcmp(argv[i], "--vm") == 0 || strcmp(argv[i], "-v") == 0) {
+            use_vm = 1;
+        } else if (strcmp(argv[i], "--reg") == 0 || strcmp(argv[i], "-r") == 0) {
+            use_vm = 2;
+        } else if (strcmp(argv[i], "--jit") == 0) {
+            use_vm = 1;
+            options.jit = 1;
+        } else if (strcmp(argv[i], "--no-trace") == 0) {
+            options.trace = 0;
+        } else if (strcmp(argv[i], "--no-cache") == 0) {
+            options.cache = 0;
+        } else if (strcmp(argv[i], "--gc-incremental") == 0) {
+            gc_set_incremental(0);
+        } else if (strcmp(argv[i], "--gc-pause") == 0 && i + 1 < argc) {
+            gc_set_incremental(strtol(argv[++i], NULL, 10));
+        } else if (strcmp(argv[i], "--gc-stats") == 0) {
+            atexit(print_gc_stats);
+        } else if (strcmp(argv[i], "--max-loops") == 0 && i + 1 < argc) {
+            options.max_loops = strtol(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-O0") == 0 || strcmp(argv[i], "-O1") == 0) {
+            options.opt_level = argv[i][2] - '0';
+        } else if (!filename && argv[i][0] != '-') {
+            filename = argv[i];
         } else {
             print_usage(argv[0]);
             return 1;
         }
-    } else {
+    }
+    
+    if (!filename) {
         print_usage(argv[0]);
         return 1;
     }
     
+    if (use_vm == 2) {
+        // 파일 실행 (레지스터 VM 모드, 지원하지 않는 구문이면 스택 VM)
+        run_file_regvm(filename, &options);
+    } else if (use_vm) {
+        // 파일 실행 (VM 모드)
+        run_file_vm(filename, &options);
+    } else {
+        // 파일 실행 (인터프리터 모드)
+        run_file(filename);
+    }
+    
     return 0;
 }
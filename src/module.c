@@ -1,4 +1,5 @@
 #include "module.h"
+#include "intern.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -7,7 +8,7 @@
 // 모듈 생성
 Module* module_create(const char* name, const char* filepath) {
     Module* module = (Module*)malloc(sizeof(Module));
-    module->name = strdup(name);
+    module->name = symbol_from(name);
     module->filepath = strdup(filepath);
     module->ast = NULL;
     module->exports = environment_create(NULL);
@@ -19,14 +20,11 @@ Module* module_create(const char* name, const char* filepath) {
 void module_free(Module* module) {
     if (!module) return;
     
-    free(module->name);
     free(module->filepath);
     if (module->ast) {
         ast_free(module->ast);
     }
-    if (module->exports) {
-        environment_free(module->exports);
-    }
+    // exports 환경은 GC가 회수 (모듈 값/함수 클로저가 계속 가리킬 수 있음)
     free(module);
 }
 
@@ -125,12 +123,12 @@ void module_cache_free(ModuleCache* cache) {
     free(cache);
 }
 
-// 캐시에서 모듈 찾기
+// 캐시에서 모듈 찾기 (name은 심볼, 포인터로 비교)
 Module* module_cache_get(ModuleCache* cache, const char* name) {
     if (!cache) return NULL;
     
     for (int i = 0; i < cache->count; i++) {
-        if (strcmp(cache->modules[i]->name, name) == 0) {
+        if (cache->modules[i]->name == name) {
             return cache->modules[i];
         }
     }
@@ -6,7 +6,7 @@
 
 // 모듈 구조체
 typedef struct Module {
-    char* name;                    // 모듈 이름
+    char* name;                    // 모듈 이름 (심볼)
     char* filepath;                // 모듈 파일 경로
     ASTNode* ast;                  // 파싱된 AST
     Environment* exports;          // export된 심볼들
@@ -0,0 +1,55 @@
+#ifndef NANBOX_H
+#define NANBOX_H
+
+#include <stdint.h>
+#include <string.h>
+#include "interpreter.h"
+
+// NaN-boxing: VM 스택의 값은 8바이트 워드 하나로 표현
+//  - 숫자: IEEE 754 double 비트 그대로
+//  - null / false / true: quiet NaN + 하위 태그
+//  - 힙 객체 (문자열, 배열, 딕셔너리, 행렬 등): 부호 비트 + quiet NaN + Value* (하위 48비트)
+// 숫자/불리언/null은 malloc 없이 스택에 바로 올라간다
+typedef uint64_t VMValue;
+
+#define QNAN     ((uint64_t)0x7ffc000000000000)
+#define SIGN_BIT ((uint64_t)0x8000000000000000)
+
+#define TAG_NULL  1
+#define TAG_FALSE 2
+#define TAG_TRUE  3
+#define TAG_UNDEFINED 4  // 아직 대입되지 않은 전역 슬롯 (스크립트에서는 볼 수 없음)
+
+#define NULL_VAL    ((VMValue)(QNAN | TAG_NULL))
+#define FALSE_VAL   ((VMValue)(QNAN | TAG_FALSE))
+#define TRUE_VAL    ((VMValue)(QNAN | TAG_TRUE))
+#define UNDEFINED_VAL ((VMValue)(QNAN | TAG_UNDEFINED))
+#define BOOL_VAL(b) ((b) ? TRUE_VAL : FALSE_VAL)
+#define OBJ_VAL(obj) ((VMValue)(SIGN_BIT | QNAN | (uint64_t)(uintptr_t)(obj)))
+
+#define IS_NUMBER(v) (((v) & QNAN) != QNAN)
+#define IS_NULL(v)   ((v) == NULL_VAL)
+#define IS_UNDEFINED(v) ((v) == UNDEFINED_VAL)
+#define IS_BOOL(v)   (((v) | 1) == TRUE_VAL)
+#define IS_OBJ(v)    (((v) & (QNAN | SIGN_BIT)) == (QNAN | SIGN_BIT))
+#define IS_OBJ_TYPE(v, t) (IS_OBJ(v) && AS_OBJ(v)->type == (t))
+
+#define AS_BOOL(v)   ((v) == TRUE_VAL)
+#define AS_OBJ(v)    ((Value*)(uintptr_t)((v) & ~(SIGN_BIT | QNAN)))
+#define AS_NUMBER(v) vm_value_as_number(v)
+#define NUMBER_VAL(num) vm_value_number(num)
+
+// double <-> 워드 변환 (memcpy는 컴파일러가 레지스터 이동으로 최적화)
+static inline double vm_value_as_number(VMValue value) {
+    double num;
+    memcpy(&num, &value, sizeof(double));
+    return num;
+}
+
+static inline VMValue vm_value_number(double num) {
+    VMValue value;
+    memcpy(&value, &num, sizeof(double));
+    return value;
+}
+
+#endif
@@ -5,6 +5,7 @@
 Parser* parser_create(Lexer* lexer) {
     Parser* parser = (Parser*)malloc(sizeof(Parser));
     parser->lexer = lexer;
+    parser->arena = arena_create();
     parser->current_token = lexer_next_token(lexer);
     return parser;
 }
@@ -12,6 +13,7 @@ Parser* parser_create(Lexer* lexer) {
 // 파서 메모리 해제
 void parser_free(Parser* parser) {
     token_free(parser->current_token);
+    arena_free(parser->arena);  // parser_parse가 끝났으면 NULL (트리가 가져감)
     free(parser);
 }
 
@@ -29,11 +31,11 @@ void parser_advance(Parser* parser) {
 
 // 프로그램 파싱
 ASTNode* parser_parse(Parser* parser) {
-    ASTNode* program = (ASTNode*)malloc(sizeof(ASTNode));
+    ASTNode* program = ast_alloc(parser->arena);
     program->type = AST_PROGRAM;
     
     int capacity = 10;
-    program->data.block.statements = (ASTNode**)malloc(sizeof(ASTNode*) * capacity);
+    program->data.block.statements = (ASTNode**)arena_alloc(parser->arena, sizeof(ASTNode*) * capacity);
     program->data.block.statement_count = 0;
     
     while (parser->current_token->type != TOKEN_EOF) {
@@ -45,14 +47,17 @@ ASTNode* parser_parse(Parser* parser) {
         ASTNode* stmt = parser_parse_statement(parser);
         if (stmt) {
             if (program->data.block.statement_count >= capacity) {
+                program->data.block.statements = (ASTNode**)arena_grow(parser->arena, program->data.block.statements,
+                    sizeof(ASTNode*) * capacity, sizeof(ASTNode*) * capacity * 2);
                 capacity *= 2;
-                program->data.block.statements = (ASTNode**)realloc(
-                    program->data.block.statements, sizeof(ASTNode*) * capacity);
             }
             program->data.block.statements[program->data.block.statement_count++] = stmt;
         }
     }
     
+    // 아레나는 트리가 가져감 (ast_free(program)이 한 번에 해제)
+    program->data.block.arena = parser->arena;
+    parser->arena = NULL;
     return program;
 }
 
@@ -91,14 +96,14 @@ ASTNode* parser_parse_statement(Parser* parser) {
 ASTNode* parser_parse_let(Parser* parser) {
     parser_advance(parser); // 'let' 건너뛰기
     
-    char* name = strdup(parser->current_token->value);
+    char* name = parser->current_token->value;
     parser_advance(parser); // 변수명
     
     parser_advance(parser); // '=' 건너뛰기
     
     ASTNode* value = parser_parse_expression(parser);
     
-    ASTNode* node = (ASTNode*)malloc(sizeof(ASTNode));
+    ASTNode* node = ast_alloc(parser->arena);
     node->type = AST_LET;
     node->data.assign.name = name;
     node->data.assign.value = value;
@@ -110,21 +115,22 @@ ASTNode* parser_parse_let(Parser* parser) {
 ASTNode* parser_parse_function(Parser* parser) {
     parser_advance(parser); // 'fn' 건너뛰기
     
-    char* name = strdup(parser->current_token->value);
+    char* name = parser->current_token->value;
     parser_advance(parser);
     
     parser_advance(parser); // '(' 건너뛰기
     
     int param_capacity = 5;
-    char** params = (char**)malloc(sizeof(char*) * param_capacity);
+    char** params = (char**)arena_alloc(parser->arena, sizeof(char*) * param_capacity);
     int param_count = 0;
     
     while (parser->current_token->type != TOKEN_RPAREN) {
         if (param_count >= param_capacity) {
+            params = (char**)arena_grow(parser->arena, params,
+                sizeof(char*) * param_capacity, sizeof(char*) * param_capacity * 2);
             param_capacity *= 2;
-            params = (char**)realloc(params, sizeof(char*) * param_capacity);
         }
-        params[param_count++] = strdup(parser->current_token->value);
+        params[param_count++] = parser->current_token->value;
         parser_advance(parser);
         
         if (parser->current_token->type == TOKEN_COMMA) {
@@ -136,7 +142,7 @@ ASTNode* parser_parse_function(Parser* parser) {
     
     ASTNode* body = parser_parse_block(parser);
     
-    ASTNode* node = (ASTNode*)malloc(sizeof(ASTNode));
+    ASTNode* node = ast_alloc(parser->arena);
     node->type = AST_FUNCTION_DEF;
     node->data.function_def.name = name;
     node->data.function_def.params = params;
@@ -159,7 +165,7 @@ ASTNode* parser_parse_if(Parser* parser) {
         else_branch = parser_parse_block(parser);
     }
     
-    ASTNode* node = (ASTNode*)malloc(sizeof(ASTNode));
+    ASTNode* node = ast_alloc(parser->arena);
     node->type = AST_IF;
     node->data.if_stmt.condition = condition;
     node->data.if_stmt.then_branch = then_branch;
@@ -182,7 +188,7 @@ ASTNode* parser_parse_for(Parser* parser) {
         parser_advance(parser); // '(' 건너뛰기
     }
     
-    char* iterator = strdup(parser->current_token->value);
+    char* iterator = parser->current_token->value;
     parser_advance(parser);
     
     parser_advance(parser); // 'in' 건너뛰기
@@ -195,7 +201,7 @@ ASTNode* parser_parse_for(Parser* parser) {
     
     ASTNode* body = parser_parse_block(parser);
     
-    ASTNode* node = (ASTNode*)malloc(sizeof(ASTNode));
+    ASTNode* node = ast_alloc(parser->arena);
     node->type = AST_FOR;
     node->data.for_loop.iterator = iterator;
     node->data.for_loop.iterable = iterable;
@@ -212,7 +218,7 @@ ASTNode* parser_parse_while(Parser* parser) {
     ASTNode* condition = parser_parse_expression(parser);
     ASTNode* body = parser_parse_block(parser);
     
-    ASTNode* node = (ASTNode*)malloc(sizeof(ASTNode));
+    ASTNode* node = ast_alloc(parser->arena);
     node->type = AST_WHILE;
     node->data.while_loop.condition = condition;
     node->data.while_loop.body = body;
@@ -226,7 +232,7 @@ ASTNode* parser_parse_return(Parser* parser) {
     
     ASTNode* value = parser_parse_expression(parser);
     
-    ASTNode* node = (ASTNode*)malloc(sizeof(ASTNode));
+    ASTNode* node = ast_alloc(parser->arena);
     node->type = AST_RETURN;
     node->data.return_stmt.value = value;
     
@@ -251,7 +257,7 @@ ASTNode* parser_parse_try_catch(Parser* parser) {
         // 예외 타입 (선택적): catch ZeroDivisionError as e
         if (parser->current_token->type == TOKEN_IDENTIFIER) {
             // 다음 토큰이 'as'인지 확인
-            exception_type = strdup(parser->current_token->value);
+            exception_type = parser->current_token->value;
             parser_advance(parser);
             
             // 'as' 키워드가 있으면 변수명을 파싱
@@ -259,7 +265,7 @@ ASTNode* parser_parse_try_catch(Parser* parser) {
                 parser_advance(parser); // 'as' 건너뛰기
                 
                 if (parser->current_token->type == TOKEN_IDENTIFIER) {
-                    exception_var = strdup(parser->current_token->value);
+                    exception_var = parser->current_token->value;
                     parser_advance(parser);
                 }
             } else {
@@ -280,7 +286,7 @@ ASTNode* parser_parse_try_catch(Parser* parser) {
         finally_block = parser_parse_block(parser);
     }
     
-    ASTNode* node = (ASTNode*)malloc(sizeof(ASTNode));
+    ASTNode* node = ast_alloc(parser->arena);
     node->type = AST_TRY_CATCH;
     node->data.try_catch.try_block = try_block;
     node->data.try_catch.exception_type = exception_type;
@@ -297,7 +303,7 @@ ASTNode* parser_parse_throw(Parser* parser) {
     
     ASTNode* exception_value = parser_parse_expression(parser);
     
-    ASTNode* node = (ASTNode*)malloc(sizeof(ASTNode));
+    ASTNode* node = ast_alloc(parser->arena);
     node->type = AST_THROW;
     node->data.throw_stmt.exception_value = exception_value;
     
@@ -317,12 +323,12 @@ ASTNode* parser_parse_assert(Parser* parser) {
         parser_advance(parser); // ',' 건너뛰기
         
         if (parser->current_token->type == TOKEN_STRING) {
-            message = strdup(parser->current_token->value);
+            message = parser->current_token->value;
             parser_advance(parser);
         }
     }
     
-    ASTNode* node = (ASTNode*)malloc(sizeof(ASTNode));
+    ASTNode* node = ast_alloc(parser->arena);
     node->type = AST_ASSERT;
     node->data.assert_stmt.condition = condition;
     node->data.assert_stmt.message = message;
@@ -343,7 +349,7 @@ ASTNode* parser_parse_import(Parser* parser) {
             exit(1);
         }
         
-        char* module_name = strdup(parser->current_token->value);
+        char* module_name = parser->current_token->value;
         parser_advance(parser);
         
         // 'import' 키워드 확인
@@ -355,15 +361,16 @@ ASTNode* parser_parse_import(Parser* parser) {
         
         // 임포트할 이름들 파싱
         int capacity = 5;
-        char** names = (char**)malloc(sizeof(char*) * capacity);
+        char** names = (char**)arena_alloc(parser->arena, sizeof(char*) * capacity);
         int count = 0;
         
         while (parser->current_token->type == TOKEN_IDENTIFIER) {
             if (count >= capacity) {
+                names = (char**)arena_grow(parser->arena, names,
+                    sizeof(char*) * capacity, sizeof(char*) * capacity * 2);
                 capacity *= 2;
-                names = (char**)realloc(names, sizeof(char*) * capacity);
             }
-            names[count++] = strdup(parser->current_token->value);
+            names[count++] = parser->current_token->value;
             parser_advance(parser);
             
             if (parser->current_token->type == TOKEN_COMMA) {
@@ -373,7 +380,7 @@ ASTNode* parser_parse_import(Parser* parser) {
             }
         }
         
-        ASTNode* node = (ASTNode*)malloc(sizeof(ASTNode));
+        ASTNode* node = ast_alloc(parser->arena);
         node->type = AST_IMPORT;
         node->data.import_stmt.module_name = module_name;
         node->data.import_stmt.alias = NULL;
@@ -391,7 +398,7 @@ ASTNode* parser_parse_import(Parser* parser) {
         exit(1);
     }
     
-    char* module_name = strdup(parser->current_token->value);
+    char* module_name = parser->current_token->value;
     parser_advance(parser);
     
     char* alias = NULL;
@@ -403,11 +410,11 @@ ASTNode* parser_parse_import(Parser* parser) {
             exit(1);
         }
         
-        alias = strdup(parser->current_token->value);
+        alias = parser->current_token->value;
         parser_advance(parser);
     }
     
-    ASTNode* node = (ASTNode*)malloc(sizeof(ASTNode));
+    ASTNode* node = ast_alloc(parser->arena);
     node->type = AST_IMPORT;
     node->data.import_stmt.module_name = module_name;
     node->data.import_stmt.alias = alias;
@@ -436,7 +443,7 @@ ASTNode* parser_parse_export(Parser* parser) {
         exit(1);
     }
     
-    ASTNode* node = (ASTNode*)malloc(sizeof(ASTNode));
+    ASTNode* node = ast_alloc(parser->arena);
     node->type = AST_EXPORT;
     node->data.export_stmt.node = exported_node;
     
@@ -447,42 +454,42 @@ ASTNode* parser_parse_export(Parser* parser) {
 ASTNode* parser_parse_class(Parser* parser) {
     parser_advance(parser); // 'class' 건너뛰기
     
-    char* class_name = strdup(parser->current_token->value);
+    char* class_name = parser->current_token->value;
     parser_advance(parser); // 클래스명
     
     // extends 처리
     char* parent_class = NULL;
     if (parser->current_token->type == TOKEN_EXTENDS) {
         parser_advance(parser); // 'extends' 건너뛰기
-        parent_class = strdup(parser->current_token->value);
+        parent_class = parser->current_token->value;
         parser_advance(parser); // 부모 클래스명
     }
     
     parser_advance(parser); // '{' 건너뛰기
     
-    ASTNode* class_node = (ASTNode*)malloc(sizeof(ASTNode));
+    ASTNode* class_node = ast_alloc(parser->arena);
     class_node->type = AST_CLASS;
     class_node->data.class_def.name = class_name;
     class_node->data.class_def.parent_class = parent_class;
     
     int field_capacity = 10;
-    class_node->data.class_def.fields = (char**)malloc(sizeof(char*) * field_capacity);
+    class_node->data.class_def.fields = (char**)arena_alloc(parser->arena, sizeof(char*) * field_capacity);
     class_node->data.class_def.field_count = 0;
     
     int method_capacity = 10;
-    class_node->data.class_def.methods = (ASTNode**)malloc(sizeof(ASTNode*) * method_capacity);
+    class_node->data.class_def.methods = (ASTNode**)arena_alloc(parser->arena, sizeof(ASTNode*) * method_capacity);
     class_node->data.class_def.method_count = 0;
     
     while (parser->current_token->type != TOKEN_RBRACE) {
         if (parser->current_token->type == TOKEN_LET) {
             // 필드 정의
             parser_advance(parser); // 'let' 건너뛰기
-            char* field_name = strdup(parser->current_token->value);
+            char* field_name = parser->current_token->value;
             
             if (class_node->data.class_def.field_count >= field_capacity) {
+                class_node->data.class_def.fields = (char**)arena_grow(parser->arena, class_node->data.class_def.fields,
+                    sizeof(char*) * field_capacity, sizeof(char*) * field_capacity * 2);
                 field_capacity *= 2;
-                class_node->data.class_def.fields = (char**)realloc(
-                    class_node->data.class_def.fields, sizeof(char*) * field_capacity);
             }
             class_node->data.class_def.fields[class_node->data.class_def.field_count++] = field_name;
             parser_advance(parser);
@@ -491,9 +498,9 @@ ASTNode* parser_parse_class(Parser* parser) {
             ASTNode* method = parser_parse_function(parser);
             
             if (class_node->data.class_def.method_count >= method_capacity) {
+                class_node->data.class_def.methods = (ASTNode**)arena_grow(parser->arena, class_node->data.class_def.methods,
+                    sizeof(ASTNode*) * method_capacity, sizeof(ASTNode*) * method_capacity * 2);
                 method_capacity *= 2;
-                class_node->data.class_def.methods = (ASTNode**)realloc(
-                    class_node->data.class_def.methods, sizeof(ASTNode*) * method_capacity);
             }
             class_node->data.class_def.methods[class_node->data.class_def.method_count++] = method;
         } else {
@@ -510,11 +517,11 @@ ASTNode* parser_parse_class(Parser* parser) {
 ASTNode* parser_parse_block(Parser* parser) {
     parser_advance(parser); // '{' 건너뛰기
     
-    ASTNode* block = (ASTNode*)malloc(sizeof(ASTNode));
+    ASTNode* block = ast_alloc(parser->arena);
     block->type = AST_BLOCK;
     
     int capacity = 10;
-    block->data.block.statements = (ASTNode**)malloc(sizeof(ASTNode*) * capacity);
+    block->data.block.statements = (ASTNode**)arena_alloc(parser->arena, sizeof(ASTNode*) * capacity);
     block->data.block.statement_count = 0;
     
     while (parser->current_token->type != TOKEN_RBRACE && parser->current_token->type != TOKEN_EOF) {
@@ -526,9 +533,9 @@ ASTNode* parser_parse_block(Parser* parser) {
         ASTNode* stmt = parser_parse_statement(parser);
         if (stmt) {
             if (block->data.block.statement_count >= capacity) {
+                block->data.block.statements = (ASTNode**)arena_grow(parser->arena, block->data.block.statements,
+                    sizeof(ASTNode*) * capacity, sizeof(ASTNode*) * capacity * 2);
                 capacity *= 2;
-                block->data.block.statements = (ASTNode**)realloc(
-                    block->data.block.statements, sizeof(ASTNode*) * capacity);
             }
             block->data.block.statements[block->data.block.statement_count++] = stmt;
         }
@@ -549,34 +556,31 @@ ASTNode* parser_parse_expression(Parser* parser) {
         
         // 배열 인덱스 할당 처리 (arr[i] = value)
         if (left->type == AST_INDEX) {
-            ASTNode* node = (ASTNode*)malloc(sizeof(ASTNode));
+            ASTNode* node = ast_alloc(parser->arena);
             node->type = AST_INDEX_ASSIGN;
             node->data.index_assign.array = left->data.index.array;
             node->data.index_assign.index = left->data.index.index;
             node->data.index_assign.value = right;
-            // left의 외부 구조만 해제 (내부는 node가 사용 중)
-            free(left);
+            // left는 버림 (아레나와 함께 해제됨, 내부는 node가 사용 중)
             return node;
         }
         
         // 필드 할당 처리 (obj.field = value)
         if (left->type == AST_DOT_ACCESS) {
-            ASTNode* node = (ASTNode*)malloc(sizeof(ASTNode));
+            ASTNode* node = ast_alloc(parser->arena);
             node->type = AST_FIELD_ASSIGN;
             node->data.field_assign.object = left->data.dot.object;
             node->data.field_assign.field_name = left->data.dot.property;
             node->data.field_assign.value = right;
-            // left의 외부 구조만 해제 (내부는 node가 사용 중)
-            free(left);
+            // left는 버림 (아레나와 함께 해제됨, 내부는 node가 사용 중)
             return node;
         }
         
         // 일반 변수 할당
-        ASTNode* node = (ASTNode*)malloc(sizeof(ASTNode));
+        ASTNode* node = ast_alloc(parser->arena);
         node->type = AST_ASSIGN;
-        node->data.assign.name = strdup(left->data.string);
+        node->data.assign.name = left->data.string;
         node->data.assign.value = right;
-        ast_free(left);
         return node;
     }
     
@@ -593,10 +597,10 @@ ASTNode* parser_parse_comparison(Parser* parser) {
            parser->current_token->type == TOKEN_LESS_EQUAL ||
            parser->current_token->type == TOKEN_GREATER ||
            parser->current_token->type == TOKEN_GREATER_EQUAL) {
-        char* op = strdup(parser->current_token->value);
+        char* op = parser->current_token->value;
         parser_advance(parser);
         ASTNode* right = parser_parse_term(parser);
-        left = ast_create_binary(op, left, right);
+        left = ast_create_binary(parser->arena, op, left, right);
     }
     
     return left;
@@ -609,10 +613,10 @@ ASTNode* parser_parse_term(Parser* parser) {
     while (parser->current_token->type == TOKEN_PLUS ||
            parser->current_token->type == TOKEN_MINUS ||
            parser->current_token->type == TOKEN_AT) {
-        char* op = strdup(parser->current_token->value);
+        char* op = parser->current_token->value;
         parser_advance(parser);
         ASTNode* right = parser_parse_factor(parser);
-        left = ast_create_binary(op, left, right);
+        left = ast_create_binary(parser->arena, op, left, right);
     }
     
     return left;
@@ -626,10 +630,10 @@ ASTNode* parser_parse_factor(Parser* parser) {
            parser->current_token->type == TOKEN_DIVIDE ||
            parser->current_token->type == TOKEN_MODULO ||
            parser->current_token->type == TOKEN_FLOOR_DIV) {
-        char* op = strdup(parser->current_token->value);
+        char* op = parser->current_token->value;
         parser_advance(parser);
         ASTNode* right = parser_parse_unary(parser);
-        left = ast_create_binary(op, left, right);
+        left = ast_create_binary(parser->arena, op, left, right);
     }
     
     return left;
@@ -639,11 +643,11 @@ ASTNode* parser_parse_factor(Parser* parser) {
 ASTNode* parser_parse_unary(Parser* parser) {
     // 단항 마이너스
     if (parser->current_token->type == TOKEN_MINUS) {
-        char* op = strdup(parser->current_token->value);
+        char* op = parser->current_token->value;
         parser_advance(parser);
         ASTNode* operand = parser_parse_unary(parser);  // 재귀적으로 단항 연산자 처리
         
-        ASTNode* node = (ASTNode*)malloc(sizeof(ASTNode));
+        ASTNode* node = ast_alloc(parser->arena);
         node->type = AST_UNARY_OP;
         node->data.unary.op = op;
         node->data.unary.operand = operand;
@@ -664,13 +668,14 @@ ASTNode* parser_parse_postfix(Parser* parser) {
             parser_advance(parser);
             
             int arg_capacity = 5;
-            ASTNode** args = (ASTNode**)malloc(sizeof(ASTNode*) * arg_capacity);
+            ASTNode** args = (ASTNode**)arena_alloc(parser->arena, sizeof(ASTNode*) * arg_capacity);
             int arg_count = 0;
             
             while (parser->current_token->type != TOKEN_RPAREN) {
                 if (arg_count >= arg_capacity) {
+                    args = (ASTNode**)arena_grow(parser->arena, args,
+                        sizeof(ASTNode*) * arg_capacity, sizeof(ASTNode*) * arg_capacity * 2);
                     arg_capacity *= 2;
-                    args = (ASTNode**)realloc(args, sizeof(ASTNode*) * arg_capacity);
                 }
                 args[arg_count++] = parser_parse_expression(parser);
                 
@@ -681,10 +686,9 @@ ASTNode* parser_parse_postfix(Parser* parser) {
             
             parser_advance(parser); // ')' 건너뛰기
             
-            char* func_name = strdup(node->data.string);
+            char* func_name = node->data.string;
             int func_line = node->line;  // 함수 이름의 라인 번호
-            ast_free(node);
-            node = ast_create_function_call(func_name, args, arg_count);
+            node = ast_create_function_call(parser->arena, func_name, args, arg_count);
             node->line = func_line;  // 함수 이름의 라인 번호 사용
             
         } else if (parser->current_token->type == TOKEN_LBRACKET) {
@@ -693,7 +697,7 @@ ASTNode* parser_parse_postfix(Parser* parser) {
             ASTNode* index = parser_parse_expression(parser);
             parser_advance(parser); // ']' 건너뛰기
             
-            ASTNode* index_node = (ASTNode*)malloc(sizeof(ASTNode));
+            ASTNode* index_node = ast_alloc(parser->arena);
             index_node->type = AST_INDEX;
             index_node->data.index.array = node;
             index_node->data.index.index = index;
@@ -703,7 +707,7 @@ ASTNode* parser_parse_postfix(Parser* parser) {
         } else if (parser->current_token->type == TOKEN_DOT) {
             // 점 접근 또는 메서드 호출
             parser_advance(parser);
-            char* property = strdup(parser->current_token->value);
+            char* property = parser->current_token->value;
             parser_advance(parser);
             
             // 메서드 호출인지 확인
@@ -711,13 +715,14 @@ ASTNode* parser_parse_postfix(Parser* parser) {
                 parser_advance(parser); // '(' 건너뛰기
                 
                 int arg_capacity = 5;
-                ASTNode** args = (ASTNode**)malloc(sizeof(ASTNode*) * arg_capacity);
+                ASTNode** args = (ASTNode**)arena_alloc(parser->arena, sizeof(ASTNode*) * arg_capacity);
                 int arg_count = 0;
                 
                 while (parser->current_token->type != TOKEN_RPAREN) {
                     if (arg_count >= arg_capacity) {
+                        args = (ASTNode**)arena_grow(parser->arena, args,
+                            sizeof(ASTNode*) * arg_capacity, sizeof(ASTNode*) * arg_capacity * 2);
                         arg_capacity *= 2;
-                        args = (ASTNode**)realloc(args, sizeof(ASTNode*) * arg_capacity);
                     }
                     args[arg_count++] = parser_parse_expression(parser);
                     
@@ -728,7 +733,7 @@ ASTNode* parser_parse_postfix(Parser* parser) {
                 
                 parser_advance(parser); // ')' 건너뛰기
                 
-                ASTNode* method_node = (ASTNode*)malloc(sizeof(ASTNode));
+                ASTNode* method_node = ast_alloc(parser->arena);
                 method_node->type = AST_METHOD_CALL;
                 method_node->data.method_call.object = node;
                 method_node->data.method_call.method_name = property;
@@ -737,7 +742,7 @@ ASTNode* parser_parse_postfix(Parser* parser) {
                 node = method_node;
             } else {
                 // 필드 접근
-                ASTNode* dot_node = (ASTNode*)malloc(sizeof(ASTNode));
+                ASTNode* dot_node = ast_alloc(parser->arena);
                 dot_node->type = AST_DOT_ACCESS;
                 dot_node->data.dot.object = node;
                 dot_node->data.dot.property = property;
@@ -747,18 +752,19 @@ ASTNode* parser_parse_postfix(Parser* parser) {
         } else if (parser->current_token->type == TOKEN_ARROW) {
             // -> 연산자 (메서드 호출)
             parser_advance(parser);
-            char* method_name = strdup(parser->current_token->value);
+            char* method_name = parser->current_token->value;
             parser_advance(parser);
             parser_advance(parser); // '(' 건너뛰기
             
             int arg_capacity = 5;
-            ASTNode** args = (ASTNode**)malloc(sizeof(ASTNode*) * arg_capacity);
+            ASTNode** args = (ASTNode**)arena_alloc(parser->arena, sizeof(ASTNode*) * arg_capacity);
             int arg_count = 0;
             
             while (parser->current_token->type != TOKEN_RPAREN) {
                 if (arg_count >= arg_capacity) {
+                    args = (ASTNode**)arena_grow(parser->arena, args,
+                        sizeof(ASTNode*) * arg_capacity, sizeof(ASTNode*) * arg_capacity * 2);
                     arg_capacity *= 2;
-                    args = (ASTNode**)realloc(args, sizeof(ASTNode*) * arg_capacity);
                 }
                 args[arg_count++] = parser_parse_expression(parser);
                 
@@ -769,7 +775,7 @@ ASTNode* parser_parse_postfix(Parser* parser) {
             
             parser_advance(parser); // ')' 건너뛰기
             
-            ASTNode* method_node = (ASTNode*)malloc(sizeof(ASTNode));
+            ASTNode* method_node = ast_alloc(parser->arena);
             method_node->type = AST_METHOD_CALL;
             method_node->data.method_call.object = node;
             method_node->data.method_call.method_name = method_name;
@@ -790,25 +796,25 @@ ASTNode* parser_parse_primary(Parser* parser) {
     if (parser->current_token->type == TOKEN_NEW) {
         parser_advance(parser); // 'new' 건너뛰기
         
-        char* class_name = strdup(parser->current_token->value);
+        char* class_name = parser->current_token->value;
         parser_advance(parser);
         
         // 생성자 인자
         parser_advance(parser); // '(' 건너뛰기
         
-        ASTNode* new_node = (ASTNode*)malloc(sizeof(ASTNode));
+        ASTNode* new_node = ast_alloc(parser->arena);
         new_node->type = AST_NEW;
         new_node->data.new_expr.class_name = class_name;
         
         int capacity = 10;
-        new_node->data.new_expr.args = (ASTNode**)malloc(sizeof(ASTNode*) * capacity);
+        new_node->data.new_expr.args = (ASTNode**)arena_alloc(parser->arena, sizeof(ASTNode*) * capacity);
         new_node->data.new_expr.arg_count = 0;
         
         while (parser->current_token->type != TOKEN_RPAREN) {
             if (new_node->data.new_expr.arg_count >= capacity) {
+                new_node->data.new_expr.args = (ASTNode**)arena_grow(parser->arena, new_node->data.new_expr.args,
+                    sizeof(ASTNode*) * capacity, sizeof(ASTNode*) * capacity * 2);
                 capacity *= 2;
-                new_node->data.new_expr.args = (ASTNode**)realloc(
-                    new_node->data.new_expr.args, sizeof(ASTNode*) * capacity);
             }
             new_node->data.new_expr.args[new_node->data.new_expr.arg_count++] = parser_parse_expression(parser);
             
@@ -824,7 +830,7 @@ ASTNode* parser_parse_primary(Parser* parser) {
     
     if (parser->current_token->type == TOKEN_THIS) {
         parser_advance(parser);
-        ASTNode* node = (ASTNode*)malloc(sizeof(ASTNode));
+        ASTNode* node = ast_alloc(parser->arena);
         node->type = AST_THIS;
         return node;
     }
@@ -833,23 +839,23 @@ ASTNode* parser_parse_primary(Parser* parser) {
         parser_advance(parser); // 'super' 건너뛰기
         parser_advance(parser); // '.' 건너뛰기
         
-        char* method_name = strdup(parser->current_token->value);
+        char* method_name = parser->current_token->value;
         parser_advance(parser);
         parser_advance(parser); // '(' 건너뛰기
         
-        ASTNode* super_node = (ASTNode*)malloc(sizeof(ASTNode));
+        ASTNode* super_node = ast_alloc(parser->arena);
         super_node->type = AST_SUPER;
         super_node->data.super_call.method_name = method_name;
         
         int capacity = 10;
-        super_node->data.super_call.args = (ASTNode**)malloc(sizeof(ASTNode*) * capacity);
+        super_node->data.super_call.args = (ASTNode**)arena_alloc(parser->arena, sizeof(ASTNode*) * capacity);
         super_node->data.super_call.arg_count = 0;
         
         while (parser->current_token->type != TOKEN_RPAREN) {
             if (super_node->data.super_call.arg_count >= capacity) {
+                super_node->data.super_call.args = (ASTNode**)arena_grow(parser->arena, super_node->data.super_call.args,
+                    sizeof(ASTNode*) * capacity, sizeof(ASTNode*) * capacity * 2);
                 capacity *= 2;
-                super_node->data.super_call.args = (ASTNode**)realloc(
-                    super_node->data.super_call.args, sizeof(ASTNode*) * capacity);
             }
             super_node->data.super_call.args[super_node->data.super_call.arg_count++] = parser_parse_expression(parser);
             
@@ -867,7 +873,7 @@ ASTNode* parser_parse_primary(Parser* parser) {
         double value = atof(parser->current_token->value);
         int line = parser->current_token->line;
         parser_advance(parser);
-        ASTNode* node = ast_create_number(value);
+        ASTNode* node = ast_create_number(parser->arena, value);
         node->line = line;
         return node;
     }
@@ -875,7 +881,7 @@ ASTNode* parser_parse_primary(Parser* parser) {
     if (parser->current_token->type == TOKEN_TRUE) {
         int line = parser->current_token->line;
         parser_advance(parser);
-        ASTNode* node = ast_create_bool(1);
+        ASTNode* node = ast_create_bool(parser->arena, 1);
         node->line = line;
         return node;
     }
@@ -883,16 +889,16 @@ ASTNode* parser_parse_primary(Parser* parser) {
     if (parser->current_token->type == TOKEN_FALSE) {
         int line = parser->current_token->line;
         parser_advance(parser);
-        ASTNode* node = ast_create_bool(0);
+        ASTNode* node = ast_create_bool(parser->arena, 0);
         node->line = line;
         return node;
     }
     
     if (parser->current_token->type == TOKEN_STRING) {
-        char* value = strdup(parser->current_token->value);
+        char* value = parser->current_token->value;
         int line = parser->current_token->line;
         parser_advance(parser);
-        ASTNode* node = ast_create_string(value);
+        ASTNode* node = ast_create_string(parser->arena, value);
         node->line = line;
         return node;
     }
@@ -902,10 +908,10 @@ ASTNode* parser_parse_primary(Parser* parser) {
         parser->current_token->type == TOKEN_RANGE ||
         parser->current_token->type == TOKEN_LEN ||
         parser->current_token->type == TOKEN_SUM) {
-        char* name = strdup(parser->current_token->value);
+        char* name = parser->current_token->value;
         int line = parser->current_token->line;
         parser_advance(parser);
-        ASTNode* node = ast_create_identifier(name);
+        ASTNode* node = ast_create_identifier(parser->arena, name);
         node->line = line;
         return node;
     }
@@ -933,18 +939,18 @@ ASTNode* parser_parse_primary(Parser* parser) {
 ASTNode* parser_parse_array(Parser* parser) {
     parser_advance(parser); // '[' 건너뛰기
     
-    ASTNode* array = (ASTNode*)malloc(sizeof(ASTNode));
+    ASTNode* array = ast_alloc(parser->arena);
     array->type = AST_ARRAY;
     
     int capacity = 10;
-    array->data.array.elements = (ASTNode**)malloc(sizeof(ASTNode*) * capacity);
+    array->data.array.elements = (ASTNode**)arena_alloc(parser->arena, sizeof(ASTNode*) * capacity);
     array->data.array.element_count = 0;
     
     while (parser->current_token->type != TOKEN_RBRACKET) {
         if (array->data.array.element_count >= capacity) {
+            array->data.array.elements = (ASTNode**)arena_grow(parser->arena, array->data.array.elements,
+                sizeof(ASTNode*) * capacity, sizeof(ASTNode*) * capacity * 2);
             capacity *= 2;
-            array->data.array.elements = (ASTNode**)realloc(
-                array->data.array.elements, sizeof(ASTNode*) * capacity);
         }
         array->data.array.elements[array->data.array.element_count++] = parser_parse_expression(parser);
         
@@ -977,7 +983,7 @@ ASTNode* parser_parse_array(Parser* parser) {
         
         // 행렬로 변환
         if (is_matrix && first_cols > 0) {
-            ASTNode* matrix = (ASTNode*)malloc(sizeof(ASTNode));
+            ASTNode* matrix = ast_alloc(parser->arena);
             matrix->type = AST_MATRIX;
             matrix->data.matrix.row_count = array->data.array.element_count;
             matrix->data.matrix.col_count = first_cols;
@@ -993,27 +999,29 @@ ASTNode* parser_parse_array(Parser* parser) {
 ASTNode* parser_parse_dict(Parser* parser) {
     parser_advance(parser); // '{' 건너뛰기
     
-    ASTNode* dict = (ASTNode*)malloc(sizeof(ASTNode));
+    ASTNode* dict = ast_alloc(parser->arena);
     dict->type = AST_DICT;
     
     int capacity = 10;
-    dict->data.dict.keys = (char**)malloc(sizeof(char*) * capacity);
-    dict->data.dict.values = (ASTNode**)malloc(sizeof(ASTNode*) * capacity);
+    dict->data.dict.keys = (char**)arena_alloc(parser->arena, sizeof(char*) * capacity);
+    dict->data.dict.values = (ASTNode**)arena_alloc(parser->arena, sizeof(ASTNode*) * capacity);
     dict->data.dict.pair_count = 0;
     
     while (parser->current_token->type != TOKEN_RBRACE) {
         if (dict->data.dict.pair_count >= capacity) {
+            dict->data.dict.keys = (char**)arena_grow(parser->arena, dict->data.dict.keys,
+                sizeof(char*) * capacity, sizeof(char*) * capacity * 2);
+            dict->data.dict.values = (ASTNode**)arena_grow(parser->arena, dict->data.dict.values,
+                sizeof(ASTNode*) * capacity, sizeof(ASTNode*) * capacity * 2);
             capacity *= 2;
-            dict->data.dict.keys = (char**)realloc(dict->data.dict.keys, sizeof(char*) * capacity);
-            dict->data.dict.values = (ASTNode**)realloc(dict->data.dict.values, sizeof(ASTNode*) * capacity);
         }
         
         // 키 (식별자 또는 문자열)
         char* key;
         if (parser->current_token->type == TOKEN_IDENTIFIER) {
-            key = strdup(parser->current_token->value);
+            key = parser->current_token->value;
         } else if (parser->current_token->type == TOKEN_STRING) {
-            key = strdup(parser->current_token->value);
+            key = parser->current_token->value;
         } else {
             break;
         }
@@ -1041,51 +1049,57 @@ ASTNode* parser_parse_dict(Parser* parser) {
     return dict;
 }
 
-// AST 노드 생성 함수들
-ASTNode* ast_create_number(double value) {
-    ASTNode* node = (ASTNode*)malloc(sizeof(ASTNode));
+// AST 노드 생성 함수들 (모두 파스의 아레나에서 받음, 0으로 채워짐)
+ASTNode* ast_alloc(Arena* arena) {
+    ASTNode* node = (ASTNode*)arena_calloc(arena, sizeof(ASTNode));
+    node->slot = -1;
+    return node;
+}
+
+ASTNode* ast_create_number(Arena* arena, double value) {
+    ASTNode* node = ast_alloc(arena);
     node->type = AST_NUMBER;
     node->data.number = value;
     node->line = 0;  // 호출하는 곳에서 설정
     return node;
 }
 
-ASTNode* ast_create_bool(int value) {
-    ASTNode* node = (ASTNode*)malloc(sizeof(ASTNode));
+ASTNode* ast_create_bool(Arena* arena, int value) {
+    ASTNode* node = ast_alloc(arena);
     node->type = AST_BOOL;
     node->data.boolean = value ? 1 : 0;
     node->line = 0;  // 호출하는 곳에서 설정
     return node;
 }
 
-ASTNode* ast_create_string(char* value) {
-    ASTNode* node = (ASTNode*)malloc(sizeof(ASTNode));
+ASTNode* ast_create_string(Arena* arena, char* value) {
+    ASTNode* node = ast_alloc(arena);
     node->type = AST_STRING;
-    node->data.string = strdup(value);
+    node->data.string = value;
     node->line = 0;  // 호출하는 곳에서 설정
     return node;
 }
 
-ASTNode* ast_create_identifier(char* name) {
-    ASTNode* node = (ASTNode*)malloc(sizeof(ASTNode));
+ASTNode* ast_create_identifier(Arena* arena, char* name) {
+    ASTNode* node = ast_alloc(arena);
     node->type = AST_IDENTIFIER;
-    node->data.string = strdup(name);
+    node->data.string = name;
     node->line = 0;  // 호출하는 곳에서 설정
     return node;
 }
 
-ASTNode* ast_create_binary(char* op, ASTNode* left, ASTNode* right) {
-    ASTNode* node = (ASTNode*)malloc(sizeof(ASTNode));
+ASTNode* ast_create_binary(Arena* arena, char* op, ASTNode* left, ASTNode* right) {
+    ASTNode* node = ast_alloc(arena);
     node->type = AST_BINARY_OP;
-    node->data.binary.op = strdup(op);
+    node->data.binary.op = op;
     node->data.binary.left = left;
     node->data.binary.right = right;
     node->line = (left && left->line > 0) ? left->line : 0;  // 왼쪽 피연산자의 라인 사용
     return node;
 }
 
-ASTNode* ast_create_function_call(char* name, ASTNode** args, int arg_count) {
-    ASTNode* node = (ASTNode*)malloc(sizeof(ASTNode));
+ASTNode* ast_create_function_call(Arena* arena, char* name, ASTNode** args, int arg_count) {
+    ASTNode* node = ast_alloc(arena);
     node->type = AST_FUNCTION_CALL;
     node->data.function_call.name = name;
     node->data.function_call.args = args;
@@ -1094,157 +1108,10 @@ ASTNode* ast_create_function_call(char* name, ASTNode** args, int arg_count) {
     return node;
 }
 
-// AST 메모리 해제
+// AST 메모리 해제 (이름, 연산자, 리터럴 문자열은 렉서가 만든 심볼이므로 해제하지 않음)
 void ast_free(ASTNode* node) {
-    if (!node) return;
-    
-    switch (node->type) {
-        case AST_STRING:
-        case AST_IDENTIFIER:
-            free(node->data.string);
-            break;
-        case AST_BINARY_OP:
-            free(node->data.binary.op);
-            ast_free(node->data.binary.left);
-            ast_free(node->data.binary.right);
-            break;
-        case AST_ASSIGN:
-        case AST_LET:
-            free(node->data.assign.name);
-            ast_free(node->data.assign.value);
-            break;
-        case AST_FUNCTION_DEF:
-            free(node->data.function_def.name);
-            for (int i = 0; i < node->data.function_def.param_count; i++) {
-                free(node->data.function_def.params[i]);
-            }
-            free(node->data.function_def.params);
-            ast_free(node->data.function_def.body);
-            break;
-        case AST_FUNCTION_CALL:
-            free(node->data.function_call.name);
-            for (int i = 0; i < node->data.function_call.arg_count; i++) {
-                ast_free(node->data.function_call.args[i]);
-            }
-            free(node->data.function_call.args);
-            break;
-        case AST_IF:
-            ast_free(node->data.if_stmt.condition);
-            ast_free(node->data.if_stmt.then_branch);
-            ast_free(node->data.if_stmt.else_branch);
-            break;
-        case AST_FOR:
-            free(node->data.for_loop.iterator);
-            ast_free(node->data.for_loop.iterable);
-            ast_free(node->data.for_loop.body);
-            break;
-        case AST_WHILE:
-            ast_free(node->data.while_loop.condition);
-            ast_free(node->data.while_loop.body);
-            break;
-        case AST_RETURN:
-            ast_free(node->data.return_stmt.value);
-            break;
-        case AST_BLOCK:
-        case AST_PROGRAM:
-            for (int i = 0; i < node->data.block.statement_count; i++) {
-                ast_free(node->data.block.statements[i]);
-            }
-            free(node->data.block.statements);
-            break;
-        case AST_ARRAY:
-            for (int i = 0; i < node->data.array.element_count; i++) {
-                ast_free(node->data.array.elements[i]);
-            }
-            free(node->data.array.elements);
-            break;
-        case AST_DICT:
-            for (int i = 0; i < node->data.dict.pair_count; i++) {
-                free(node->data.dict.keys[i]);
-                ast_free(node->data.dict.values[i]);
-            }
-            free(node->data.dict.keys);
-            free(node->data.dict.values);
-            break;
-        case AST_INDEX:
-            ast_free(node->data.index.array);
-            ast_free(node->data.index.index);
-            break;
-        case AST_DOT_ACCESS:
-            ast_free(node->data.dot.object);
-            free(node->data.dot.property);
-            break;
-        case AST_CLASS:
-            free(node->data.class_def.name);
-            if (node->data.class_def.parent_class) {
-                free(node->data.class_def.parent_class);
-            }
-            for (int i = 0; i < node->data.class_def.field_count; i++) {
-                free(node->data.class_def.fields[i]);
-            }
-            free(node->data.class_def.fields);
-            for (int i = 0; i < node->data.class_def.method_count; i++) {
-                ast_free(node->data.class_def.methods[i]);
-            }
-            free(node->data.class_def.methods);
-            break;
-        case AST_NEW:
-            free(node->data.new_expr.class_name);
-            for (int i = 0; i < node->data.new_expr.arg_count; i++) {
-                ast_free(node->data.new_expr.args[i]);
-            }
-            free(node->data.new_expr.args);
-            break;
-        case AST_METHOD_CALL:
-            ast_free(node->data.method_call.object);
-            free(node->data.method_call.method_name);
-            for (int i = 0; i < node->data.method_call.arg_count; i++) {
-                ast_free(node->data.method_call.args[i]);
-            }
-            free(node->data.method_call.args);
-            break;
-        case AST_THIS:
-            // this는 메모리 해제할 것이 없음
-            break;
-        case AST_FIELD_ASSIGN:
-            ast_free(node->data.field_assign.object);
-            free(node->data.field_assign.field_name);
-            ast_free(node->data.field_assign.value);
-            break;
-        case AST_SUPER:
-            free(node->data.super_call.method_name);
-            for (int i = 0; i < node->data.super_call.arg_count; i++) {
-                ast_free(node->data.super_call.args[i]);
-            }
-            free(node->data.super_call.args);
-            break;
-        case AST_TRY_CATCH:
-            ast_free(node->data.try_catch.try_block);
-            if (node->data.try_catch.exception_type) {
-                free(node->data.try_catch.exception_type);
-            }
-            if (node->data.try_catch.exception_var) {
-                free(node->data.try_catch.exception_var);
-            }
-            if (node->data.try_catch.catch_block) {
-                ast_free(node->data.try_catch.catch_block);
-            }
-            if (node->data.try_catch.finally_block) {
-                ast_free(node->data.try_catch.finally_block);
-            }
-            break;
-        case AST_THROW:
-            ast_free(node->data.throw_stmt.exception_value);
-            break;
-        case AST_ASSERT:
-            ast_free(node->data.assert_stmt.condition);
-            if (node->data.assert_stmt.message) {
-                free(node->data.assert_stmt.message);
-            }
-            break;
-        default:
-            break;
+    // 노드와 자식 배열은 모두 아레나에 있으므로 프로그램 노드가 가진 아레나만 해제
+    if (node && node->type == AST_PROGRAM) {
+        arena_free(node->data.block.arena);
     }
-    
-    free(node);
 }
@@ -2,6 +2,7 @@
 #define PARSER_H
 
 #include "lexer.h"
+#include "arena.h"
 
 // AST 노드 타입
 typedef enum {
@@ -40,7 +41,7 @@ typedef enum {
     AST_INDEX_ASSIGN  // 배열 인덱스 할당: arr[i] = value
 } ASTNodeType;
 
-// AST 노드 구조체
+// AST 노드 구조체 (char* 필드는 모두 렉서가 만든 심볼, 포인터로 비교 가능)
 typedef struct ASTNode {
     ASTNodeType type;
     union {
@@ -92,6 +93,9 @@ typedef struct ASTNode {
         struct {
             struct ASTNode** statements;
             int statement_count;
+            Arena* arena;  // AST_PROGRAM만: 트리 전체가 들어 있는 아레나 (ast_free가 해제)
+            char** locals;     // 스코프를 여는 블록 (프로그램, 함수/메서드 본문, catch 블록)의 자리 배치 (resolver.h)
+            int local_count;
         } block;
         struct {
             struct ASTNode** elements;
@@ -174,12 +178,18 @@ typedef struct ASTNode {
         } matrix;
     } data;
     int line;  // 라인 번호
+    // 리졸버(resolver.h)가 채움: 이름을 읽는 노드 (식별자, 함수 호출, 인덱스 할당)는 이름이 있는 환경까지의
+    // 깊이와 그 안의 자리, 이름을 선언하는 노드 (let, 할당, 함수 정의, for)는 현재 환경의 자리.
+    // slot이 -1이면 정적으로 정하지 못함 (이름으로 찾음)
+    int depth;
+    int slot;
 } ASTNode;
 
 // 파서 구조체
 typedef struct {
     Lexer* lexer;
     Token* current_token;
+    Arena* arena;  // 이번 파스의 노드/배열 (parser_parse가 끝나면 프로그램 노드로 넘어감)
 } Parser;
 
 // 함수 선언
@@ -210,12 +220,13 @@ ASTNode* parser_parse_array(Parser* parser);
 ASTNode* parser_parse_dict(Parser* parser);
 ASTNode* parser_parse_class(Parser* parser);
 ASTNode* parser_parse_block(Parser* parser);
-ASTNode* ast_create_number(double value);
-ASTNode* ast_create_bool(int value);
-ASTNode* ast_create_string(char* value);
-ASTNode* ast_create_identifier(char* name);
-ASTNode* ast_create_binary(char* op, ASTNode* left, ASTNode* right);
-ASTNode* ast_create_function_call(char* name, ASTNode** args, int arg_count);
+ASTNode* ast_alloc(Arena* arena);
+ASTNode* ast_create_number(Arena* arena, double value);
+ASTNode* ast_create_bool(Arena* arena, int value);
+ASTNode* ast_create_string(Arena* arena, char* value);
+ASTNode* ast_create_identifier(Arena* arena, char* name);
+ASTNode* ast_create_binary(Arena* arena, char* op, ASTNode* left, ASTNode* right);
+ASTNode* ast_create_function_call(Arena* arena, char* name, ASTNode** args, int arg_count);
 void ast_free(ASTNode* node);
 
 #endif
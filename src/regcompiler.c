@@ -0,0 +1,648 @@
+#include "regcompiler.h"
+#include "compiler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// 전방 선언
+static void reg_compile_statement(RegCompiler* compiler, ASTNode* node);
+static void reg_compile_expression(RegCompiler* compiler, ASTNode* node, int target);
+
+// 컴파일러 생성
+static RegCompiler* reg_compiler_create(RegCompiler* enclosing) {
+    RegCompiler* compiler = (RegCompiler*)malloc(sizeof(RegCompiler));
+    compiler->enclosing = enclosing;
+    compiler->chunk = reg_chunk_create();
+    compiler->name_count = 0;
+    compiler->free_register = 0;
+    memset(compiler->assigned, 0, sizeof(compiler->assigned));
+    compiler->error = NULL;
+    return compiler;
+}
+
+// 최상위 (스크립트) 컴파일러
+static RegCompiler* root_compiler(RegCompiler* compiler) {
+    while (compiler->enclosing) compiler = compiler->enclosing;
+    return compiler;
+}
+
+// 컴파일 에러 기록 (첫 번째 에러만 유지)
+static void compiler_error(RegCompiler* compiler, const char* message) {
+    RegCompiler* root = root_compiler(compiler);
+    if (!root->error) root->error = message;
+}
+
+// ============ 레지스터 할당 ============
+
+// 이름 붙은 레지스터 찾기 (없으면 -1)
+static int resolve_name(RegCompiler* compiler, char* name) {
+    for (int i = compiler->name_count - 1; i >= 0; i--) {
+        if (strcmp(compiler->names[i], name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// 이름 붙은 레지스터 선언 (이미 있으면 그 번호)
+static int declare_name(RegCompiler* compiler, char* name) {
+    int reg = resolve_name(compiler, name);
+    if (reg >= 0) return reg;
+
+    if (compiler->name_count >= REG_MAX) {
+        compiler_error(compiler, "too many variables");
+        return REG_MAX - 1;
+    }
+    compiler->names[compiler->name_count] = name;
+    return compiler->name_count++;
+}
+
+// 임시 레지스터 할당 (해제는 free_register를 되돌려서)
+static int alloc_register(RegCompiler* compiler) {
+    if (compiler->free_register >= REG_MAX) {
+        compiler_error(compiler, "too many registers");
+        return REG_MAX - 1;
+    }
+    int reg = compiler->free_register++;
+    if (compiler->free_register > compiler->chunk->register_count) {
+        compiler->chunk->register_count = compiler->free_register;
+    }
+    return reg;
+}
+
+// 연속된 임시 레지스터 count개 (CALL/BUILTIN/NEWARRAY/PRINT 인자용), 첫 번호 반환
+static int alloc_registers(RegCompiler* compiler, int count) {
+    int base = compiler->free_register;
+    for (int i = 0; i < count; i++) {
+        alloc_register(compiler);
+    }
+    return base;
+}
+
+// 본문에서 대입되는 이름을 레지스터로 선언 (블록은 스코프를 만들지 않음, 함수 본문은 건너뜀)
+static void declare_assigned_names(RegCompiler* compiler, ASTNode* node) {
+    if (!node) return;
+
+    switch (node->type) {
+        case AST_LET:
+        case AST_ASSIGN:
+            declare_name(compiler, node->data.assign.name);
+            break;
+        case AST_FUNCTION_DEF:
+            declare_name(compiler, node->data.function_def.name);
+            break;
+        case AST_FOR:
+            declare_name(compiler, node->data.for_loop.iterator);
+            declare_assigned_names(compiler, node->data.for_loop.body);
+            break;
+        case AST_IF:
+            declare_assigned_names(compiler, node->data.if_stmt.then_branch);
+            declare_assigned_names(compiler, node->data.if_stmt.else_branch);
+            break;
+        case AST_WHILE:
+            declare_assigned_names(compiler, node->data.while_loop.body);
+            break;
+        case AST_BLOCK:
+        case AST_PROGRAM:
+            for (int i = 0; i < node->data.block.statement_count; i++) {
+                declare_assigned_names(compiler, node->data.block.statements[i]);
+            }
+            break;
+        case AST_EXPORT:
+            declare_assigned_names(compiler, node->data.export_stmt.node);
+            break;
+        default:
+            break;
+    }
+}
+
+// 대입 표시 (스크립트 전역만 의미 있음)
+static void mark_assigned(RegCompiler* compiler, int reg) {
+    if (!compiler->enclosing) compiler->assigned[reg] = 1;
+}
+
+// ============ 명령어 생성 ============
+
+static void emit_abc(RegCompiler* compiler, RegOpCode opcode, int a, int b, int c) {
+    reg_emit(compiler->chunk, RINSTR_ABC(opcode, a, b, c));
+}
+
+static void emit_abx(RegCompiler* compiler, RegOpCode opcode, int a, int bx) {
+    reg_emit(compiler->chunk, RINSTR_ABX(opcode, a, bx));
+}
+
+// 상수 추가 (limit를 넘으면 에러, 피연산자 크기에 맞춰 UINT8_MAX 또는 UINT16_MAX)
+static int add_constant(RegCompiler* compiler, VMValue value, int limit) {
+    int index = reg_add_constant(compiler->chunk, value);
+    if (index > limit) {
+        compiler_error(compiler, "too many constants");
+        return 0;
+    }
+    return index;
+}
+
+// 리터럴 → 상수
+static VMValue literal_value(ASTNode* node) {
+    if (node->type == AST_NUMBER) return NUMBER_VAL(node->data.number);
+    return OBJ_VAL(value_create_string(node->data.string));
+}
+
+// 앞으로 가는 점프 (목적지는 나중에 patch_jump), 명령어 위치 반환
+static int emit_jump(RegCompiler* compiler, uint32_t instruction) {
+    int offset = reg_emit(compiler->chunk, instruction);
+    if (reg_instruction_length(instruction) == 2) {
+        reg_emit(compiler->chunk, 0);
+    }
+    return offset;
+}
+
+// 점프 목적지를 현재 위치로
+static void patch_jump(RegCompiler* compiler, int offset) {
+    uint32_t* code = compiler->chunk->code;
+    int length = reg_instruction_length(code[offset]);
+    int jump = compiler->chunk->count - (offset + length);
+
+    if (length == 2) {
+        code[offset + 1] = (uint32_t)jump;
+    } else if (jump > INT16_MAX) {
+        compiler_error(compiler, "jump too far");
+    } else {
+        code[offset] = RINSTR_ABX(RINSTR_OP(code[offset]), RINSTR_A(code[offset]), jump);
+    }
+}
+
+// loop_start로 돌아가는 점프 (VM이 뒤로 가는 JMP에서 루프 횟수를 셈)
+static void emit_loop(RegCompiler* compiler, int loop_start) {
+    int jump = loop_start - (compiler->chunk->count + 1);
+    if (jump < INT16_MIN) {
+        compiler_error(compiler, "loop body too large");
+        jump = 0;
+    }
+    emit_abx(compiler, ROP_JMP, 0, jump);
+}
+
+// ============ 표현식 ============
+
+// 산술/비교 연산자 → opcode (없으면 -1)
+static int binary_opcode(char* op) {
+    if (strcmp(op, "+") == 0) return ROP_ADD;
+    if (strcmp(op, "-") == 0) return ROP_SUB;
+    if (strcmp(op, "*") == 0) return ROP_MUL;
+    if (strcmp(op, "/") == 0) return ROP_DIV;
+    if (strcmp(op, "%") == 0) return ROP_MOD;
+    if (strcmp(op, "//") == 0) return ROP_FLOOR_DIV;
+    if (strcmp(op, "==") == 0) return ROP_EQ;
+    if (strcmp(op, "!=") == 0) return ROP_NE;
+    if (strcmp(op, "<") == 0) return ROP_LT;
+    if (strcmp(op, "<=") == 0) return ROP_LE;
+    if (strcmp(op, ">") == 0) return ROP_GT;
+    if (strcmp(op, ">=") == 0) return ROP_GE;
+    return -1;
+}
+
+// 표현식 값이 있는 레지스터 (변수면 그 레지스터를 그대로, 아니면 임시 레지스터에 계산)
+// 호출한 쪽이 free_register를 되돌려 임시 레지스터를 해제한다.
+static int expression_register(RegCompiler* compiler, ASTNode* node) {
+    if (node->type == AST_IDENTIFIER) {
+        int reg = resolve_name(compiler, node->data.string);
+        if (reg >= 0 && (compiler->enclosing || compiler->assigned[reg])) {
+            return reg;
+        }
+    }
+
+    int reg = alloc_register(compiler);
+    reg_compile_expression(compiler, node, reg);
+    return reg;
+}
+
+// 변수 읽기 → target
+static void compile_variable(RegCompiler* compiler, char* name, int target) {
+    int reg = resolve_name(compiler, name);
+    if (reg >= 0 && (compiler->enclosing || compiler->assigned[reg])) {
+        if (reg != target) emit_abc(compiler, ROP_MOVE, target, reg, 0);
+        return;
+    }
+
+    // 전역 (함수 안이거나 아직 대입이 확실하지 않은 경우): 미정의 검사
+    RegCompiler* root = root_compiler(compiler);
+    int slot = compiler->enclosing ? resolve_name(root, name) : reg;
+    if (slot >= 0) {
+        emit_abx(compiler, ROP_GETGLOBAL, target, slot);
+        return;
+    }
+
+    // 정의된 적 없는 null은 리터럴 (인터프리터와 동일)
+    if (strcmp(name, "null") == 0) {
+        emit_abc(compiler, ROP_LOADNULL, target, 0, 0);
+        return;
+    }
+
+    // 어디서도 대입되지 않는 이름: 미정의 변수 에러는 스택 VM에 맡김
+    compiler_error(compiler, "undefined variable");
+}
+
+// print(args...) → 연속 레지스터에 모아 PRINT 한 번
+static void compile_print(RegCompiler* compiler, ASTNode* node) {
+    int saved = compiler->free_register;
+    int arg_count = node->data.function_call.arg_count;
+    if (arg_count > UINT8_MAX) {
+        compiler_error(compiler, "too many arguments");
+        return;
+    }
+
+    // 인자 하나면 변수 레지스터를 그대로 출력
+    if (arg_count == 1) {
+        int reg = expression_register(compiler, node->data.function_call.args[0]);
+        emit_abc(compiler, ROP_PRINT, reg, 1, 0);
+        compiler->free_register = saved;
+        return;
+    }
+
+    int base = alloc_registers(compiler, arg_count);
+    for (int i = 0; i < arg_count; i++) {
+        reg_compile_expression(compiler, node->data.function_call.args[i], base + i);
+    }
+    emit_abc(compiler, ROP_PRINT, base, arg_count, 0);
+    compiler->free_register = saved;
+}
+
+// 함수 호출 → target
+static void compile_call(RegCompiler* compiler, ASTNode* node, int target) {
+    char* name = node->data.function_call.name;
+    int arg_count = node->data.function_call.arg_count;
+
+    if (strcmp(name, "print") == 0) {
+        compile_print(compiler, node);
+        emit_abc(compiler, ROP_LOADNULL, target, 0, 0);
+        return;
+    }
+
+    if (arg_count > UINT8_MAX - 1) {
+        compiler_error(compiler, "too many arguments");
+        return;
+    }
+
+    int saved = compiler->free_register;
+
+    // 내장 함수는 사용자 함수보다 우선 (인터프리터와 동일)
+    int builtin = compiler_builtin_id(name);
+    if (builtin >= 0) {
+        int base = alloc_registers(compiler, arg_count > 0 ? arg_count : 1);
+        for (int i = 0; i < arg_count; i++) {
+            reg_compile_expression(compiler, node->data.function_call.args[i], base + i);
+        }
+        emit_abc(compiler, ROP_BUILTIN, base, builtin, arg_count);
+        if (base != target) emit_abc(compiler, ROP_MOVE, target, base, 0);
+        compiler->free_register = saved;
+        return;
+    }
+    if (compiler_is_interpreter_builtin(name)) {
+        compiler_error(compiler, "builtin function not available in the VM");
+        return;
+    }
+
+    // 사용자 함수: 임시 레지스터 맨 위에 함수, 인자를 놓고 CALL (그 위가 새 프레임)
+    int base = alloc_registers(compiler, arg_count + 1);
+    compile_variable(compiler, name, base);
+    for (int i = 0; i < arg_count; i++) {
+        reg_compile_expression(compiler, node->data.function_call.args[i], base + 1 + i);
+    }
+    emit_abc(compiler, ROP_CALL, base, arg_count, 0);
+    if (base != target) emit_abc(compiler, ROP_MOVE, target, base, 0);
+    compiler->free_register = saved;
+}
+
+// 표현식 → target 레지스터
+// 하위 표현식은 항상 임시 레지스터에 계산하고 마지막 명령어만 target에 쓴다 (x = (x + 1) * x 안전)
+static void reg_compile_expression(RegCompiler* compiler, ASTNode* node, int target) {
+    if (!node) return;
+    int saved = compiler->free_register;
+
+    switch (node->type) {
+        case AST_NUMBER:
+        case AST_STRING:
+            emit_abx(compiler, ROP_LOADK, target,
+                     add_constant(compiler, literal_value(node), UINT16_MAX));
+            break;
+
+        case AST_BOOL:
+            emit_abc(compiler, ROP_LOADBOOL, target, node->data.boolean ? 1 : 0, 0);
+            break;
+
+        case AST_IDENTIFIER:
+            compile_variable(compiler, node->data.string, target);
+            break;
+
+        case AST_BINARY_OP: {
+            int opcode = binary_opcode(node->data.binary.op);
+            if (opcode < 0) {
+                compiler_error(compiler, "unsupported binary operator");
+                break;
+            }
+
+            ASTNode* right = node->data.binary.right;
+            if (!right) {
+                // 파서가 오른쪽 피연산자를 비워 둔 식 (2 ** 10 등, run_file_regvm이 스택 VM으로 실행)
+                compiler_error(compiler, "unsupported expression");
+                break;
+            }
+            int left = expression_register(compiler, node->data.binary.left);
+
+            // 산술 연산의 오른쪽이 리터럴이면 상수 피연산자 (ADDK 등)
+            int is_arithmetic = opcode <= ROP_FLOOR_DIV;
+            if (is_arithmetic && (right->type == AST_NUMBER ||
+                                  (right->type == AST_STRING && opcode == ROP_ADD)) &&
+                compiler->chunk->constant_count <= UINT8_MAX) {
+                int constant = add_constant(compiler, literal_value(right), UINT8_MAX);
+                emit_abc(compiler, opcode + (ROP_ADDK - ROP_ADD), target, left, constant);
+                break;
+            }
+
+            int right_reg = expression_register(compiler, right);
+            emit_abc(compiler, opcode, target, left, right_reg);
+            break;
+        }
+
+        case AST_UNARY_OP: {
+            char* op = node->data.unary.op;
+            int operand = expression_register(compiler, node->data.unary.operand);
+            if (strcmp(op, "-") == 0) emit_abc(compiler, ROP_NEG, target, operand, 0);
+            else if (strcmp(op, "!") == 0) emit_abc(compiler, ROP_NOT, target, operand, 0);
+            else compiler_error(compiler, "unsupported unary operator");
+            break;
+        }
+
+        case AST_FUNCTION_CALL:
+            compile_call(compiler, node, target);
+            break;
+
+        case AST_ARRAY: {
+            int count = node->data.array.element_count;
+            if (count > UINT8_MAX) {
+                compiler_error(compiler, "array literal too large");
+                break;
+            }
+            int base = alloc_registers(compiler, count);
+            for (int i = 0; i < count; i++) {
+                reg_compile_expression(compiler, node->data.array.elements[i], base + i);
+            }
+            emit_abc(compiler, ROP_NEWARRAY, target, base, count);
+            break;
+        }
+
+        case AST_INDEX: {
+            int array = expression_register(compiler, node->data.index.array);
+            int index = expression_register(compiler, node->data.index.index);
+            emit_abc(compiler, ROP_INDEX, target, array, index);
+            break;
+        }
+
+        default:
+            // 지원하지 않는 표현식 (run_file_regvm이 스택 VM으로 실행)
+            compiler_error(compiler, "unsupported expression");
+            break;
+    }
+
+    compiler->free_register = saved;
+}
+
+// 조건식 + 거짓일 때 점프 (a < b는 JNLT/JNLTK 하나로), 패치할 명령어 위치 반환
+static int emit_condition_jump(RegCompiler* compiler, ASTNode* condition) {
+    int saved = compiler->free_register;
+    int jump;
+
+    if (condition->type == AST_BINARY_OP && strcmp(condition->data.binary.op, "<") == 0) {
+        ASTNode* right = condition->data.binary.right;
+        int left = expression_register(compiler, condition->data.binary.left);
+
+        if (!right) {
+            compiler_error(compiler, "unsupported expression");
+            jump = emit_jump(compiler, RINSTR_ABX(ROP_JMPF, left, 0));
+        } else if (right->type == AST_NUMBER && compiler->chunk->constant_count <= UINT8_MAX) {
+            int constant = add_constant(compiler, literal_value(right), UINT8_MAX);
+            jump = emit_jump(compiler, RINSTR_ABC(ROP_JNLTK, left, constant, 0));
+        } else {
+            int right_reg = expression_register(compiler, right);
+            jump = emit_jump(compiler, RINSTR_ABC(ROP_JNLT, left, right_reg, 0));
+        }
+    } else {
+        int reg = expression_register(compiler, condition);
+        jump = emit_jump(compiler, RINSTR_ABX(ROP_JMPF, reg, 0));
+    }
+
+    compiler->free_register = saved;
+    return jump;
+}
+
+// ============ 함수 ============
+
+// fn name(params) { body } → 별도 청크로 컴파일해서 함수 값을 target에
+static void compile_function(RegCompiler* compiler, ASTNode* node, int target) {
+    if (compiler->enclosing) {
+        compiler_error(compiler, "nested function definitions");
+        return;
+    }
+
+    int param_count = node->data.function_def.param_count;
+    if (param_count >= UINT8_MAX) {
+        compiler_error(compiler, "too many parameters");
+        return;
+    }
+
+    RegCompiler* function = reg_compiler_create(compiler);
+    function->chunk->name = strdup(node->data.function_def.name);
+    function->chunk->arity = param_count;
+
+    declare_name(function, "");
+    for (int i = 0; i < param_count; i++) {
+        declare_name(function, node->data.function_def.params[i]);
+    }
+    declare_assigned_names(function, node->data.function_def.body);
+    function->chunk->local_count = function->name_count - 1 - param_count;
+    function->free_register = function->name_count;
+    function->chunk->register_count = function->name_count;
+
+    reg_compile_statement(function, node->data.function_def.body);
+
+    // return 없이 끝나면 null 반환
+    int result = alloc_register(function);
+    emit_abc(function, ROP_LOADNULL, result, 0, 0);
+    emit_abc(function, ROP_RETURN, result, 0, 0);
+
+    RegChunk* chunk = function->chunk;
+    free(function);
+
+    // 함수 값 (인터프리터 함수와 같은 VAL_FUNCTION, 본문은 레지스터 청크)
+    Value* func = value_alloc(VAL_FUNCTION);
+    func->data.function->param_count = param_count;
+    func->data.function->params = malloc(sizeof(char*) * param_count);
+    for (int i = 0; i < param_count; i++) {
+        func->data.function->params[i] = node->data.function_def.params[i];
+    }
+    func->data.function->body = node->data.function_def.body;
+    func->data.function->closure = NULL;
+    func->data.function->chunk = NULL;
+    func->data.function->reg_chunk = chunk;
+
+    emit_abx(compiler, ROP_LOADK, target, add_constant(compiler, OBJ_VAL(func), UINT16_MAX));
+}
+
+// ============ 문장 ============
+
+// 분기/루프 본문 (본문 안의 대입은 바깥에서 확실하지 않으므로 끝나면 대입 표시를 되돌림)
+static void compile_branch(RegCompiler* compiler, ASTNode* body) {
+    uint8_t assigned[REG_MAX];
+    memcpy(assigned, compiler->assigned, sizeof(assigned));
+    reg_compile_statement(compiler, body);
+    memcpy(compiler->assigned, assigned, sizeof(assigned));
+}
+
+static void reg_compile_statement(RegCompiler* compiler, ASTNode* node) {
+    if (!node) return;
+    int saved = compiler->free_register;
+
+    switch (node->type) {
+        case AST_LET:
+        case AST_ASSIGN: {
+            // 값을 변수 레지스터에 바로 계산 (x = a + b → ADD x a b)
+            int reg = declare_name(compiler, node->data.assign.name);
+            if (node->data.assign.value) {
+                reg_compile_expression(compiler, node->data.assign.value, reg);
+            } else {
+                emit_abc(compiler, ROP_LOADNULL, reg, 0, 0);
+            }
+            mark_assigned(compiler, reg);
+            break;
+        }
+
+        case AST_IF: {
+            int jump_to_else = emit_condition_jump(compiler, node->data.if_stmt.condition);
+            compile_branch(compiler, node->data.if_stmt.then_branch);
+
+            if (node->data.if_stmt.else_branch) {
+                int jump_to_end = emit_jump(compiler, RINSTR_ABX(ROP_JMP, 0, 0));
+                patch_jump(compiler, jump_to_else);
+                compile_branch(compiler, node->data.if_stmt.else_branch);
+                patch_jump(compiler, jump_to_end);
+            } else {
+                patch_jump(compiler, jump_to_else);
+            }
+            break;
+        }
+
+        case AST_WHILE: {
+            int loop_start = compiler->chunk->count;
+            int jump_to_end = emit_condition_jump(compiler, node->data.while_loop.condition);
+            compile_branch(compiler, node->data.while_loop.body);
+            emit_loop(compiler, loop_start);
+            patch_jump(compiler, jump_to_end);
+            break;
+        }
+
+        case AST_FOR: {
+            // R[base] = 배열, R[base+1] = 인덱스, ITER가 범위 검사/요소 대입/인덱스 증가를 한 번에
+            int iterator = declare_name(compiler, node->data.for_loop.iterator);
+            int base = alloc_registers(compiler, 2);
+            reg_compile_expression(compiler, node->data.for_loop.iterable, base);
+            emit_abx(compiler, ROP_LOADK, base + 1, add_constant(compiler, NUMBER_VAL(0), UINT16_MAX));
+
+            int loop_start = emit_jump(compiler, RINSTR_ABC(ROP_ITER, base, iterator, 0));
+
+            // 본문 안에서는 반복 변수가 확실히 대입된 상태
+            uint8_t assigned[REG_MAX];
+            memcpy(assigned, compiler->assigned, sizeof(assigned));
+            mark_assigned(compiler, iterator);
+            reg_compile_statement(compiler, node->data.for_loop.body);
+            memcpy(compiler->assigned, assigned, sizeof(assigned));
+
+            emit_loop(compiler, loop_start);
+            patch_jump(compiler, loop_start);
+            break;
+        }
+
+        case AST_BLOCK:
+            for (int i = 0; i < node->data.block.statement_count; i++) {
+                reg_compile_statement(compiler, node->data.block.statements[i]);
+            }
+            break;
+
+        case AST_FUNCTION_DEF: {
+            int reg = declare_name(compiler, node->data.function_def.name);
+            compile_function(compiler, node, reg);
+            mark_assigned(compiler, reg);
+            break;
+        }
+
+        case AST_RETURN: {
+            int reg;
+            if (node->data.return_stmt.value) {
+                reg = expression_register(compiler, node->data.return_stmt.value);
+            } else {
+                reg = alloc_register(compiler);
+                emit_abc(compiler, ROP_LOADNULL, reg, 0, 0);
+            }
+            emit_abc(compiler, ROP_RETURN, reg, 0, 0);
+            break;
+        }
+
+        case AST_EXPORT:
+            reg_compile_statement(compiler, node->data.export_stmt.node);
+            break;
+
+        case AST_FUNCTION_CALL:
+            // 반환값은 버림 (print는 null도 만들지 않음)
+            if (strcmp(node->data.function_call.name, "print") == 0) {
+                compile_print(compiler, node);
+            } else {
+                reg_compile_expression(compiler, node, alloc_register(compiler));
+            }
+            break;
+
+        default: {
+            // 표현식 문장은 값을 출력 (스택 VM과 동일)
+            int reg = expression_register(compiler, node);
+            emit_abc(compiler, ROP_PRINT, reg, 1, 0);
+            break;
+        }
+    }
+
+    compiler->free_register = saved;
+}
+
+// 메인 컴파일 함수
+RegChunk* reg_compile(ASTNode* node) {
+    RegCompiler* compiler = reg_compiler_create(NULL);
+
+    // 스크립트 전역은 프로그램 전체를 미리 훑어서 레지스터를 고정 (임시 레지스터는 그 위)
+    declare_assigned_names(compiler, node);
+    compiler->free_register = compiler->name_count;
+    compiler->chunk->register_count = compiler->name_count;
+
+    if (node->type == AST_PROGRAM) {
+        for (int i = 0; i < node->data.block.statement_count; i++) {
+            reg_compile_statement(compiler, node->data.block.statements[i]);
+        }
+    } else {
+        reg_compile_statement(compiler, node);
+    }
+
+    emit_abc(compiler, ROP_HALT, 0, 0, 0);
+
+    RegChunk* chunk = compiler->chunk;
+    if (compiler->error) {
+        fprintf(stderr, "Register compile error: %s\n", compiler->error);
+        reg_chunk_free(chunk);
+        free(compiler);
+        return NULL;
+    }
+
+    // 전역 이름표 (에러 메시지/디스어셈블용)
+    chunk->global_count = compiler->name_count;
+    chunk->global_names = (char**)malloc(sizeof(char*) * (chunk->global_count > 0 ? chunk->global_count : 1));
+    for (int i = 0; i < chunk->global_count; i++) {
+        chunk->global_names[i] = strdup(compiler->names[i]);
+    }
+
+    free(compiler);
+    return chunk;
+}
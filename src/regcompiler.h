@@ -0,0 +1,31 @@
+#ifndef REGCOMPILER_H
+#define REGCOMPILER_H
+
+#include <stdint.h>
+#include "parser.h"
+#include "regvm.h"
+
+// 레지스터 컴파일러 (함수마다 하나, enclosing으로 스크립트 컴파일러 연결)
+//
+// 이름 붙은 변수는 고정 레지스터에 산다:
+//  - 스크립트: 전역 변수 (R[0]..R[global_count-1], 함수에서는 GETGLOBAL로 읽음)
+//  - 함수: R[0] = 호출된 함수, R[1..arity] = 인자, 그 다음 = 본문에서 대입되는 지역 변수
+// 그 위는 임시 레지스터로 스택처럼 할당/해제한다.
+typedef struct RegCompiler {
+    struct RegCompiler* enclosing;
+    RegChunk* chunk;
+
+    char* names[REG_MAX];      // 이름 붙은 레지스터
+    int name_count;
+    int free_register;         // 다음 임시 레지스터
+
+    // 스크립트 전역이 이 지점에서 확실히 대입됐는지 (그렇다면 미정의 검사 없이 레지스터를 직접 읽음)
+    uint8_t assigned[REG_MAX];
+
+    const char* error;         // 지원하지 않는 구문 (최상위 컴파일러에 기록)
+} RegCompiler;
+
+// AST → 레지스터 코드 (지원하지 않는 구문이 있으면 NULL, 스택 VM으로 실행)
+RegChunk* reg_compile(ASTNode* node);
+
+#endif
@@ -0,0 +1,829 @@
+#include "regvm.h"
+#include "gc.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// ============ 레지스터 청크 ============
+
+// 레지스터 청크 생성
+RegChunk* reg_chunk_create() {
+    RegChunk* chunk = (RegChunk*)malloc(sizeof(RegChunk));
+    chunk->code = NULL;
+    chunk->count = 0;
+    chunk->capacity = 0;
+
+    chunk->constants = NULL;
+    chunk->constant_count = 0;
+    chunk->constant_capacity = 0;
+
+    chunk->global_names = NULL;
+    chunk->global_count = 0;
+
+    chunk->name = NULL;
+    chunk->arity = 0;
+    chunk->local_count = 0;
+    chunk->register_count = 0;
+
+    return chunk;
+}
+
+// 레지스터 청크 해제 (함수 상수의 청크도 함께)
+void reg_chunk_free(RegChunk* chunk) {
+    if (!chunk) return;
+
+    free(chunk->code);
+
+    for (int i = 0; i < chunk->constant_count; i++) {
+        VMValue constant = chunk->constants[i];
+        if (!IS_OBJ(constant)) continue;
+
+        Value* value = AS_OBJ(constant);
+        if (value->type == VAL_FUNCTION && value->data.function->reg_chunk) {
+            reg_chunk_free(value->data.function->reg_chunk);
+            value->data.function->reg_chunk = NULL;
+        }
+        value_free(value);
+    }
+    free(chunk->constants);
+
+    for (int i = 0; i < chunk->global_count; i++) {
+        free(chunk->global_names[i]);
+    }
+    free(chunk->global_names);
+    free(chunk->name);
+
+    free(chunk);
+}
+
+// 명령어 워드 추가 (워드 위치 반환)
+int reg_emit(RegChunk* chunk, uint32_t instruction) {
+    if (chunk->count >= chunk->capacity) {
+        int old_capacity = chunk->capacity;
+        chunk->capacity = old_capacity < 8 ? 8 : old_capacity * 2;
+        chunk->code = (uint32_t*)realloc(chunk->code, sizeof(uint32_t) * chunk->capacity);
+    }
+
+    chunk->code[chunk->count] = instruction;
+    return chunk->count++;
+}
+
+// 상수 추가
+int reg_add_constant(RegChunk* chunk, VMValue value) {
+    if (chunk->constant_count >= chunk->constant_capacity) {
+        int old_capacity = chunk->constant_capacity;
+        chunk->constant_capacity = old_capacity < 8 ? 8 : old_capacity * 2;
+        chunk->constants = (VMValue*)realloc(chunk->constants,
+                                             sizeof(VMValue) * chunk->constant_capacity);
+    }
+
+    if (IS_OBJ(value)) gc_pin(AS_OBJ(value));  // 객체 상수는 GC에서 고정
+    chunk->constants[chunk->constant_count] = value;
+    return chunk->constant_count++;
+}
+
+// 명령어 길이 (워드 수, 점프 오프셋 확장 워드 포함)
+int reg_instruction_length(uint32_t instruction) {
+    switch (RINSTR_OP(instruction)) {
+        case ROP_JNLT:
+        case ROP_JNLTK:
+        case ROP_ITER:
+            return 2;
+        default:
+            return 1;
+    }
+}
+
+static const char* reg_opcode_names[ROP_COUNT] = {
+    [ROP_MOVE]       = "MOVE",
+    [ROP_LOADK]      = "LOADK",
+    [ROP_LOADNULL]   = "LOADNULL",
+    [ROP_LOADBOOL]   = "LOADBOOL",
+    [ROP_GETGLOBAL]  = "GETGLOBAL",
+    [ROP_ADD]        = "ADD",
+    [ROP_SUB]        = "SUB",
+    [ROP_MUL]        = "MUL",
+    [ROP_DIV]        = "DIV",
+    [ROP_MOD]        = "MOD",
+    [ROP_FLOOR_DIV]  = "FLOOR_DIV",
+    [ROP_ADDK]       = "ADDK",
+    [ROP_SUBK]       = "SUBK",
+    [ROP_MULK]       = "MULK",
+    [ROP_DIVK]       = "DIVK",
+    [ROP_MODK]       = "MODK",
+    [ROP_FLOOR_DIVK] = "FLOOR_DIVK",
+    [ROP_NEG]        = "NEG",
+    [ROP_NOT]        = "NOT",
+    [ROP_EQ]         = "EQ",
+    [ROP_NE]         = "NE",
+    [ROP_LT]         = "LT",
+    [ROP_LE]         = "LE",
+    [ROP_GT]         = "GT",
+    [ROP_GE]         = "GE",
+    [ROP_NEWARRAY]   = "NEWARRAY",
+    [ROP_INDEX]      = "INDEX",
+    [ROP_JMP]        = "JMP",
+    [ROP_JMPF]       = "JMPF",
+    [ROP_JMPT]       = "JMPT",
+    [ROP_JNLT]       = "JNLT",
+    [ROP_JNLTK]      = "JNLTK",
+    [ROP_ITER]       = "ITER",
+    [ROP_CALL]       = "CALL",
+    [ROP_BUILTIN]    = "BUILTIN",
+    [ROP_RETURN]     = "RETURN",
+    [ROP_PRINT]      = "PRINT",
+    [ROP_HALT]       = "HALT",
+};
+
+const char* reg_opcode_name(RegOpCode opcode) {
+    if (opcode >= ROP_COUNT) return "UNKNOWN";
+    return reg_opcode_names[opcode];
+}
+
+// 점프 명령어의 목적지 워드 (점프가 아니면 -1)
+static int reg_jump_target(RegChunk* chunk, int offset) {
+    uint32_t instruction = chunk->code[offset];
+    switch (RINSTR_OP(instruction)) {
+        case ROP_JMP:
+        case ROP_JMPF:
+        case ROP_JMPT:
+            return offset + 1 + RINSTR_SBX(instruction);
+        case ROP_JNLT:
+        case ROP_JNLTK:
+        case ROP_ITER:
+            return offset + 2 + (int32_t)chunk->code[offset + 1];
+        default:
+            return -1;
+    }
+}
+
+// 청크 안의 함수 상수 (없으면 NULL)
+static RegChunk* function_constant(RegChunk* chunk, int index) {
+    VMValue constant = chunk->constants[index];
+    return IS_OBJ_TYPE(constant, VAL_FUNCTION) ? AS_OBJ(constant)->data.function->reg_chunk : NULL;
+}
+
+// 청크 하나 디스어셈블 (전역 이름은 스크립트 청크에서 가져옴)
+static void disassemble_chunk(RegChunk* chunk, const char* name, RegChunk* script) {
+    printf("== %s (%d words, %d registers) ==\n", name, chunk->count, chunk->register_count);
+
+    for (int offset = 0; offset < chunk->count;
+         offset += reg_instruction_length(chunk->code[offset])) {
+        uint32_t instruction = chunk->code[offset];
+        RegOpCode opcode = (RegOpCode)RINSTR_OP(instruction);
+        int a = RINSTR_A(instruction);
+        int b = RINSTR_B(instruction);
+        int c = RINSTR_C(instruction);
+        printf("%04d  %-12s", offset, reg_opcode_name(opcode));
+
+        switch (opcode) {
+            case ROP_LOADK:
+                printf(" r%d K%d (", a, RINSTR_BX(instruction));
+                vm_value_print(chunk->constants[RINSTR_BX(instruction)]);
+                printf(")");
+                break;
+
+            case ROP_GETGLOBAL:
+                printf(" r%d G%d (%s)", a, RINSTR_BX(instruction),
+                       script->global_names[RINSTR_BX(instruction)]);
+                break;
+
+            case ROP_LOADNULL:
+            case ROP_RETURN:
+                printf(" r%d", a);
+                break;
+
+            case ROP_LOADBOOL:
+                printf(" r%d %s", a, b ? "true" : "false");
+                break;
+
+            case ROP_MOVE:
+            case ROP_NEG:
+            case ROP_NOT:
+                printf(" r%d r%d", a, b);
+                break;
+
+            case ROP_ADDK:
+            case ROP_SUBK:
+            case ROP_MULK:
+            case ROP_DIVK:
+            case ROP_MODK:
+            case ROP_FLOOR_DIVK:
+                printf(" r%d r%d K%d (", a, b, c);
+                vm_value_print(chunk->constants[c]);
+                printf(")");
+                break;
+
+            case ROP_NEWARRAY:
+                printf(" r%d r%d %d", a, b, c);
+                break;
+
+            case ROP_JMP:
+                printf(" %+d -> %04d", RINSTR_SBX(instruction), reg_jump_target(chunk, offset));
+                break;
+
+            case ROP_JMPF:
+            case ROP_JMPT:
+                printf(" r%d -> %04d", a, reg_jump_target(chunk, offset));
+                break;
+
+            case ROP_JNLT:
+                printf(" r%d r%d -> %04d", a, b, reg_jump_target(chunk, offset));
+                break;
+
+            case ROP_JNLTK:
+                printf(" r%d K%d (", a, b);
+                vm_value_print(chunk->constants[b]);
+                printf(") -> %04d", reg_jump_target(chunk, offset));
+                break;
+
+            case ROP_ITER:
+                printf(" r%d r%d -> %04d", a, b, reg_jump_target(chunk, offset));
+                break;
+
+            case ROP_CALL:
+            case ROP_PRINT:
+                printf(" r%d %d", a, b);
+                break;
+
+            case ROP_BUILTIN:
+                printf(" r%d %s/%d", a, b == BUILTIN_LEN ? "len" : "range", c);
+                break;
+
+            case ROP_HALT:
+                break;
+
+            default:
+                printf(" r%d r%d r%d", a, b, c);
+                break;
+        }
+
+        printf("\n");
+    }
+
+    printf("\n");
+
+    // 함수 본문
+    for (int i = 0; i < chunk->constant_count; i++) {
+        RegChunk* function = function_constant(chunk, i);
+        if (function) {
+            disassemble_chunk(function, function->name, script);
+        }
+    }
+}
+
+// 레지스터 코드 디스어셈블 (디버깅용, 함수 청크 포함)
+void reg_disassemble(RegChunk* chunk, const char* name) {
+    disassemble_chunk(chunk, name, chunk);
+}
+
+// 레지스터 코드 검증 (실행 전 한 번만, 통과하면 VM은 레지스터/ip 범위 검사 없이 실행)
+//  - opcode가 유효하고 레지스터 번호가 register_count 안, 상수/전역/내장 함수 번호가 범위 안
+//  - 점프 목적지는 명령어 경계, JMP 외의 점프는 앞으로만 (루프 횟수 검사는 뒤로 가는 JMP에서만)
+//  - 마지막 명령어는 HALT/RETURN
+static int verify_chunk(RegChunk* chunk, RegChunk* script) {
+    uint8_t* is_start = (uint8_t*)calloc(chunk->count + 1, 1);
+    int last = -1;
+    int ok = 1;
+
+    for (int offset = 0; offset < chunk->count && ok;
+         offset += reg_instruction_length(chunk->code[offset])) {
+        uint32_t instruction = chunk->code[offset];
+        if (RINSTR_OP(instruction) >= ROP_COUNT) {
+            fprintf(stderr, "Register code error at %04d: invalid opcode %d\n",
+                    offset, RINSTR_OP(instruction));
+            ok = 0;
+        } else if (offset + reg_instruction_length(instruction) > chunk->count) {
+            fprintf(stderr, "Register code error at %04d: truncated instruction\n", offset);
+            ok = 0;
+        } else {
+            is_start[offset] = 1;
+            last = offset;
+        }
+    }
+
+    if (ok && (last < 0 || (RINSTR_OP(chunk->code[last]) != ROP_HALT &&
+                            RINSTR_OP(chunk->code[last]) != ROP_RETURN))) {
+        fprintf(stderr, "Register code error: chunk must end with HALT or RETURN\n");
+        ok = 0;
+    }
+
+    int registers = chunk->register_count;
+    for (int offset = 0; offset < chunk->count && ok;
+         offset += reg_instruction_length(chunk->code[offset])) {
+        uint32_t instruction = chunk->code[offset];
+        RegOpCode opcode = (RegOpCode)RINSTR_OP(instruction);
+        int a = RINSTR_A(instruction);
+        int b = RINSTR_B(instruction);
+        int c = RINSTR_C(instruction);
+        int bad_register = 0;
+        int bad_constant = 0;
+
+        switch (opcode) {
+            case ROP_MOVE:
+            case ROP_NEG:
+            case ROP_NOT:
+                bad_register = a >= registers || b >= registers;
+                break;
+            case ROP_LOADK:
+                bad_register = a >= registers;
+                bad_constant = RINSTR_BX(instruction) >= chunk->constant_count;
+                break;
+            case ROP_LOADNULL:
+            case ROP_LOADBOOL:
+            case ROP_RETURN:
+            case ROP_JMPF:
+            case ROP_JMPT:
+                bad_register = a >= registers;
+                break;
+            case ROP_GETGLOBAL:
+                bad_register = a >= registers;
+                if (RINSTR_BX(instruction) >= script->global_count) {
+                    fprintf(stderr, "Register code error at %04d: global slot %d out of range\n",
+                            offset, RINSTR_BX(instruction));
+                    ok = 0;
+                }
+                break;
+            case ROP_ADDK:
+            case ROP_SUBK:
+            case ROP_MULK:
+            case ROP_DIVK:
+            case ROP_MODK:
+            case ROP_FLOOR_DIVK:
+                bad_register = a >= registers || b >= registers;
+                bad_constant = c >= chunk->constant_count;
+                break;
+            case ROP_JNLTK:
+                bad_register = a >= registers;
+                bad_constant = b >= chunk->constant_count;
+                break;
+            case ROP_JNLT:
+                bad_register = a >= registers || b >= registers;
+                break;
+            case ROP_ITER:
+                bad_register = a + 1 >= registers || b >= registers;
+                break;
+            case ROP_NEWARRAY:
+                bad_register = a >= registers || b + c > registers;
+                break;
+            case ROP_CALL:
+                bad_register = a + b >= registers;
+                break;
+            case ROP_PRINT:
+                bad_register = a >= registers || a + b > registers;
+                break;
+            case ROP_BUILTIN:
+                bad_register = a >= registers || a + c > registers;
+                if (b > BUILTIN_RANGE) {
+                    fprintf(stderr, "Register code error at %04d: unknown builtin %d\n", offset, b);
+                    ok = 0;
+                }
+                break;
+            case ROP_HALT:
+            case ROP_JMP:
+            case ROP_COUNT:
+                break;
+            default:
+                bad_register = a >= registers || b >= registers || c >= registers;
+                break;
+        }
+
+        if (bad_register) {
+            fprintf(stderr, "Register code error at %04d: register out of range\n", offset);
+            ok = 0;
+        }
+        if (bad_constant) {
+            fprintf(stderr, "Register code error at %04d: constant index out of range\n", offset);
+            ok = 0;
+        }
+
+        int is_jump = opcode == ROP_JMP || opcode == ROP_JMPF || opcode == ROP_JMPT ||
+                      reg_instruction_length(instruction) == 2;
+        if (ok && is_jump) {
+            int target = reg_jump_target(chunk, offset);
+            if (target < 0 || target >= chunk->count || !is_start[target] ||
+                (opcode != ROP_JMP && target <= offset)) {
+                fprintf(stderr, "Register code error at %04d: bad jump target %d\n", offset, target);
+                ok = 0;
+            }
+        }
+    }
+
+    free(is_start);
+
+    for (int i = 0; i < chunk->constant_count && ok; i++) {
+        RegChunk* function = function_constant(chunk, i);
+        if (function) {
+            ok = verify_chunk(function, script);
+        }
+    }
+
+    return ok;
+}
+
+int reg_verify(RegChunk* chunk) {
+    if (chunk->register_count < chunk->global_count || chunk->register_count > REG_MAX) {
+        fprintf(stderr, "Register code error: bad register count %d\n", chunk->register_count);
+        return 0;
+    }
+    return verify_chunk(chunk, chunk);
+}
+
+// ============ 레지스터 VM ============
+
+// GC 루트: 프레임 창들이 덮는 레지스터 (스크립트 프레임 앞부분의 전역 변수 포함)
+// 창은 들어갈 때 모두 채우므로 창 안의 레지스터에는 지난 수집에서 해제된 값이 남아 있지 않다.
+static void mark_regvm_roots(void* context) {
+    RegVM* vm = (RegVM*)context;
+    int top = 0;
+    for (int i = 0; i < vm->frame_count; i++) {
+        int end = vm->frames[i].base + vm->frames[i].chunk->register_count;
+        if (end > top) top = end;
+    }
+    for (int r = 0; r < top; r++) {
+        if (IS_OBJ(vm->registers[r])) gc_mark_value(AS_OBJ(vm->registers[r]));
+    }
+}
+
+// VM 생성
+RegVM* regvm_create() {
+    RegVM* vm = (RegVM*)malloc(sizeof(RegVM));
+    vm->chunk = NULL;
+    vm->registers = (VMValue*)malloc(sizeof(VMValue) * REG_STACK_MAX);
+    vm->frame_count = 0;
+    vm->max_loop_iterations = VM_DEFAULT_MAX_LOOPS;
+
+    gc_add_roots(mark_regvm_roots, vm);
+    return vm;
+}
+
+// VM 해제
+void regvm_free(RegVM* vm) {
+    if (!vm) return;
+
+    gc_remove_roots(mark_regvm_roots, vm);
+    free(vm->registers);
+    free(vm);
+}
+
+// 산술 연산 (숫자가 아닌 경우와 0으로 나누기까지 스택 VM의 vm_binary_op 그대로, 에러는 vm_runtime_error)
+static VMValue arithmetic(RegOpCode opcode, VMValue left, VMValue right) {
+    static const OpCode opcodes[] = { OP_ADD, OP_SUBTRACT, OP_MULTIPLY, OP_DIVIDE, OP_MODULO, OP_FLOOR_DIV };
+
+    // 상수 변형은 레지스터 변형과 같은 연산
+    if (opcode >= ROP_ADDK) opcode -= ROP_ADDK - ROP_ADD;
+    return vm_binary_op(opcodes[opcode - ROP_ADD], left, right);
+}
+
+// 숫자 비교 에러
+static void comparison_error(RegOpCode opcode) {
+    static const OpCode opcodes[] = { OP_LESS, OP_LESS_EQUAL, OP_GREATER, OP_GREATER_EQUAL };
+    vm_runtime_error("TypeError", "unsupported operand types for %s", vm_operator_symbol(opcodes[opcode - ROP_LT]));
+}
+
+// 디스패치 방식은 스택 VM과 같음 (기본 스레디드, make DISPATCH=switch면 switch 루프)
+#if defined(__GNUC__) && !defined(VM_SWITCH_DISPATCH)
+#define VM_THREADED_DISPATCH 1
+#endif
+
+#ifdef VM_THREADED_DISPATCH
+#define VM_CASE(op) L_##op
+#define DISPATCH() do { instruction = *ip++; goto *dispatch_table[RINSTR_OP(instruction)]; } while (0)
+#else
+#define VM_CASE(op) case op
+#define DISPATCH() continue
+#endif
+
+// 현재 명령어의 피연산자
+#define RA (R[RINSTR_A(instruction)])
+#define RB (R[RINSTR_B(instruction)])
+#define RC (R[RINSTR_C(instruction)])
+#define KB (K[RINSTR_B(instruction)])
+#define KC (K[RINSTR_C(instruction)])
+
+// 숫자면 바로 계산, 아니면 arithmetic()에서 문자열 연산/에러 처리
+#define ARITH_OP(right, op) { \
+    VMValue left_value = RB; \
+    VMValue right_value = (right); \
+    if (IS_NUMBER(left_value) && IS_NUMBER(right_value)) { \
+        RA = NUMBER_VAL(AS_NUMBER(left_value) op AS_NUMBER(right_value)); \
+    } else { \
+        RA = arithmetic((RegOpCode)RINSTR_OP(instruction), left_value, right_value); \
+    } \
+    DISPATCH(); \
+}
+
+#define COMPARE_OP(op) { \
+    VMValue left_value = RB; \
+    VMValue right_value = RC; \
+    if (!IS_NUMBER(left_value) || !IS_NUMBER(right_value)) { \
+        comparison_error((RegOpCode)RINSTR_OP(instruction)); \
+    } \
+    RA = BOOL_VAL(AS_NUMBER(left_value) op AS_NUMBER(right_value)); \
+    DISPATCH(); \
+}
+
+// VM 실행
+int regvm_run(RegVM* vm, RegChunk* chunk) {
+    // 레지스터 번호/점프 대상/HALT 종료를 미리 검증 (실행 중에는 범위 검사 없음)
+    if (!reg_verify(chunk)) {
+        fprintf(stderr, "Invalid register code, refusing to run\n");
+        return 0;
+    }
+
+    vm->chunk = chunk;
+
+    // 스크립트 프레임: 앞쪽 레지스터는 전역 변수 (대입 전에는 미정의), 나머지는 임시 레지스터
+    for (int r = 0; r < chunk->register_count; r++) {
+        vm->registers[r] = r < chunk->global_count ? UNDEFINED_VAL : NULL_VAL;
+    }
+
+    RegFrame* frame = &vm->frames[0];
+    frame->chunk = chunk;
+    frame->ip = chunk->code;
+    frame->base = 0;
+    vm->frame_count = 1;
+
+    uint32_t* ip = chunk->code;
+    VMValue* R = vm->registers;      // 현재 프레임의 레지스터 창
+    VMValue* K = chunk->constants;   // 현재 청크의 상수 풀
+    uint32_t instruction;
+    long loop_count = 0;             // 뒤로 가는 점프 횟수
+
+#ifdef VM_THREADED_DISPATCH
+    static void* dispatch_table[] = {
+        [ROP_MOVE]       = &&L_ROP_MOVE,
+        [ROP_LOADK]      = &&L_ROP_LOADK,
+        [ROP_LOADNULL]   = &&L_ROP_LOADNULL,
+        [ROP_LOADBOOL]   = &&L_ROP_LOADBOOL,
+        [ROP_GETGLOBAL]  = &&L_ROP_GETGLOBAL,
+        [ROP_ADD]        = &&L_ROP_ADD,
+        [ROP_SUB]        = &&L_ROP_SUB,
+        [ROP_MUL]        = &&L_ROP_MUL,
+        [ROP_DIV]        = &&L_ROP_DIV,
+        [ROP_MOD]        = &&L_ROP_MOD,
+        [ROP_FLOOR_DIV]  = &&L_ROP_FLOOR_DIV,
+        [ROP_ADDK]       = &&L_ROP_ADDK,
+        [ROP_SUBK]       = &&L_ROP_SUBK,
+        [ROP_MULK]       = &&L_ROP_MULK,
+        [ROP_DIVK]       = &&L_ROP_DIVK,
+        [ROP_MODK]       = &&L_ROP_MODK,
+        [ROP_FLOOR_DIVK] = &&L_ROP_FLOOR_DIVK,
+        [ROP_NEG]        = &&L_ROP_NEG,
+        [ROP_NOT]        = &&L_ROP_NOT,
+        [ROP_EQ]         = &&L_ROP_EQ,
+        [ROP_NE]         = &&L_ROP_NE,
+        [ROP_LT]         = &&L_ROP_LT,
+        [ROP_LE]         = &&L_ROP_LE,
+        [ROP_GT]         = &&L_ROP_GT,
+        [ROP_GE]         = &&L_ROP_GE,
+        [ROP_NEWARRAY]   = &&L_ROP_NEWARRAY,
+        [ROP_INDEX]      = &&L_ROP_INDEX,
+        [ROP_JMP]        = &&L_ROP_JMP,
+        [ROP_JMPF]       = &&L_ROP_JMPF,
+        [ROP_JMPT]       = &&L_ROP_JMPT,
+        [ROP_JNLT]       = &&L_ROP_JNLT,
+        [ROP_JNLTK]      = &&L_ROP_JNLTK,
+        [ROP_ITER]       = &&L_ROP_ITER,
+        [ROP_CALL]       = &&L_ROP_CALL,
+        [ROP_BUILTIN]    = &&L_ROP_BUILTIN,
+        [ROP_RETURN]     = &&L_ROP_RETURN,
+        [ROP_PRINT]      = &&L_ROP_PRINT,
+        [ROP_HALT]       = &&L_ROP_HALT,
+    };
+
+    DISPATCH();
+#else
+    for (;;) {
+        instruction = *ip++;
+        switch (RINSTR_OP(instruction)) {
+#endif
+            VM_CASE(ROP_MOVE):
+                RA = RB;
+                DISPATCH();
+
+            VM_CASE(ROP_LOADK):
+                RA = K[RINSTR_BX(instruction)];
+                DISPATCH();
+
+            VM_CASE(ROP_LOADNULL):
+                RA = NULL_VAL;
+                DISPATCH();
+
+            VM_CASE(ROP_LOADBOOL):
+                RA = BOOL_VAL(RINSTR_B(instruction));
+                DISPATCH();
+
+            VM_CASE(ROP_GETGLOBAL): {
+                VMValue value = vm->registers[RINSTR_BX(instruction)];
+                if (IS_UNDEFINED(value)) {
+                    vm_runtime_error("NameError", "name '%s' is not defined",
+                                     vm->chunk->global_names[RINSTR_BX(instruction)]);
+                }
+                RA = value;
+                DISPATCH();
+            }
+
+            VM_CASE(ROP_ADD):  ARITH_OP(RC, +)
+            VM_CASE(ROP_SUB):  ARITH_OP(RC, -)
+            VM_CASE(ROP_MUL):  ARITH_OP(RC, *)
+            VM_CASE(ROP_ADDK): ARITH_OP(KC, +)
+            VM_CASE(ROP_SUBK): ARITH_OP(KC, -)
+            VM_CASE(ROP_MULK): ARITH_OP(KC, *)
+
+            // 0으로 나누기 검사가 있는 연산은 항상 arithmetic()
+            VM_CASE(ROP_DIV):
+            VM_CASE(ROP_MOD):
+            VM_CASE(ROP_FLOOR_DIV):
+                RA = arithmetic((RegOpCode)RINSTR_OP(instruction), RB, RC);
+                DISPATCH();
+
+            VM_CASE(ROP_DIVK):
+            VM_CASE(ROP_MODK):
+            VM_CASE(ROP_FLOOR_DIVK):
+                RA = arithmetic((RegOpCode)RINSTR_OP(instruction), RB, KC);
+                DISPATCH();
+
+            VM_CASE(ROP_NEG): {
+                VMValue value = RB;
+                RA = IS_NUMBER(value) ? NUMBER_VAL(-AS_NUMBER(value)) : vm_unary_op(OP_NEGATE, value);
+                DISPATCH();
+            }
+
+            VM_CASE(ROP_NOT): {
+                VMValue value = RB;
+                int result = 0;
+                if (IS_BOOL(value)) {
+                    result = !AS_BOOL(value);
+                } else if (IS_NUMBER(value)) {
+                    result = (AS_NUMBER(value) == 0);
+                }
+                RA = BOOL_VAL(result);
+                DISPATCH();
+            }
+
+            VM_CASE(ROP_EQ):
+                RA = BOOL_VAL(vm_values_equal(RB, RC));
+                DISPATCH();
+
+            VM_CASE(ROP_NE):
+                RA = BOOL_VAL(!vm_values_equal(RB, RC));
+                DISPATCH();
+
+            VM_CASE(ROP_LT): COMPARE_OP(<)
+            VM_CASE(ROP_LE): COMPARE_OP(<=)
+            VM_CASE(ROP_GT): COMPARE_OP(>)
+            VM_CASE(ROP_GE): COMPARE_OP(>=)
+
+            VM_CASE(ROP_NEWARRAY): {
+                int size = RINSTR_C(instruction);
+                VMValue* values = &RB;
+                Value** elements = (Value**)malloc(sizeof(Value*) * (size > 0 ? size : 1));
+                for (int k = 0; k < size; k++) {
+                    elements[k] = vm_value_to_heap(values[k]);
+                }
+                RA = OBJ_VAL(value_create_array(elements, size));
+                DISPATCH();
+            }
+
+            VM_CASE(ROP_INDEX):
+                RA = vm_index_value(RB, RC);
+                DISPATCH();
+
+            VM_CASE(ROP_JMP): {
+                int offset = RINSTR_SBX(instruction);
+
+                // 무한 루프 방지는 뒤로 가는 점프에서만 검사
+                if (offset < 0 && vm->max_loop_iterations > 0 &&
+                    ++loop_count > vm->max_loop_iterations) {
+                    fprintf(stderr, "Too many loop iterations (%ld)! Possible infinite loop.\n",
+                            vm->max_loop_iterations);
+                    return 1;
+                }
+                ip += offset;
+                if (offset < 0) gc_safepoint();  // 살아 있는 값은 모두 레지스터 창에 있음
+                DISPATCH();
+            }
+
+            VM_CASE(ROP_JMPF):
+                if (vm_is_falsey(RA)) ip += RINSTR_SBX(instruction);
+                DISPATCH();
+
+            VM_CASE(ROP_JMPT):
+                if (!vm_is_falsey(RA)) ip += RINSTR_SBX(instruction);
+                DISPATCH();
+
+            VM_CASE(ROP_JNLT): {
+                VMValue left = RA;
+                VMValue right = RB;
+                int32_t offset = (int32_t)*ip++;
+                if (!IS_NUMBER(left) || !IS_NUMBER(right)) comparison_error(ROP_LT);
+                if (!(AS_NUMBER(left) < AS_NUMBER(right))) ip += offset;
+                DISPATCH();
+            }
+
+            VM_CASE(ROP_JNLTK): {
+                VMValue left = RA;
+                VMValue right = KB;
+                int32_t offset = (int32_t)*ip++;
+                if (!IS_NUMBER(left) || !IS_NUMBER(right)) comparison_error(ROP_LT);
+                if (!(AS_NUMBER(left) < AS_NUMBER(right))) ip += offset;
+                DISPATCH();
+            }
+
+            VM_CASE(ROP_ITER): {
+                VMValue* iterator = &RA;
+                int32_t offset = (int32_t)*ip++;
+                int index = (int)AS_NUMBER(iterator[1]);
+
+                if (index >= vm_length(iterator[0])) {
+                    ip += offset;
+                } else {
+                    RB = vm_index_value(iterator[0], iterator[1]);
+                    iterator[1] = NUMBER_VAL(index + 1);
+                }
+                DISPATCH();
+            }
+
+            // ===== 함수 호출 =====
+
+            VM_CASE(ROP_CALL): {
+                int arg_count = RINSTR_B(instruction);
+                VMValue callee = RA;
+
+                if (!IS_OBJ_TYPE(callee, VAL_FUNCTION) || !AS_OBJ(callee)->data.function->reg_chunk) {
+                    vm_runtime_error("TypeError", "value is not callable");
+                }
+                RegChunk* function = AS_OBJ(callee)->data.function->reg_chunk;
+                int base = frame->base + RINSTR_A(instruction);
+
+                if (vm->frame_count >= FRAMES_MAX || base + function->register_count > REG_STACK_MAX) {
+                    vm_runtime_error("RecursionError", "maximum recursion depth exceeded");
+                }
+
+                // 새 프레임의 R[0]은 함수, R[1..]은 이미 놓인 인자
+                // 모자란 인자, 지역 변수, 임시 레지스터는 null (남는 인자는 지역 변수 자리에서 덮어씀)
+                // 임시 레지스터까지 채워야 GC가 창을 훑을 때 이전 호출이 남긴 값을 보지 않는다
+                VMValue* callee_registers = &RA;
+                int first_null = arg_count < function->arity ? arg_count + 1 : function->arity + 1;
+                for (int r = first_null; r < function->register_count; r++) {
+                    callee_registers[r] = NULL_VAL;
+                }
+
+                frame->ip = ip;
+                frame = &vm->frames[vm->frame_count++];
+                frame->chunk = function;
+                frame->base = base;
+
+                ip = function->code;
+                R = callee_registers;
+                K = function->constants;
+                gc_safepoint();
+                DISPATCH();
+            }
+
+            VM_CASE(ROP_RETURN): {
+                VMValue result = RA;
+
+                // 스크립트 최상위의 return은 프로그램 종료
+                if (--vm->frame_count == 0) {
+                    return 1;
+                }
+
+                // 반환값은 호출한 쪽의 CALL A 레지스터 (= 이 프레임의 R[0])
+                R[0] = result;
+
+                frame = &vm->frames[vm->frame_count - 1];
+                ip = frame->ip;
+                R = &vm->registers[frame->base];
+                K = frame->chunk->constants;
+                DISPATCH();
+            }
+
+            VM_CASE(ROP_BUILTIN):
+                RA = vm_call_builtin(RINSTR_B(instruction), &RA, RINSTR_C(instruction));
+                DISPATCH();
+
+            VM_CASE(ROP_PRINT): {
+                VMValue* values = &RA;
+                int count = RINSTR_B(instruction);
+                for (int k = 0; k < count; k++) {
+                    vm_value_print(values[k]);
+                    if (k < count - 1) printf(" ");
+                }
+                printf("\n");
+                DISPATCH();
+            }
+
+            VM_CASE(ROP_HALT):
+                return 1;
+
+#ifndef VM_THREADED_DISPATCH
+            default:
+                fprintf(stderr, "Unknown opcode: %d\n", RINSTR_OP(instruction));
+                exit(1);
+        }
+    }
+#endif
+}
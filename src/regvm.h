@@ -0,0 +1,145 @@
+#ifndef REGVM_H
+#define REGVM_H
+
+#include <stdint.h>
+#include "interpreter.h"
+#include "nanbox.h"
+#include "vm.h"
+
+// 레지스터 기반 VM (스택 VM과 같은 값 표현, 다른 명령어 세트)
+//
+// 명령어는 32비트 워드 하나: opcode(8) | A(8) | B(8) | C(8) 또는 opcode(8) | A(8) | Bx(16)
+// 피연산자는 프레임 레지스터 번호라서 a + b 같은 연산이 ADD A B C 명령어 하나로 끝난다.
+// JNLT/JNLTK/ITER는 다음 워드에 점프 오프셋(부호 있는 32비트)을 둔다.
+// 점프 오프셋은 점프 명령어(확장 워드 포함) 다음 워드 기준이다.
+
+#define REG_MAX 256                               // 프레임당 레지스터 수 (8비트 피연산자)
+#define REG_STACK_MAX (FRAMES_MAX * REG_MAX)      // 레지스터 파일 전체 크기
+
+typedef enum {
+    // 로드/이동
+    ROP_MOVE,         // A B     R[A] = R[B]
+    ROP_LOADK,        // A Bx    R[A] = K[Bx]
+    ROP_LOADNULL,     // A       R[A] = null
+    ROP_LOADBOOL,     // A B     R[A] = (B != 0)
+    ROP_GETGLOBAL,    // A Bx    R[A] = 전역[Bx] (미정의 검사, 전역은 스크립트 프레임 레지스터)
+
+    // 산술 (R[A] = R[B] op R[C])
+    ROP_ADD,
+    ROP_SUB,
+    ROP_MUL,
+    ROP_DIV,
+    ROP_MOD,
+    ROP_FLOOR_DIV,
+
+    // 상수 산술 (R[A] = R[B] op K[C])
+    ROP_ADDK,
+    ROP_SUBK,
+    ROP_MULK,
+    ROP_DIVK,
+    ROP_MODK,
+    ROP_FLOOR_DIVK,
+
+    ROP_NEG,          // A B     R[A] = -R[B]
+    ROP_NOT,          // A B     R[A] = !R[B]
+
+    // 비교 (R[A] = R[B] op R[C], 불리언)
+    ROP_EQ,
+    ROP_NE,
+    ROP_LT,
+    ROP_LE,
+    ROP_GT,
+    ROP_GE,
+
+    // 배열
+    ROP_NEWARRAY,     // A B C   R[A] = [R[B], ..., R[B+C-1]]
+    ROP_INDEX,        // A B C   R[A] = R[B][R[C]]
+
+    // 제어 흐름
+    ROP_JMP,          // sBx     ip += sBx (뒤로 가는 점프에서 루프 횟수 검사)
+    ROP_JMPF,         // A sBx   R[A]가 거짓이면 점프
+    ROP_JMPT,         // A sBx   R[A]가 참이면 점프
+    ROP_JNLT,         // A B +w  !(R[A] < R[B])이면 점프
+    ROP_JNLTK,        // A B +w  !(R[A] < K[B])이면 점프
+    ROP_ITER,         // A B +w  R[A]=배열, R[A+1]=인덱스: 끝이면 점프, 아니면 R[B] = R[A][R[A+1]++]
+
+    // 함수
+    ROP_CALL,         // A B     R[A](R[A+1], ..., R[A+B]) → R[A]
+    ROP_BUILTIN,      // A B C   R[A] = 내장 함수 B(R[A], ..., R[A+C-1])
+    ROP_RETURN,       // A       R[A] 반환
+
+    ROP_PRINT,        // A B     R[A], ..., R[A+B-1]을 공백으로 구분해 한 줄 출력
+    ROP_HALT,
+
+    ROP_COUNT
+} RegOpCode;
+
+// 명령어 인코딩/디코딩
+#define RINSTR_ABC(op, a, b, c) ((uint32_t)(op) | ((uint32_t)(a) << 8) | \
+                                 ((uint32_t)(b) << 16) | ((uint32_t)(c) << 24))
+#define RINSTR_ABX(op, a, bx)   ((uint32_t)(op) | ((uint32_t)(a) << 8) | ((uint32_t)(uint16_t)(bx) << 16))
+#define RINSTR_OP(i)  ((i) & 0xff)
+#define RINSTR_A(i)   (((i) >> 8) & 0xff)
+#define RINSTR_B(i)   (((i) >> 16) & 0xff)
+#define RINSTR_C(i)   ((i) >> 24)
+#define RINSTR_BX(i)  ((i) >> 16)
+#define RINSTR_SBX(i) ((int16_t)((i) >> 16))
+
+// 레지스터 청크 (스크립트 하나 또는 함수 하나)
+typedef struct RegChunk {
+    uint32_t* code;      // 명령어 워드
+    int count;           // 워드 수
+    int capacity;
+
+    // 상수 풀 (NaN-boxed, 로드할 때 변환 없음)
+    VMValue* constants;
+    int constant_count;
+    int constant_capacity;
+
+    // 전역 변수 이름 (스크립트 청크만, 전역 슬롯 = 스크립트 프레임 레지스터 번호)
+    char** global_names;
+    int global_count;
+
+    // 함수 정보 (스크립트 청크는 name == NULL)
+    char* name;
+    int arity;           // 매개변수 개수 (R[1]..R[arity])
+    int local_count;     // 매개변수 외 지역 변수 레지스터 수 (호출 시 null로 채움)
+    int register_count;  // 프레임이 쓰는 레지스터 수 (임시 레지스터 포함)
+} RegChunk;
+
+// 레지스터 청크 함수
+RegChunk* reg_chunk_create();
+void reg_chunk_free(RegChunk* chunk);
+int reg_emit(RegChunk* chunk, uint32_t instruction);
+int reg_add_constant(RegChunk* chunk, VMValue value);
+int reg_instruction_length(uint32_t instruction);
+const char* reg_opcode_name(RegOpCode opcode);
+void reg_disassemble(RegChunk* chunk, const char* name);
+int reg_verify(RegChunk* chunk);
+
+// 호출 프레임
+typedef struct {
+    RegChunk* chunk;
+    uint32_t* ip;        // 호출한 쪽으로 돌아갈 때 이어서 실행할 위치
+    int base;            // 레지스터 파일에서 이 프레임의 R[0] 위치
+} RegFrame;
+
+// 레지스터 VM
+typedef struct {
+    RegChunk* chunk;     // 스크립트 청크 (전역 이름 테이블 포함)
+
+    // 레지스터 파일 (프레임들이 창처럼 나눠 씀, 스크립트 프레임 앞부분이 전역 변수)
+    VMValue* registers;
+
+    RegFrame frames[FRAMES_MAX];
+    int frame_count;
+
+    // 무한 루프 방지 (뒤로 가는 JMP 횟수 상한, 0이면 무제한)
+    long max_loop_iterations;
+} RegVM;
+
+RegVM* regvm_create();
+void regvm_free(RegVM* vm);
+int regvm_run(RegVM* vm, RegChunk* chunk);  // 검증에 실패해서 실행하지 않았으면 0
+
+#endif
@@ -0,0 +1,407 @@
+#include "resolver.h"
+#include "intern.h"
+#include <stdlib.h>
+#include <string.h>
+
+// 정적 스코프 (실행 중의 환경 하나에 대응)
+typedef struct Scope {
+    struct Scope* parent;  // NULL이면 바깥 환경을 정적으로 알 수 없음 (루트, 메서드)
+    char** names;          // 자리 순서
+    int count;
+    int capacity;
+} Scope;
+
+typedef struct {
+    Arena* arena;    // 자리 배치를 남길 곳 (프로그램의 아레나)
+    char* this_name;
+    int dynamic;     // 0보다 크면 이름을 읽는 노드를 정하지 않음 (메서드 인자)
+} Resolver;
+
+static void resolve_node(Resolver* resolver, Scope* scope, ASTNode* node);
+
+static void scope_init(Scope* scope, Scope* parent) {
+    scope->parent = parent;
+    scope->names = NULL;
+    scope->count = 0;
+    scope->capacity = 0;
+}
+
+static int scope_find(Scope* scope, char* name) {
+    for (int i = 0; i < scope->count; i++) {
+        if (scope->names[i] == name) return i;
+    }
+    return -1;
+}
+
+// 이름의 자리 (없으면 맨 뒤에 새로)
+static int scope_declare(Scope* scope, char* name) {
+    int slot = scope_find(scope, name);
+    if (slot >= 0) return slot;
+    
+    if (scope->count >= scope->capacity) {
+        scope->capacity = scope->capacity < 8 ? 8 : scope->capacity * 2;
+        scope->names = (char**)realloc(scope->names, sizeof(char*) * scope->capacity);
+    }
+    scope->names[scope->count] = name;
+    return scope->count++;
+}
+
+// 스코프를 닫으며 자리 배치를 블록에 남김
+static void scope_finish(Resolver* resolver, Scope* scope, ASTNode* block) {
+    if (block && (block->type == AST_BLOCK || block->type == AST_PROGRAM) && scope->count > 0) {
+        char** locals = (char**)arena_alloc(resolver->arena, sizeof(char*) * scope->count);
+        memcpy(locals, scope->names, sizeof(char*) * scope->count);
+        block->data.block.locals = locals;
+        block->data.block.local_count = scope->count;
+    }
+    free(scope->names);
+}
+
+// 이름을 읽는 노드에 (깊이, 자리) 적기 (바깥을 모르는 스코프까지 없으면 그대로 -1)
+static void resolve_name(Resolver* resolver, Scope* scope, ASTNode* node, char* name) {
+    if (resolver->dynamic > 0) return;
+    for (int depth = 0; scope; scope = scope->parent, depth++) {
+        int slot = scope_find(scope, name);
+        if (slot >= 0) {
+            node->depth = depth;
+            node->slot = slot;
+            return;
+        }
+    }
+}
+
+// 선언 패스: 이 스코프(같은 환경)에서 선언되는 이름을 모음 (함수/메서드 본문과 catch 블록은 들어가지 않음)
+static void declare_node(Scope* scope, ASTNode* node) {
+    if (!node) return;
+    
+    switch (node->type) {
+        case AST_LET:
+        case AST_ASSIGN:
+            declare_node(scope, node->data.assign.value);
+            node->depth = 0;
+            node->slot = scope_declare(scope, node->data.assign.name);
+            break;
+            
+        case AST_FUNCTION_DEF:
+            node->depth = 0;
+            node->slot = scope_declare(scope, node->data.function_def.name);
+            break;
+            
+        case AST_CLASS:
+            scope_declare(scope, node->data.class_def.name);
+            break;
+            
+        case AST_FOR:
+            declare_node(scope, node->data.for_loop.iterable);
+            node->depth = 0;
+            node->slot = scope_declare(scope, node->data.for_loop.iterator);
+            declare_node(scope, node->data.for_loop.body);
+            break;
+            
+        case AST_IMPORT:
+            if (node->data.import_stmt.names && node->data.import_stmt.name_count > 0) {
+                for (int i = 0; i < node->data.import_stmt.name_count; i++) {
+                    scope_declare(scope, node->data.import_stmt.names[i]);
+                }
+            } else {
+                scope_declare(scope, node->data.import_stmt.alias ? node->data.import_stmt.alias
+                                                                  : node->data.import_stmt.module_name);
+            }
+            break;
+            
+        case AST_EXPORT:
+            declare_node(scope, node->data.export_stmt.node);
+            break;
+            
+        case AST_TRY_CATCH:
+            declare_node(scope, node->data.try_catch.try_block);
+            declare_node(scope, node->data.try_catch.finally_block);
+            break;
+            
+        case AST_PROGRAM:
+        case AST_BLOCK:
+            for (int i = 0; i < node->data.block.statement_count; i++) {
+                declare_node(scope, node->data.block.statements[i]);
+            }
+            break;
+            
+        case AST_IF:
+            declare_node(scope, node->data.if_stmt.condition);
+            declare_node(scope, node->data.if_stmt.then_branch);
+            declare_node(scope, node->data.if_stmt.else_branch);
+            break;
+            
+        case AST_WHILE:
+            declare_node(scope, node->data.while_loop.condition);
+            declare_node(scope, node->data.while_loop.body);
+            break;
+            
+        case AST_RETURN:
+            declare_node(scope, node->data.return_stmt.value);
+            break;
+            
+        case AST_BINARY_OP:
+            declare_node(scope, node->data.binary.left);
+            declare_node(scope, node->data.binary.right);
+            break;
+            
+        case AST_UNARY_OP:
+            declare_node(scope, node->data.unary.operand);
+            break;
+            
+        case AST_FUNCTION_CALL:
+            for (int i = 0; i < node->data.function_call.arg_count; i++) {
+                declare_node(scope, node->data.function_call.args[i]);
+            }
+            break;
+            
+        case AST_ARRAY:
+            for (int i = 0; i < node->data.array.element_count; i++) {
+                declare_node(scope, node->data.array.elements[i]);
+            }
+            break;
+            
+        case AST_DICT:
+            for (int i = 0; i < node->data.dict.pair_count; i++) {
+                declare_node(scope, node->data.dict.values[i]);
+            }
+            break;
+            
+        case AST_MATRIX:
+            for (int i = 0; i < node->data.matrix.row_count; i++) {
+                declare_node(scope, node->data.matrix.rows[i]);
+            }
+            break;
+            
+        case AST_INDEX:
+            declare_node(scope, node->data.index.array);
+            declare_node(scope, node->data.index.index);
+            break;
+            
+        case AST_INDEX_ASSIGN:
+            declare_node(scope, node->data.index_assign.index);
+            declare_node(scope, node->data.index_assign.value);
+            break;
+            
+        case AST_DOT_ACCESS:
+            declare_node(scope, node->data.dot.object);
+            break;
+            
+        case AST_FIELD_ASSIGN:
+            declare_node(scope, node->data.field_assign.object);
+            declare_node(scope, node->data.field_assign.value);
+            break;
+            
+        case AST_METHOD_CALL:
+            declare_node(scope, node->data.method_call.object);
+            for (int i = 0; i < node->data.method_call.arg_count; i++) {
+                declare_node(scope, node->data.method_call.args[i]);
+            }
+            break;
+            
+        case AST_NEW:
+            for (int i = 0; i < node->data.new_expr.arg_count; i++) {
+                declare_node(scope, node->data.new_expr.args[i]);
+            }
+            break;
+            
+        case AST_SUPER:
+            for (int i = 0; i < node->data.super_call.arg_count; i++) {
+                declare_node(scope, node->data.super_call.args[i]);
+            }
+            break;
+            
+        case AST_THROW:
+            declare_node(scope, node->data.throw_stmt.exception_value);
+            break;
+            
+        case AST_ASSERT:
+            declare_node(scope, node->data.assert_stmt.condition);
+            break;
+            
+        default:
+            break;
+    }
+}
+
+// 새 스코프를 열어 본문을 처리 (names: 본문보다 먼저 들어가는 이름 - this, 매개변수, 예외 변수)
+static void resolve_scope(Resolver* resolver, Scope* parent, char** names, int count, ASTNode* body) {
+    Scope scope;
+    scope_init(&scope, parent);
+    for (int i = 0; i < count; i++) scope_declare(&scope, names[i]);
+    
+    int dynamic = resolver->dynamic;
+    resolver->dynamic = 0;
+    declare_node(&scope, body);
+    resolve_node(resolver, &scope, body);
+    resolver->dynamic = dynamic;
+    
+    scope_finish(resolver, &scope, body);
+}
+
+// 메서드 본문 (환경의 부모가 호출한 쪽이라 바깥은 모름, 자리는 this 다음에 매개변수)
+static void resolve_method(Resolver* resolver, ASTNode* method) {
+    int count = method->data.function_def.param_count;
+    char** names = (char**)malloc(sizeof(char*) * (count + 1));
+    names[0] = resolver->this_name;
+    for (int i = 0; i < count; i++) names[i + 1] = method->data.function_def.params[i];
+    resolve_scope(resolver, NULL, names, count + 1, method->data.function_def.body);
+    free(names);
+}
+
+// 인자 목록 (메서드 환경에서 평가되는 인자는 이름을 정하지 않음)
+static void resolve_args(Resolver* resolver, Scope* scope, ASTNode** args, int count, int dynamic) {
+    resolver->dynamic += dynamic;
+    for (int i = 0; i < count; i++) resolve_node(resolver, scope, args[i]);
+    resolver->dynamic -= dynamic;
+}
+
+// 참조 패스: 이름을 읽는 노드에 (깊이, 자리)를 적고, 함수/메서드 본문과 catch 블록은 새 스코프로
+static void resolve_node(Resolver* resolver, Scope* scope, ASTNode* node) {
+    if (!node) return;
+    
+    switch (node->type) {
+        case AST_IDENTIFIER:
+            resolve_name(resolver, scope, node, node->data.string);
+            break;
+            
+        case AST_THIS:
+            resolve_name(resolver, scope, node, resolver->this_name);
+            break;
+            
+        case AST_FUNCTION_CALL:
+            resolve_name(resolver, scope, node, node->data.function_call.name);
+            resolve_args(resolver, scope, node->data.function_call.args, node->data.function_call.arg_count, 0);
+            break;
+            
+        case AST_LET:
+        case AST_ASSIGN:
+            resolve_node(resolver, scope, node->data.assign.value);
+            break;
+            
+        case AST_FUNCTION_DEF:
+            resolve_scope(resolver, scope, node->data.function_def.params, node->data.function_def.param_count,
+                          node->data.function_def.body);
+            break;
+            
+        case AST_CLASS:
+            for (int i = 0; i < node->data.class_def.method_count; i++) {
+                resolve_method(resolver, node->data.class_def.methods[i]);
+            }
+            break;
+            
+        case AST_FOR:
+            resolve_node(resolver, scope, node->data.for_loop.iterable);
+            resolve_node(resolver, scope, node->data.for_loop.body);
+            break;
+            
+        case AST_TRY_CATCH: {
+            resolve_node(resolver, scope, node->data.try_catch.try_block);
+            char* exception_var = node->data.try_catch.exception_var;
+            resolve_scope(resolver, scope, &exception_var, exception_var ? 1 : 0, node->data.try_catch.catch_block);
+            resolve_node(resolver, scope, node->data.try_catch.finally_block);
+            break;
+        }
+            
+        case AST_EXPORT:
+            resolve_node(resolver, scope, node->data.export_stmt.node);
+            break;
+            
+        case AST_PROGRAM:
+        case AST_BLOCK:
+            for (int i = 0; i < node->data.block.statement_count; i++) {
+                resolve_node(resolver, scope, node->data.block.statements[i]);
+            }
+            break;
+            
+        case AST_IF:
+            resolve_node(resolver, scope, node->data.if_stmt.condition);
+            resolve_node(resolver, scope, node->data.if_stmt.then_branch);
+            resolve_node(resolver, scope, node->data.if_stmt.else_branch);
+            break;
+            
+        case AST_WHILE:
+            resolve_node(resolver, scope, node->data.while_loop.condition);
+            resolve_node(resolver, scope, node->data.while_loop.body);
+            break;
+            
+        case AST_RETURN:
+            resolve_node(resolver, scope, node->data.return_stmt.value);
+            break;
+            
+        case AST_BINARY_OP:
+            resolve_node(resolver, scope, node->data.binary.left);
+            resolve_node(resolver, scope, node->data.binary.right);
+            break;
+            
+        case AST_UNARY_OP:
+            resolve_node(resolver, scope, node->data.unary.operand);
+            break;
+            
+        case AST_ARRAY:
+            resolve_args(resolver, scope, node->data.array.elements, node->data.array.element_count, 0);
+            break;
+            
+        case AST_DICT:
+            resolve_args(resolver, scope, node->data.dict.values, node->data.dict.pair_count, 0);
+            break;
+            
+        case AST_MATRIX:
+            resolve_args(resolver, scope, node->data.matrix.rows, node->data.matrix.row_count, 0);
+            break;
+            
+        case AST_INDEX:
+            resolve_node(resolver, scope, node->data.index.array);
+            resolve_node(resolver, scope, node->data.index.index);
+            break;
+            
+        case AST_INDEX_ASSIGN:
+            resolve_node(resolver, scope, node->data.index_assign.array);
+            resolve_node(resolver, scope, node->data.index_assign.index);
+            resolve_node(resolver, scope, node->data.index_assign.value);
+            break;
+            
+        case AST_DOT_ACCESS:
+            resolve_node(resolver, scope, node->data.dot.object);
+            break;
+            
+        case AST_FIELD_ASSIGN:
+            resolve_node(resolver, scope, node->data.field_assign.object);
+            resolve_node(resolver, scope, node->data.field_assign.value);
+            break;
+            
+        case AST_METHOD_CALL:
+            resolve_node(resolver, scope, node->data.method_call.object);
+            resolve_args(resolver, scope, node->data.method_call.args, node->data.method_call.arg_count, 1);
+            break;
+            
+        case AST_NEW:
+            resolve_args(resolver, scope, node->data.new_expr.args, node->data.new_expr.arg_count, 1);
+            break;
+            
+        case AST_SUPER:
+            resolve_args(resolver, scope, node->data.super_call.args, node->data.super_call.arg_count, 1);
+            break;
+            
+        case AST_THROW:
+            resolve_node(resolver, scope, node->data.throw_stmt.exception_value);
+            break;
+            
+        case AST_ASSERT:
+            resolve_node(resolver, scope, node->data.assert_stmt.condition);
+            break;
+            
+        default:
+            break;
+    }
+}
+
+void resolver_resolve(ASTNode* program, char** globals, int global_count) {
+    if (!program || program->type != AST_PROGRAM || !program->data.block.arena) return;
+    
+    Resolver resolver;
+    resolver.arena = program->data.block.arena;
+    resolver.this_name = symbol_from("this");
+    resolver.dynamic = 0;
+    resolve_scope(&resolver, NULL, globals, global_count, program);
+}
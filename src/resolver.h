@@ -0,0 +1,22 @@
+#ifndef RESOLVER_H
+#define RESOLVER_H
+
+#include "parser.h"
+
+// 리졸버 (파싱과 실행 사이의 정적 패스)
+//
+// 인터프리터는 함수/메서드 호출과 catch 블록마다 환경을 하나 만들고, 그 밖의 블록(if, while, for)은
+// 바깥 환경을 그대로 쓴다. 리졸버는 이 구조를 그대로 따라 스코프마다 선언되는 이름에 자리를 정하고
+// (매개변수가 먼저, 그다음 본문에서 처음 나오는 순서), 이름을 읽는 노드에 (깊이, 자리)를 적는다.
+// 스코프를 여는 블록에는 자리 배치(locals)를 남겨서 인터프리터가 그 배치로 환경을 만든다.
+//
+// 정적으로 정하지 못하는 경우는 slot을 -1로 두고 인터프리터가 이름으로 찾는다:
+//   - 바깥 스코프를 모르는 경우: 프로그램의 루트 밖, 메서드 본문 밖 (메서드 환경의 부모는 호출한 쪽)
+//   - 메서드/생성자/super 호출의 인자 (메서드 환경으로 바꾼 뒤에 평가함)
+// 선언보다 먼저 읽는 경우처럼 자리는 있지만 값이 아직 없으면 인터프리터가 실행 중에 이름으로 찾는다.
+
+// program(AST_PROGRAM)을 실행할 루트 환경에 이미 있는 이름들(자리 순서)을 이어서 자리를 정함
+// (REPL은 줄마다, 모듈은 exports 환경에 대해 부름)
+void resolver_resolve(ASTNode* program, char** globals, int global_count);
+
+#endif
@@ -0,0 +1,91 @@
+#include "slab.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+void slab_init(Slab* slab, size_t object_size) {
+    if (object_size < sizeof(void*)) object_size = sizeof(void*);
+    slab->object_size = (object_size + 7) & ~(size_t)7;
+    slab->pages = NULL;
+    slab->free_list = NULL;
+    slab->bump = NULL;
+    slab->bump_end = NULL;
+    slab->allocations = 0;
+    slab->frees = 0;
+    slab->page_count = 0;
+}
+
+// 칸이 들어 있는 페이지 (페이지는 SLAB_PAGE_SIZE 경계에 맞춰 받음)
+static SlabPage* page_of(void* object) {
+    return (SlabPage*)((uintptr_t)object & ~(uintptr_t)(SLAB_PAGE_SIZE - 1));
+}
+
+// 새 페이지를 받아 남은 칸으로 삼음 (이전 페이지의 남은 칸은 모두 쓴 뒤에만 부름)
+static void slab_grow(Slab* slab) {
+    void* memory;
+    if (posix_memalign(&memory, SLAB_PAGE_SIZE, SLAB_PAGE_SIZE) != 0) abort();
+    SlabPage* page = (SlabPage*)memory;
+    page->next = slab->pages;
+    slab->pages = page;
+    slab->page_count++;
+
+    size_t usable = SLAB_PAGE_SIZE - sizeof(SlabPage);
+    slab->bump = page->data;
+    slab->bump_end = page->data + usable - usable % slab->object_size;
+}
+
+void* slab_alloc(Slab* slab) {
+    slab->allocations++;
+
+    if (slab->free_list) {
+        void* object = slab->free_list;
+        slab->free_list = *(void**)object;
+        return object;
+    }
+
+    if (slab->bump == slab->bump_end) slab_grow(slab);
+    void* object = slab->bump;
+    slab->bump += slab->object_size;
+    return object;
+}
+
+void slab_free(Slab* slab, void* object) {
+    if (!object) return;
+    *(void**)object = slab->free_list;
+    slab->free_list = object;
+    slab->frees++;
+}
+
+// 자유 목록을 페이지별로 세어 칸이 전부 해제된 페이지를 돌려줌
+// 맨 앞 페이지는 아직 안 쓴 칸(bump)을 나눠 주는 중이므로 남겨 둠
+void slab_trim(Slab* slab) {
+    if (!slab->pages) return;
+    size_t capacity = (SLAB_PAGE_SIZE - sizeof(SlabPage)) / slab->object_size;
+
+    for (SlabPage* page = slab->pages; page; page = page->next) page->free_count = 0;
+    for (void* object = slab->free_list; object; object = *(void**)object) {
+        page_of(object)->free_count++;
+    }
+
+    // 돌려줄 페이지의 칸을 자유 목록에서 뺌
+    void** link = &slab->free_list;
+    while (*link) {
+        SlabPage* page = page_of(*link);
+        if (page != slab->pages && page->free_count == capacity) {
+            *link = *(void**)*link;
+        } else {
+            link = (void**)*link;
+        }
+    }
+
+    SlabPage** page_link = &slab->pages->next;
+    while (*page_link) {
+        SlabPage* page = *page_link;
+        if (page->free_count == capacity) {
+            *page_link = page->next;
+            free(page);
+            slab->page_count--;
+        } else {
+            page_link = &page->next;
+        }
+    }
+}
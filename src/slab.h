@@ -0,0 +1,43 @@
+#ifndef SLAB_H
+#define SLAB_H
+
+#include <stddef.h>
+
+// 슬랩 할당기 (크기가 같은 객체 전용)
+//
+// 페이지(SLAB_PAGE_SIZE)를 통째로 받아 같은 크기 칸으로 나눠 쓰고, 해제된 칸은 자유 목록에
+// 넣었다가 다음 할당에 먼저 돌려준다. 칸마다 malloc/free를 부르지 않으므로 작은 객체를
+// 많이 만들고 버리는 경우(값 헤더)에 빠르다. 모든 칸이 해제된 페이지는 slab_trim이 OS에 돌려준다.
+// 인터프리터/VM은 스레드 하나에서만 값을 만들므로 슬랩도 잠그지 않는다.
+
+#define SLAB_PAGE_SIZE (64 * 1024)
+
+typedef struct SlabPage {
+    struct SlabPage* next;
+    size_t free_count;  // slab_trim이 세는 해제된 칸 수 (칸을 16바이트 경계에서 시작하게 하는 자리도 겸함)
+    char data[];
+} SlabPage;
+
+typedef struct Slab {
+    size_t object_size;   // 칸 크기 (8의 배수로 올림)
+    SlabPage* pages;
+    void* free_list;      // 해제된 칸 (칸의 첫 워드에 다음 칸)
+    char* bump;           // 맨 앞 페이지에서 아직 한 번도 안 쓴 칸
+    char* bump_end;
+
+    // 통계
+    size_t allocations;
+    size_t frees;
+    size_t page_count;
+} Slab;
+
+void slab_init(Slab* slab, size_t object_size);
+void* slab_alloc(Slab* slab);           // 초기화하지 않음
+void slab_free(Slab* slab, void* object);
+void slab_trim(Slab* slab);             // 모든 칸이 해제된 페이지를 자유 목록에서 빼고 해제
+
+static inline size_t slab_live(const Slab* slab) {
+    return slab->allocations - slab->frees;
+}
+
+#endif
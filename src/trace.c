@@ -0,0 +1,600 @@
+#include "trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined(__x86_64__)
+
+#include <limits.h>
+#include "x64.h"
+
+#define TRACE_BLACKLISTED UINT16_MAX
+
+// 생성된 트레이스: 이어서 실행할 바이트코드 오프셋 반환, *pushed = VM 스택에 올린 값 개수
+typedef int (*TraceFunction)(VMValue* globals, VMValue* slots, VMValue* stack_top,
+                             long* remaining, int* pushed);
+
+// 기록 결과
+typedef enum {
+    TRACE_OK,
+    TRACE_RETRY,    // 이번 바퀴에 루프를 빠져나감 등 (나중에 다시 기록)
+    TRACE_GIVE_UP   // 숫자가 아닌 값, 지원하지 않는 명령어 (이 루프는 다시 시도 안 함)
+} TraceStatus;
+
+// 트레이스 명령어 (바이트코드를 스택 깊이가 정해진 단순 연산으로 풀어 놓은 것)
+typedef enum {
+    STEP_CONST,     // 상수 푸시
+    STEP_LOAD,      // 변수 푸시
+    STEP_STORE,     // top → 변수 (pop 없음)
+    STEP_ARITH,     // 이항 산술 (opcode: ADD/SUBTRACT/MULTIPLY/DIVIDE)
+    STEP_NEGATE,
+    STEP_ADD_CONST,
+    STEP_INCR,      // 변수 += 상수
+    STEP_POP,
+    STEP_DUP,
+    STEP_BRANCH     // 기록할 때와 같은 방향인지 검사하는 가드
+} StepKind;
+
+typedef struct {
+    StepKind kind;
+    OpCode opcode;      // ARITH의 연산, BRANCH의 비교 (OP_LESS..OP_NOT_EQUAL)
+    int depth;          // 실행 전 표현식 스택 깊이
+    int variable;
+    double constant;
+    int single;         // BRANCH: 값 하나를 0과 비교 (JUMP_IF_FALSE/TRUE)
+    int expected;       // BRANCH: 기록할 때 비교 결과
+    int exit;           // 가드 실패 시 이어서 실행할 오프셋
+} TraceStep;
+
+typedef struct {
+    int global;         // 1이면 전역 슬롯, 0이면 프레임 슬롯
+    uint32_t slot;
+    int read_first;     // 쓰기 전에 읽음 (진입 시 타입 가드)
+    int written;        // 트레이스가 씀 (나갈 때 메모리에 되씀)
+    double value;       // 기록 중 현재 값
+} TraceVariable;
+
+typedef struct {
+    BytecodeChunk* chunk;
+    VMValue* globals;
+    VMValue* slots;
+    int header;
+    int loop_offset;
+
+    TraceVariable variables[TRACE_MAX_VARIABLES];
+    int variable_count;
+    TraceStep steps[TRACE_MAX_LENGTH];
+    int step_count;
+    double stack[TRACE_MAX_DEPTH];
+    int depth;
+} TraceRecorder;
+
+// ============ 기록 ============
+
+// 변수 찾기/추가 (reading이면 처음 읽을 때 메모리 값이 숫자인지 확인, 실패하면 -1)
+static int record_variable(TraceRecorder* rec, int global, uint32_t slot, int reading) {
+    for (int i = 0; i < rec->variable_count; i++) {
+        if (rec->variables[i].global == global && rec->variables[i].slot == slot) return i;
+    }
+    if (rec->variable_count >= TRACE_MAX_VARIABLES) return -1;
+
+    TraceVariable* variable = &rec->variables[rec->variable_count];
+    variable->global = global;
+    variable->slot = slot;
+    variable->read_first = reading;
+    variable->written = 0;
+    variable->value = 0;
+
+    if (reading) {
+        VMValue value = global ? rec->globals[slot] : rec->slots[slot];
+        if (!IS_NUMBER(value)) return -1;
+        variable->value = AS_NUMBER(value);
+    }
+    return rec->variable_count++;
+}
+
+static TraceStep* record_step(TraceRecorder* rec, StepKind kind) {
+    if (rec->step_count >= TRACE_MAX_LENGTH) return NULL;
+    TraceStep* step = &rec->steps[rec->step_count++];
+    step->kind = kind;
+    step->opcode = OP_HALT;
+    step->depth = rec->depth;
+    step->variable = -1;
+    step->constant = 0;
+    step->single = 0;
+    step->expected = 0;
+    step->exit = -1;
+    return step;
+}
+
+static int relation_holds(OpCode relation, double a, double b) {
+    switch (relation) {
+        case OP_LESS:          return a < b;
+        case OP_LESS_EQUAL:    return a <= b;
+        case OP_GREATER:       return a > b;
+        case OP_GREATER_EQUAL: return a >= b;
+        case OP_EQUAL:         return a == b;
+        default:               return a != b;
+    }
+}
+
+// 분기 기록: jump_when_holds면 비교가 참일 때 점프, *next = 기록할 때 간 쪽
+static TraceStatus record_branch(TraceRecorder* rec, OpCode relation, int single,
+                                 int jump_when_holds, int target, int fallthrough, int* next) {
+    int operands = single ? 1 : 2;
+    if (rec->depth < operands) return TRACE_GIVE_UP;
+
+    double a = single ? rec->stack[rec->depth - 1] : rec->stack[rec->depth - 2];
+    double b = single ? 0 : rec->stack[rec->depth - 1];
+    int holds = relation_holds(relation, a, b);
+    int jumped = holds == jump_when_holds;
+
+    TraceStep* step = record_step(rec, STEP_BRANCH);
+    if (!step) return TRACE_GIVE_UP;
+    step->opcode = relation;
+    step->single = single;
+    step->expected = holds;
+    step->exit = jumped ? fallthrough : target;
+
+    rec->depth -= operands;
+    *next = jumped ? target : fallthrough;
+
+    // 이번 바퀴에 루프를 빠져나가면 트레이스를 만들 수 없음
+    if (*next < rec->header || *next > rec->loop_offset) return TRACE_RETRY;
+    return TRACE_OK;
+}
+
+static TraceStatus record_push(TraceRecorder* rec, double value) {
+    if (rec->depth >= TRACE_MAX_DEPTH) return TRACE_GIVE_UP;
+    rec->stack[rec->depth++] = value;
+    return TRACE_OK;
+}
+
+// header부터 OP_LOOP까지 한 바퀴를 실제 값으로 따라가며 기록
+static TraceStatus record_trace(TraceRecorder* rec) {
+    BytecodeChunk* chunk = rec->chunk;
+    int offset = rec->header;
+
+    while (1) {
+        OpCode opcode = bytecode_generic_opcode((OpCode)chunk->code[offset]);
+        int64_t operand = bytecode_read_operand(chunk, offset);
+        int next = offset + bytecode_instruction_length(chunk, offset);
+        TraceStep* step;
+        TraceStatus status;
+
+        switch (opcode) {
+            case OP_LOAD_CONST:
+            case OP_LOAD_CONST_LONG:
+            case OP_ADD_CONST: {
+                Value* constant = chunk->constants[operand];
+                if (constant->type != VAL_NUMBER) return TRACE_GIVE_UP;
+                if (opcode == OP_ADD_CONST) {
+                    if (rec->depth < 1 || !(step = record_step(rec, STEP_ADD_CONST))) return TRACE_GIVE_UP;
+                    if (rec->depth >= TRACE_MAX_DEPTH) return TRACE_GIVE_UP;   // 상수용 임시 자리
+                    rec->stack[rec->depth - 1] += constant->data.number;
+                } else {
+                    if (!(step = record_step(rec, STEP_CONST))) return TRACE_GIVE_UP;
+                    if ((status = record_push(rec, constant->data.number)) != TRACE_OK) return status;
+                }
+                step->constant = constant->data.number;
+                break;
+            }
+
+            case OP_LOAD_GLOBAL:
+            case OP_LOAD_GLOBAL_LONG:
+            case OP_LOAD_LOCAL: {
+                int variable = record_variable(rec, opcode != OP_LOAD_LOCAL, (uint32_t)operand, 1);
+                if (variable < 0 || !(step = record_step(rec, STEP_LOAD))) return TRACE_GIVE_UP;
+                step->variable = variable;
+                if ((status = record_push(rec, rec->variables[variable].value)) != TRACE_OK) return status;
+                break;
+            }
+
+            case OP_STORE_GLOBAL:
+            case OP_STORE_GLOBAL_LONG:
+            case OP_STORE_LOCAL: {
+                int variable = record_variable(rec, opcode != OP_STORE_LOCAL, (uint32_t)operand, 0);
+                if (variable < 0 || rec->depth < 1 || !(step = record_step(rec, STEP_STORE))) {
+                    return TRACE_GIVE_UP;
+                }
+                step->variable = variable;
+                rec->variables[variable].value = rec->stack[rec->depth - 1];
+                rec->variables[variable].written = 1;
+                break;
+            }
+
+            case OP_INCR_LOCAL:
+            case OP_INCR_GLOBAL: {
+                uint8_t slot = chunk->code[offset + 1];
+                int8_t amount = (int8_t)chunk->code[offset + 2];
+                int variable = record_variable(rec, opcode == OP_INCR_GLOBAL, slot, 1);
+                if (variable < 0 || !(step = record_step(rec, STEP_INCR))) return TRACE_GIVE_UP;
+                step->variable = variable;
+                step->constant = amount;
+                rec->variables[variable].value += amount;
+                rec->variables[variable].written = 1;
+                break;
+            }
+
+            case OP_ADD:
+            case OP_SUBTRACT:
+            case OP_MULTIPLY:
+            case OP_DIVIDE: {
+                if (rec->depth < 2 || !(step = record_step(rec, STEP_ARITH))) return TRACE_GIVE_UP;
+                double a = rec->stack[rec->depth - 2];
+                double b = rec->stack[rec->depth - 1];
+                double result = opcode == OP_ADD ? a + b : opcode == OP_SUBTRACT ? a - b :
+                                opcode == OP_MULTIPLY ? a * b : a / b;
+
+                // 0으로 나누기는 vm_run이 에러를 내도록 나누기 직전으로 나감
+                if (opcode == OP_DIVIDE) {
+                    if (b == 0) return TRACE_RETRY;
+                    step->exit = offset;
+                }
+                step->opcode = opcode;
+                rec->depth--;
+                rec->stack[rec->depth - 1] = result;
+                break;
+            }
+
+            case OP_NEGATE:
+                if (rec->depth < 1 || !record_step(rec, STEP_NEGATE)) return TRACE_GIVE_UP;
+                rec->stack[rec->depth - 1] = -rec->stack[rec->depth - 1];
+                break;
+
+            case OP_POP:
+                if (rec->depth < 1 || !record_step(rec, STEP_POP)) return TRACE_GIVE_UP;
+                rec->depth--;
+                break;
+
+            case OP_DUP:
+                if (rec->depth < 1 || !record_step(rec, STEP_DUP)) return TRACE_GIVE_UP;
+                if ((status = record_push(rec, rec->stack[rec->depth - 1])) != TRACE_OK) return status;
+                break;
+
+            // 비교는 바로 뒤 조건 점프와 합쳐 가드 하나로 (불리언 값은 트레이스에 두지 않음)
+            case OP_LESS:
+            case OP_LESS_EQUAL:
+            case OP_GREATER:
+            case OP_GREATER_EQUAL:
+            case OP_EQUAL:
+            case OP_NOT_EQUAL: {
+                if (next >= chunk->count) return TRACE_GIVE_UP;
+                OpCode jump = (OpCode)chunk->code[next];
+                if (jump != OP_JUMP_IF_FALSE && jump != OP_JUMP_IF_TRUE) return TRACE_GIVE_UP;
+                status = record_branch(rec, opcode, 0, jump == OP_JUMP_IF_TRUE,
+                                       bytecode_jump_target(chunk, next),
+                                       next + bytecode_instruction_length(chunk, next), &next);
+                if (status != TRACE_OK) return status;
+                break;
+            }
+
+            case OP_JUMP_IF_NOT_LESS:
+                status = record_branch(rec, OP_LESS, 0, 0, bytecode_jump_target(chunk, offset),
+                                       next, &next);
+                if (status != TRACE_OK) return status;
+                break;
+
+            // 숫자 조건: 0이면 거짓
+            case OP_JUMP_IF_FALSE:
+            case OP_JUMP_IF_TRUE:
+                status = record_branch(rec, OP_EQUAL, 1, opcode == OP_JUMP_IF_FALSE,
+                                       bytecode_jump_target(chunk, offset), next, &next);
+                if (status != TRACE_OK) return status;
+                break;
+
+            case OP_JUMP:
+                next = bytecode_jump_target(chunk, offset);
+                if (next > rec->loop_offset) return TRACE_RETRY;
+                break;
+
+            case OP_LOOP:
+                // 이 루프의 역방향 점프로 한 바퀴가 끝남 (안쪽 루프는 따로 트레이스)
+                if (offset != rec->loop_offset || rec->depth != 0) return TRACE_GIVE_UP;
+                return TRACE_OK;
+
+            default:
+                return TRACE_GIVE_UP;
+        }
+
+        offset = next;
+    }
+}
+
+// ============ 컴파일 ============
+
+// 레지스터 배치: 변수 v → xmm(8+v), 스택 깊이 i → xmm(i), xmm7 = 임시
+#define VARIABLE_XMM(v) (8 + (v))
+#define SCRATCH_XMM 7
+
+// 사이드 이그짓 (가드 실패 시 갈 곳)
+typedef struct {
+    int jumps[2];       // 채울 jcc rel32 위치
+    int jump_count;
+    int resume;         // 이어서 실행할 바이트코드 오프셋
+    int depth;          // VM 스택에 올릴 값 개수
+} TraceExit;
+
+typedef struct {
+    TraceExit* exits;
+    int count;
+    int capacity;
+} TraceExits;
+
+static TraceExit* add_exit(TraceExits* exits, int resume, int depth) {
+    if (exits->count >= exits->capacity) {
+        exits->capacity = exits->capacity < 8 ? 8 : exits->capacity * 2;
+        exits->exits = (TraceExit*)realloc(exits->exits, sizeof(TraceExit) * exits->capacity);
+    }
+    TraceExit* exit = &exits->exits[exits->count++];
+    exit->jump_count = 0;
+    exit->resume = resume;
+    exit->depth = depth;
+    return exit;
+}
+
+static void exit_jump(X64Assembler* as, TraceExit* exit, int cc) {
+    exit->jumps[exit->jump_count++] = x64_jcc(as, cc);
+}
+
+static void emit_constant(X64Assembler* as, int xmm, double value) {
+    x64_mov_imm(as, RAX, NUMBER_VAL(value));
+    x64_movq_to_xmm(as, xmm, RAX);
+}
+
+// 변수 메모리 위치 (rdi = 전역, rsi = 프레임 슬롯)
+static int variable_base(TraceVariable* variable) {
+    return variable->global ? RDI : RSI;
+}
+
+// 비교 결과가 expected와 다르면 exit로
+static void emit_branch_guard(X64Assembler* as, TraceStep* step, TraceExit* exit) {
+    int a = step->single ? step->depth - 1 : step->depth - 2;
+    int b = step->single ? SCRATCH_XMM : step->depth - 1;
+
+    if (step->single) x64_sse(as, 0x66, SSE_XORPD, SCRATCH_XMM, SCRATCH_XMM);
+
+    if (step->opcode == OP_EQUAL || step->opcode == OP_NOT_EQUAL) {
+        // 같음 = ZF=1 && PF=0 (NaN이면 PF=1)
+        int equal = step->opcode == OP_EQUAL ? step->expected : !step->expected;
+        x64_sse(as, 0x66, SSE_UCOMISD, a, b);
+        if (equal) {
+            exit_jump(as, exit, CC_NE);
+            exit_jump(as, exit, CC_P);
+        } else {
+            int unordered = x64_jcc(as, CC_P);
+            exit_jump(as, exit, CC_E);
+            x64_patch_here(as, unordered);
+        }
+        return;
+    }
+
+    // a < b 는 b > a 로 (ucomisd는 NaN이면 CF=1이라 A/AE 모두 거짓)
+    int swap = step->opcode == OP_LESS || step->opcode == OP_LESS_EQUAL;
+    int strict = step->opcode == OP_LESS || step->opcode == OP_GREATER;
+    x64_sse(as, 0x66, SSE_UCOMISD, swap ? b : a, swap ? a : b);
+    if (strict) {
+        exit_jump(as, exit, step->expected ? CC_BE : CC_A);
+    } else {
+        exit_jump(as, exit, step->expected ? CC_B : CC_AE);
+    }
+}
+
+static Trace* compile_trace(TraceRecorder* rec) {
+    X64Assembler as = { NULL, 0, 0 };
+    TraceExits exits = { NULL, 0, 0 };
+
+    // 진입: 변수를 레지스터로 (처음 읽는 변수만 숫자인지 검사 - 루프 밖으로 올린 타입 가드)
+    int entry_failures[TRACE_MAX_VARIABLES];
+    int entry_failure_count = 0;
+    x64_mov_imm(&as, R10, QNAN);
+    for (int v = 0; v < rec->variable_count; v++) {
+        TraceVariable* variable = &rec->variables[v];
+        x64_load(&as, RAX, variable_base(variable), (int32_t)(variable->slot * 8));
+        if (variable->read_first) {
+            x64_mov(&as, R11, RAX);
+            x64_alu(&as, OPC_AND, R11, R10);
+            x64_alu(&as, OPC_CMP, R11, R10);
+            entry_failures[entry_failure_count++] = x64_jcc(&as, CC_E);
+        }
+        x64_movq_to_xmm(&as, VARIABLE_XMM(v), RAX);
+    }
+
+    int loop_top = as.count;
+
+    for (int i = 0; i < rec->step_count; i++) {
+        TraceStep* step = &rec->steps[i];
+        int d = step->depth;
+
+        switch (step->kind) {
+            case STEP_CONST:
+                emit_constant(&as, d, step->constant);
+                break;
+            case STEP_LOAD:
+                x64_sse(&as, 0x66, SSE_MOVAPD, d, VARIABLE_XMM(step->variable));
+                break;
+            case STEP_STORE:
+                x64_sse(&as, 0x66, SSE_MOVAPD, VARIABLE_XMM(step->variable), d - 1);
+                break;
+            case STEP_ARITH: {
+                uint8_t sse = step->opcode == OP_ADD ? SSE_ADDSD : step->opcode == OP_SUBTRACT ? SSE_SUBSD :
+                              step->opcode == OP_MULTIPLY ? SSE_MULSD : SSE_DIVSD;
+                if (step->opcode == OP_DIVIDE) {
+                    x64_sse(&as, 0x66, SSE_XORPD, SCRATCH_XMM, SCRATCH_XMM);
+                    x64_sse(&as, 0x66, SSE_UCOMISD, d - 1, SCRATCH_XMM);
+                    exit_jump(&as, add_exit(&exits, step->exit, d), CC_E);
+                }
+                x64_sse(&as, 0xF2, sse, d - 2, d - 1);
+                break;
+            }
+            case STEP_NEGATE:
+                x64_mov_imm(&as, RAX, SIGN_BIT);
+                x64_movq_to_xmm(&as, SCRATCH_XMM, RAX);
+                x64_sse(&as, 0x66, SSE_XORPD, d - 1, SCRATCH_XMM);
+                break;
+            case STEP_ADD_CONST:
+                emit_constant(&as, d, step->constant);
+                x64_sse(&as, 0xF2, SSE_ADDSD, d - 1, d);
+                break;
+            case STEP_INCR:
+                emit_constant(&as, SCRATCH_XMM, step->constant);
+                x64_sse(&as, 0xF2, SSE_ADDSD, VARIABLE_XMM(step->variable), SCRATCH_XMM);
+                break;
+            case STEP_POP:
+                break;
+            case STEP_DUP:
+                x64_sse(&as, 0x66, SSE_MOVAPD, d, d - 1);
+                break;
+            case STEP_BRANCH:
+                emit_branch_guard(&as, step, add_exit(&exits, step->exit, d - (step->single ? 1 : 2)));
+                break;
+        }
+    }
+
+    // 역방향 점프: 남은 횟수가 0이면 OP_LOOP로 나가서 vm_run이 루프 제한 에러를 냄
+    x64_byte(&as, 0x48);                // cmp qword [rcx], 0
+    x64_byte(&as, 0x83);
+    x64_byte(&as, 0x39);
+    x64_byte(&as, 0x00);
+    exit_jump(&as, add_exit(&exits, rec->loop_offset, 0), CC_E);
+    x64_byte(&as, 0x48);                // dec qword [rcx]
+    x64_byte(&as, 0xFF);
+    x64_byte(&as, 0x09);
+    x64_patch_rel32(&as, x64_jmp(&as), loop_top);
+
+    // 사이드 이그짓: 쓴 변수를 되쓰고 스택 값을 VM 스택에 올린 뒤 오프셋 반환
+    for (int e = 0; e < exits.count; e++) {
+        TraceExit* exit = &exits.exits[e];
+        for (int j = 0; j < exit->jump_count; j++) x64_patch_here(&as, exit->jumps[j]);
+
+        for (int v = 0; v < rec->variable_count; v++) {
+            TraceVariable* variable = &rec->variables[v];
+            if (!variable->written) continue;
+            x64_movq_from_xmm(&as, RAX, VARIABLE_XMM(v));
+            x64_store(&as, variable_base(variable), (int32_t)(variable->slot * 8), RAX);
+        }
+        for (int i = 0; i < exit->depth; i++) {
+            x64_movq_from_xmm(&as, RAX, i);
+            x64_store(&as, RDX, i * 8, RAX);
+        }
+        x64_byte(&as, 0x41);            // mov dword [r8], depth
+        x64_byte(&as, 0xC7);
+        x64_byte(&as, 0x00);
+        x64_u32(&as, (uint32_t)exit->depth);
+        x64_byte(&as, 0xB8);            // mov eax, resume
+        x64_u32(&as, (uint32_t)exit->resume);
+        x64_byte(&as, 0xC3);
+    }
+
+    // 진입 가드 실패: 아무것도 바꾸지 않고 루프 시작으로
+    for (int i = 0; i < entry_failure_count; i++) x64_patch_here(&as, entry_failures[i]);
+    x64_byte(&as, 0x41);
+    x64_byte(&as, 0xC7);
+    x64_byte(&as, 0x00);
+    x64_u32(&as, 0);
+    x64_byte(&as, 0xB8);
+    x64_u32(&as, (uint32_t)rec->header);
+    x64_byte(&as, 0xC3);
+
+    free(exits.exits);
+
+    size_t size;
+    uint8_t* code = x64_finalize(&as, &size);
+    if (!code) return NULL;
+
+    Trace* trace = (Trace*)malloc(sizeof(Trace));
+    trace->code = code;
+    trace->size = size;
+    trace->header = rec->header;
+    trace->runs = 0;
+    trace->guard_failures = 0;
+    return trace;
+}
+
+static void trace_free(Trace* trace) {
+    if (!trace) return;
+    x64_free_code(trace->code, trace->size);
+    free(trace);
+}
+
+// ============ VM 연결 ============
+
+int trace_enter(VM* vm, BytecodeChunk* chunk, int header, int loop_offset,
+                VMValue* slots, long* loop_count) {
+    TraceCache* cache = chunk->traces;
+    if (!cache) {
+        cache = (TraceCache*)malloc(sizeof(TraceCache));
+        cache->count = chunk->count;
+        cache->hits = (uint16_t*)calloc(chunk->count, sizeof(uint16_t));
+        cache->traces = (Trace**)calloc(chunk->count, sizeof(Trace*));
+        chunk->traces = cache;
+    }
+
+    Trace* trace = cache->traces[header];
+    if (!trace) {
+        if (cache->hits[header] == TRACE_BLACKLISTED || ++cache->hits[header] < TRACE_HOT_LOOP) {
+            return -1;
+        }
+
+        TraceRecorder* rec = (TraceRecorder*)malloc(sizeof(TraceRecorder));
+        rec->chunk = chunk;
+        rec->globals = vm->globals;
+        rec->slots = slots;
+        rec->header = header;
+        rec->loop_offset = loop_offset;
+        rec->variable_count = 0;
+        rec->step_count = 0;
+        rec->depth = 0;
+
+        TraceStatus status = record_trace(rec);
+        if (status == TRACE_OK) trace = compile_trace(rec);
+        free(rec);
+
+        if (!trace) {
+            cache->hits[header] = status == TRACE_RETRY ? 0 : TRACE_BLACKLISTED;
+            return -1;
+        }
+        cache->traces[header] = trace;
+    }
+
+    // 남은 역방향 점프 허용 횟수 (트레이스가 루프를 돌 때마다 하나씩 줄임)
+    long max = vm->max_loop_iterations;
+    long remaining = max > 0 ? max - *loop_count : LONG_MAX;
+    int pushed = 0;
+
+    int resume = ((TraceFunction)trace->code)(vm->globals, slots, vm->stack_top,
+                                              &remaining, &pushed);
+    vm->stack_top += pushed;
+    if (max > 0) *loop_count = max - remaining;
+    trace->runs++;
+
+    // 진입 가드가 자주 실패하면 (변수 타입이 바뀜) 트레이스를 버리고 다시 시도 안 함
+    if (resume == header && ++trace->guard_failures > 16 && trace->guard_failures * 2 > trace->runs) {
+        trace_free(trace);
+        cache->traces[header] = NULL;
+        cache->hits[header] = TRACE_BLACKLISTED;
+    }
+    return resume;
+}
+
+void trace_cache_free(TraceCache* cache) {
+    if (!cache) return;
+    for (int i = 0; i < cache->count; i++) trace_free(cache->traces[i]);
+    free(cache->hits);
+    free(cache->traces);
+    free(cache);
+}
+
+#else
+
+// x86-64가 아니면 트레이스 없음 (vm_run이 계속 해석)
+int trace_enter(VM* vm, BytecodeChunk* chunk, int header, int loop_offset,
+                VMValue* slots, long* loop_count) {
+    (void)vm; (void)chunk; (void)header; (void)loop_offset; (void)slots; (void)loop_count;
+    return -1;
+}
+
+void trace_cache_free(TraceCache* cache) {
+    (void)cache;
+}
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "bytecode.h"
+#include "vm.h"
+
+// 트레이싱 JIT (x86-64 전용, vm_run의 핫 루프용)
+//
+// OP_LOOP(역방향 점프)마다 루프 시작 위치별로 횟수를 세다가 TRACE_HOT_LOOP번이 되면
+// 다음 한 바퀴를 실제 값으로 따라가며 실행 경로와 타입을 기록한다 (숫자만 허용).
+// 기록한 선형 트레이스는 기계어 루프 하나로 컴파일된다:
+//  - 변수는 진입 시 xmm 레지스터로 읽어 루프 안에서는 박싱 없이 double로 계산
+//  - 타입 가드는 루프 밖(진입 시 한 번)으로 올림: 트레이스 안에서 쓰는 값은 모두 숫자이므로
+//    처음 읽는 변수만 검사하면 된다
+//  - 기록할 때와 다른 쪽으로 가는 분기, 0으로 나누기, 루프 횟수 초과는 사이드 이그짓:
+//    변수를 메모리에 되쓰고 남은 스택 값을 VM 스택에 올린 뒤 그 바이트코드 위치에서 vm_run이 이어서 실행
+
+#define TRACE_HOT_LOOP 50         // 기록을 시작하는 역방향 점프 횟수
+#define TRACE_MAX_LENGTH 256      // 트레이스 하나의 최대 명령어 수
+#define TRACE_MAX_VARIABLES 8     // 레지스터에 올리는 변수 수 (xmm8..xmm15)
+#define TRACE_MAX_DEPTH 7         // 표현식 스택 깊이 (xmm0..xmm6, xmm7은 임시)
+
+// 컴파일된 트레이스 (루프 하나)
+typedef struct Trace {
+    uint8_t* code;          // mmap한 실행 메모리
+    size_t size;
+    int header;             // 루프 시작 오프셋 (진입 가드 실패 시 여기로 돌아감)
+    long runs;              // 진입 횟수
+    long guard_failures;    // 진입 가드 실패 횟수 (많으면 트레이스 폐기)
+} Trace;
+
+// 청크별 루프 카운터와 트레이스 (루프 시작 오프셋으로 인덱싱, 처음 쓸 때 할당)
+typedef struct TraceCache {
+    uint16_t* hits;         // 역방향 점프 횟수 (TRACE_BLACKLISTED면 트레이스 포기)
+    Trace** traces;
+    int count;              // 청크 길이
+} TraceCache;
+
+// OP_LOOP가 header로 점프한 직후 호출 (loop_offset = OP_LOOP 위치)
+// 트레이스를 실행했으면 vm_run이 이어서 실행할 오프셋, 아니면 -1
+int trace_enter(VM* vm, BytecodeChunk* chunk, int header, int loop_offset,
+                VMValue* slots, long* loop_count);
+
+void trace_cache_free(TraceCache* cache);
+
+#endif
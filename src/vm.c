@@ -1,484 +1,1070 @@
 #include "vm.h"
+#include "trace.h"
+#include "gc.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdarg.h>
 #include <string.h>
 #include <math.h>
 
+// vm_run 실행 중이면 런타임 에러를 예외로 던짐 (아니면 출력 후 종료)
+static int catch_errors = 0;
+static Value* pending_error = NULL;  // vm_run이 다음에 던질 예외
+
+// GC 루트: 스택 (stack_top 아래만 살아 있음), 전역 슬롯, 던질 예외
+static void mark_vm_roots(void* context) {
+    VM* vm = (VM*)context;
+    for (VMValue* slot = vm->stack; slot < vm->stack_top; slot++) {
+        if (IS_OBJ(*slot)) gc_mark_value(AS_OBJ(*slot));
+    }
+    for (int i = 0; i < vm->global_count; i++) {
+        if (IS_OBJ(vm->globals[i])) gc_mark_value(AS_OBJ(vm->globals[i]));
+    }
+    gc_mark_value(pending_error);
+}
+
 // VM 생성
 VM* vm_create() {
     VM* vm = (VM*)malloc(sizeof(VM));
     vm->chunk = NULL;
     vm->ip = NULL;
-    vm->stack_top = 0;
-    vm->globals = environment_create(NULL);
-    
-    // 스택 초기화
-    for (int i = 0; i < STACK_MAX; i++) {
-        vm->stack[i] = NULL;
-    }
-    
+    vm->stack = (VMValue*)malloc(sizeof(VMValue) * VM_STACK_INITIAL);
+    vm->stack_top = vm->stack;
+    vm->stack_capacity = VM_STACK_INITIAL;
+    vm->frame_count = 0;
+    vm->globals = NULL;
+    vm->global_count = 0;
+    vm->max_loop_iterations = VM_DEFAULT_MAX_LOOPS;
+    vm->jit_loop_budget = 0;
+    vm->trace_enabled = 1;
+
+    gc_add_roots(mark_vm_roots, vm);
     return vm;
 }
 
 // VM 해제
 void vm_free(VM* vm) {
     if (!vm) return;
-    
-    // 스택 정리
-    for (int i = 0; i < vm->stack_top; i++) {
-        // value_free(vm->stack[i]);  // 메모리 관리 간소화
-    }
-    
-    environment_free(vm->globals);
+
+    gc_remove_roots(mark_vm_roots, vm);
+    free(vm->stack);
+    free(vm->globals);
     free(vm);
 }
 
-// 스택에 푸시
-void vm_push(VM* vm, Value* value) {
-    if (vm->stack_top >= STACK_MAX) {
-        fprintf(stderr, "Stack overflow!\n");
-        exit(1);
+// 스택 확보 (두 배씩 늘림, 옮겨진 뒤에는 stack_top도 새 위치로)
+void vm_reserve_stack(VM* vm, int slots) {
+    if (slots <= vm->stack_capacity) return;
+
+    int capacity = vm->stack_capacity;
+    while (capacity < slots) capacity *= 2;
+
+    int top = (int)(vm->stack_top - vm->stack);
+    vm->stack = (VMValue*)realloc(vm->stack, sizeof(VMValue) * capacity);
+    vm->stack_top = vm->stack + top;
+    vm->stack_capacity = capacity;
+}
+
+// 런타임 에러 (인터프리터와 같은 예외 타입 이름)
+// 공용 연산 함수는 에러를 알린 뒤 아무 값이나 돌려주고, vm_run이 호출 뒤에 확인해서 던진다.
+void vm_runtime_error(const char* type, const char* format, ...) {
+    char message[256];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(message, sizeof(message), format, args);
+    va_end(args);
+
+    // JIT/레지스터 VM에는 핸들러가 없으므로 잡히지 않은 예외로 출력하고 끝냄 (인터프리터/vm_run과 같은 종료 코드)
+    if (!catch_errors) {
+        exception_report_uncaught(value_create_exception((char*)type, message));
+        exit(0);
+    }
+    if (!pending_error) {
+        pending_error = value_create_exception((char*)type, message);
     }
-    vm->stack[vm->stack_top++] = value;
 }
 
-// 스택에서 팝
-Value* vm_pop(VM* vm) {
-    if (vm->stack_top <= 0) {
-        fprintf(stderr, "Stack underflow!\n");
-        exit(1);
+// 힙 Value → VMValue (숫자/불리언/null은 즉시값으로 변환)
+VMValue vm_value_from_heap(Value* value) {
+    if (!value) return NULL_VAL;
+
+    switch (value->type) {
+        case VAL_NUMBER: return NUMBER_VAL(value->data.number);
+        case VAL_BOOL:   return BOOL_VAL(value->data.boolean);
+        case VAL_NULL:   return NULL_VAL;
+        default:         return OBJ_VAL(value);
     }
-    return vm->stack[--vm->stack_top];
 }
 
-// 스택 peek (제거하지 않고 확인)
-Value* vm_peek(VM* vm, int distance) {
-    if (vm->stack_top - 1 - distance < 0) {
-        return NULL;
+// VMValue → 힙 Value (환경/배열처럼 Value*가 필요한 곳에 저장할 때만 할당)
+Value* vm_value_to_heap(VMValue value) {
+    if (IS_NUMBER(value)) return value_create_number(AS_NUMBER(value));
+    if (IS_BOOL(value)) return value_create_bool(AS_BOOL(value));
+    if (IS_OBJ(value)) return AS_OBJ(value);
+    return value_create_null();
+}
+
+// VMValue 출력 (value_print와 같은 형식)
+void vm_value_print(VMValue value) {
+    if (IS_NUMBER(value)) {
+        double num = AS_NUMBER(value);
+        if (num == (int)num) {
+            printf("%d", (int)num);
+        } else {
+            printf("%g", num);
+        }
+    } else if (IS_BOOL(value)) {
+        printf("%s", AS_BOOL(value) ? "true" : "false");
+    } else if (IS_OBJ(value)) {
+        value_print(AS_OBJ(value));
+    } else {
+        printf("null");
     }
-    return vm->stack[vm->stack_top - 1 - distance];
 }
 
-// 다음 명령어 읽기
-static Instruction* read_instruction(VM* vm) {
-    return vm->ip++;
+// 조건 판정 (false, 0만 거짓)
+int vm_is_falsey(VMValue value) {
+    if (IS_BOOL(value)) return !AS_BOOL(value);
+    if (IS_NUMBER(value)) return AS_NUMBER(value) == 0;
+    return 0;
 }
 
-// VM 실행
-void vm_run(VM* vm, BytecodeChunk* chunk) {
-    vm->chunk = chunk;
-    vm->ip = chunk->instructions;
-    
-    int instruction_count = 0;
-    int max_instructions = 10000; // 안전 장치
-    
-    while (1) {
-        if (instruction_count++ > max_instructions) {
-            fprintf(stderr, "Too many instructions executed! Possible infinite loop.\n");
-            return;
+// 문자열 연결 결과 생성
+VMValue vm_concat_strings(Value* left, Value* right) {
+    int len = strlen(left->data.string) + strlen(right->data.string);
+    char* result = (char*)malloc(len + 1);
+    strcpy(result, left->data.string);
+    strcat(result, right->data.string);
+    Value* str = value_create_string(result);
+    free(result);
+    return OBJ_VAL(str);
+}
+
+// 문자열 반복 결과 생성 (음수 횟수는 빈 문자열)
+VMValue vm_repeat_string(Value* string, double count) {
+    char* str = string->data.string;
+    int repeat = (int)count;
+    if (repeat < 0) repeat = 0;
+    int len = strlen(str) * repeat;
+    char* result = (char*)malloc(len + 1);
+    result[0] = '\0';
+    for (int i = 0; i < repeat; i++) {
+        strcat(result, str);
+    }
+    Value* repeated = value_create_string(result);
+    free(result);
+    return OBJ_VAL(repeated);
+}
+
+// 디스패치 방식
+//  - 기본: GCC labels-as-values 스레디드 코드 (핸들러 끝에서 다음 핸들러로 간접 점프 한 번)
+//  - make DISPATCH=switch: 이식성용 switch 루프 (VM_SWITCH_DISPATCH)
+// 두 방식 모두 명령어마다 ip 범위 검사나 카운터 증가를 하지 않는다.
+// ip의 안전성은 실행 전 bytecode_verify가 보장하고, 무한 루프 방지는 OP_LOOP(역방향 점프)에서만 센다.
+#if defined(__GNUC__) && !defined(VM_SWITCH_DISPATCH)
+#define VM_THREADED_DISPATCH 1
+#endif
+
+#ifdef VM_THREADED_DISPATCH
+#define VM_CASE(op) L_##op
+#define DISPATCH() goto *dispatch_table[*ip++]
+#else
+#define VM_CASE(op) case op
+#define DISPATCH() continue
+#endif
+
+// 런타임 에러를 예외로 던짐 (핸들러 안에서만 사용)
+#define THROW_ERROR(...) do { vm_runtime_error(__VA_ARGS__); goto throw_pending; } while (0)
+
+// 공용 연산 함수가 에러를 알렸으면 던짐
+#define CHECK_ERROR() do { if (pending_error) goto throw_pending; } while (0)
+
+// 피연산자 읽기 (리틀 엔디안, ip는 다음 명령어로 이동)
+#define READ_BYTE() (*ip++)
+#define READ_U16() (ip += 2, bytecode_read_u16(ip - 2))
+#define READ_U32() (ip += 4, bytecode_read_u32(ip - 4))
+
+// 인덱스 접근 (배열/문자열, INDEX와 INDEX_LOCALS/INDEX_GLOBALS 공용)
+VMValue vm_index_value(VMValue target, VMValue index) {
+    if (IS_OBJ_TYPE(target, VAL_ARRAY)) {
+        if (!IS_NUMBER(index)) {
+            vm_runtime_error("TypeError", "list indices must be numbers");
+            return NULL_VAL;
         }
-        
-        // 범위 체크
-        long offset = vm->ip - chunk->instructions;
-        if (offset < 0 || offset >= chunk->count) {
-            fprintf(stderr, "Instruction pointer out of bounds: %ld (max: %d)\n", offset, chunk->count);
-            return;
+
+        Value* array = AS_OBJ(target);
+        int idx = (int)AS_NUMBER(index);
+        if (idx < 0 || idx >= array->data.array->count) {
+            vm_runtime_error("IndexError", "list index out of range: %d", idx);
+            return NULL_VAL;
         }
-        
-        Instruction* instr = read_instruction(vm);
-        
-        switch (instr->opcode) {
-            case OP_LOAD_CONST: {
-                int index = (int)instr->operand.int_operand;
-                Value* constant = chunk->constants[index];
-                vm_push(vm, value_copy(constant));
-                break;
+
+        // VM에는 배열을 제자리에서 수정하는 명령이 없으므로 요소를 복사 없이 공유
+        return vm_value_from_heap(array->data.array->elements[idx]);
+    } else if (IS_OBJ_TYPE(target, VAL_STRING)) {
+        if (!IS_NUMBER(index)) {
+            vm_runtime_error("TypeError", "string indices must be numbers");
+            return NULL_VAL;
+        }
+
+        char* string = AS_OBJ(target)->data.string;
+        int idx = (int)AS_NUMBER(index);
+        int len = strlen(string);
+        if (idx < 0 || idx >= len) {
+            vm_runtime_error("IndexError", "string index out of range: %d", idx);
+            return NULL_VAL;
+        }
+
+        char str[2] = {string[idx], '\0'};
+        return OBJ_VAL(value_create_string(str));
+    }
+
+    vm_runtime_error("TypeError", "only lists and strings can be indexed");
+    return NULL_VAL;
+}
+
+// for 루프 대상의 길이 (배열/문자열)
+int vm_length(VMValue target) {
+    if (IS_OBJ_TYPE(target, VAL_ARRAY)) {
+        return AS_OBJ(target)->data.array->count;
+    } else if (IS_OBJ_TYPE(target, VAL_STRING)) {
+        return strlen(AS_OBJ(target)->data.string);
+    }
+    vm_runtime_error("TypeError", "only lists and strings can be iterated");
+    return 0;
+}
+
+// 같음 비교 (EQUAL/NOT_EQUAL 공용)
+int vm_values_equal(VMValue left, VMValue right) {
+    if (IS_NUMBER(left) && IS_NUMBER(right)) {
+        return AS_NUMBER(left) == AS_NUMBER(right);
+    } else if (IS_BOOL(left) && IS_BOOL(right)) {
+        return left == right;
+    } else if (IS_OBJ_TYPE(left, VAL_STRING) && IS_OBJ_TYPE(right, VAL_STRING)) {
+        // 인턴된 문자열 상수끼리는 포인터만 같으면 끝
+        return left == right || strcmp(AS_OBJ(left)->data.string, AS_OBJ(right)->data.string) == 0;
+    }
+    return 0;
+}
+
+// 내장 함수 호출 (len, range), 인자가 맞지 않으면 null
+VMValue vm_call_builtin(int builtin, VMValue* args, int arg_count) {
+    VMValue result = NULL_VAL;
+
+    switch (builtin) {
+        case BUILTIN_LEN:
+            if (arg_count > 0 && IS_OBJ_TYPE(args[0], VAL_ARRAY)) {
+                result = NUMBER_VAL(AS_OBJ(args[0])->data.array->count);
+            } else if (arg_count > 0 && IS_OBJ_TYPE(args[0], VAL_DICT)) {
+                result = NUMBER_VAL(AS_OBJ(args[0])->data.dict->count);
+            } else if (arg_count > 0 && IS_OBJ_TYPE(args[0], VAL_STRING)) {
+                result = NUMBER_VAL(strlen(AS_OBJ(args[0])->data.string));
             }
-            
-            case OP_LOAD_TRUE:
-                vm_push(vm, value_create_bool(1));
-                break;
-            
-            case OP_LOAD_FALSE:
-                vm_push(vm, value_create_bool(0));
-                break;
-            
-            case OP_LOAD_NULL:
-                vm_push(vm, value_create_null());
+            break;
+
+        case BUILTIN_RANGE:
+            if (arg_count >= 2 && IS_NUMBER(args[0]) && IS_NUMBER(args[1])) {
+                int start = (int)AS_NUMBER(args[0]);
+                int count = (int)AS_NUMBER(args[1]) - start;
+                if (count < 0) count = 0;
+
+                Value** elements = (Value**)malloc(sizeof(Value*) * (count > 0 ? count : 1));
+                for (int i = 0; i < count; i++) {
+                    elements[i] = value_create_number(start + i);
+                }
+                result = OBJ_VAL(value_create_array(elements, count));
+            }
+            break;
+    }
+
+    return result;
+}
+
+// 이항 연산자 기호 (타입 에러 메시지용)
+const char* vm_operator_symbol(OpCode opcode) {
+    switch (bytecode_generic_opcode(opcode)) {
+        case OP_ADD:           return "+";
+        case OP_SUBTRACT:      return "-";
+        case OP_MULTIPLY:      return "*";
+        case OP_DIVIDE:        return "/";
+        case OP_MODULO:        return "%";
+        case OP_FLOOR_DIV:     return "//";
+        case OP_LESS:          return "<";
+        case OP_LESS_EQUAL:    return "<=";
+        case OP_GREATER:       return ">";
+        case OP_GREATER_EQUAL: return ">=";
+        default:               return bytecode_opcode_name(opcode);
+    }
+}
+
+// 이항 연산 전체 의미 (문자열 연산과 타입/0 나누기 에러 포함, JIT의 느린 경로)
+VMValue vm_binary_op(OpCode opcode, VMValue left, VMValue right) {
+    if (opcode == OP_EQUAL) return BOOL_VAL(vm_values_equal(left, right));
+    if (opcode == OP_NOT_EQUAL) return BOOL_VAL(!vm_values_equal(left, right));
+
+    if (IS_NUMBER(left) && IS_NUMBER(right)) {
+        double a = AS_NUMBER(left);
+        double b = AS_NUMBER(right);
+        switch (opcode) {
+            case OP_ADD:           return NUMBER_VAL(a + b);
+            case OP_SUBTRACT:      return NUMBER_VAL(a - b);
+            case OP_MULTIPLY:      return NUMBER_VAL(a * b);
+            case OP_LESS:          return BOOL_VAL(a < b);
+            case OP_LESS_EQUAL:    return BOOL_VAL(a <= b);
+            case OP_GREATER:       return BOOL_VAL(a > b);
+            case OP_GREATER_EQUAL: return BOOL_VAL(a >= b);
+            case OP_DIVIDE:
+                if (b == 0) {
+                    vm_runtime_error("ZeroDivisionError", "division by zero");
+                    return NULL_VAL;
+                }
+                return NUMBER_VAL(a / b);
+            case OP_MODULO:
+                if (b == 0) {
+                    vm_runtime_error("ZeroDivisionError", "modulo by zero");
+                    return NULL_VAL;
+                }
+                return NUMBER_VAL(fmod(a, b));
+            case OP_FLOOR_DIV:
+                if (b == 0) {
+                    vm_runtime_error("ZeroDivisionError", "floor division by zero");
+                    return NULL_VAL;
+                }
+                return NUMBER_VAL(floor(a / b));
+            default:
                 break;
-            
-            case OP_ADD: {
-                Value* right = vm_pop(vm);
-                Value* left = vm_pop(vm);
-                
-                if (left->type == VAL_NUMBER && right->type == VAL_NUMBER) {
-                    vm_push(vm, value_create_number(left->data.number + right->data.number));
-                } else if (left->type == VAL_STRING && right->type == VAL_STRING) {
+        }
+    } else if (opcode == OP_ADD && IS_OBJ_TYPE(left, VAL_STRING) && IS_OBJ_TYPE(right, VAL_STRING)) {
+        return vm_concat_strings(AS_OBJ(left), AS_OBJ(right));
+    } else if (opcode == OP_MULTIPLY && IS_OBJ_TYPE(left, VAL_STRING) && IS_NUMBER(right)) {
+        return vm_repeat_string(AS_OBJ(left), AS_NUMBER(right));
+    }
+
+    vm_runtime_error("TypeError", "unsupported operand types for %s", vm_operator_symbol(opcode));
+    return NULL_VAL;
+}
+
+// 단항 연산 (NEGATE, NOT)
+VMValue vm_unary_op(OpCode opcode, VMValue value) {
+    if (opcode == OP_NOT) {
+        if (IS_BOOL(value)) return BOOL_VAL(!AS_BOOL(value));
+        if (IS_NUMBER(value)) return BOOL_VAL(AS_NUMBER(value) == 0);
+        return FALSE_VAL;
+    }
+
+    if (!IS_NUMBER(value)) {
+        vm_runtime_error("TypeError", "bad operand type for unary -");
+        return NULL_VAL;
+    }
+    return NUMBER_VAL(-AS_NUMBER(value));
+}
+
+// 예외에 VM 호출 스택 기록 (인터프리터의 exception_attach_stack_trace와 같은 모양)
+// 가장 안쪽 함수가 먼저, 라인은 그 함수를 부른 CALL의 라인
+static void attach_stack_trace(VM* vm, Value* exception) {
+    if (exception->data.exception->stack_trace) {
+        stack_frame_free(exception->data.exception->stack_trace);
+    }
+
+    StackFrame* trace = NULL;
+    for (int i = 1; i < vm->frame_count; i++) {
+        CallFrame* caller = &vm->frames[i - 1];
+        int line = bytecode_line_at(caller->chunk, (int)(caller->ip - caller->chunk->code) - 1);
+        StackFrame* entry = stack_frame_create(vm->frames[i].chunk->name, "<input>", line);
+        entry->next = trace;
+        trace = entry;
+    }
+    exception->data.exception->stack_trace = trace;
+    exception->data.exception->stack_depth = vm->frame_count - 1;
+}
+
+static void execute(VM* vm, BytecodeChunk* chunk);
+
+// VM 실행 (실행하는 동안 공용 연산 함수의 런타임 에러는 예외로 던짐)
+int vm_run(VM* vm, BytecodeChunk* chunk) {
+    // 점프 대상/피연산자/HALT 종료를 미리 검증 (실행 중에는 범위 검사 없음)
+    if (!bytecode_verify(chunk)) {
+        fprintf(stderr, "Invalid bytecode chunk, refusing to run\n");
+        return 0;
+    }
+
+    catch_errors = 1;
+    execute(vm, chunk);
+    catch_errors = 0;
+    pending_error = NULL;
+    return 1;
+}
+
+static void execute(VM* vm, BytecodeChunk* chunk) {
+    vm->chunk = chunk;
+
+    // 전역 슬롯 준비 (새로 생긴 슬롯은 미정의 상태)
+    if (chunk->global_count > vm->global_count) {
+        vm->globals = (VMValue*)realloc(vm->globals, sizeof(VMValue) * chunk->global_count);
+        for (int i = vm->global_count; i < chunk->global_count; i++) {
+            vm->globals[i] = UNDEFINED_VAL;
+        }
+        vm->global_count = chunk->global_count;
+    }
+
+    // 스크립트 프레임 (슬롯은 스택 바닥부터, 전역이 아닌 숨은 지역 변수용)
+    vm->stack_top = vm->stack;
+    vm_reserve_stack(vm, chunk->max_stack);
+    CallFrame* frame = &vm->frames[0];
+    frame->chunk = chunk;
+    frame->ip = chunk->code;
+    frame->base = 0;
+    vm->frame_count = 1;
+
+    uint8_t* ip = chunk->code;
+    VMValue* slots = &vm->stack[frame->base];
+    uint32_t operand;     // 1/4바이트 변형이 공유하는 핸들러용
+    Value* exception;     // 던지는 중인 예외 (throw_exception으로 갈 때 채움)
+    long loop_count = 0;  // 역방향 점프 횟수
+
+#ifdef VM_THREADED_DISPATCH
+    static void* dispatch_table[] = {
+        [OP_LOAD_CONST]    = &&L_OP_LOAD_CONST,
+        [OP_LOAD_CONST_LONG] = &&L_OP_LOAD_CONST_LONG,
+        [OP_LOAD_TRUE]     = &&L_OP_LOAD_TRUE,
+        [OP_LOAD_FALSE]    = &&L_OP_LOAD_FALSE,
+        [OP_LOAD_NULL]     = &&L_OP_LOAD_NULL,
+        [OP_LOAD_GLOBAL]   = &&L_OP_LOAD_GLOBAL,
+        [OP_LOAD_GLOBAL_LONG] = &&L_OP_LOAD_GLOBAL_LONG,
+        [OP_STORE_GLOBAL]  = &&L_OP_STORE_GLOBAL,
+        [OP_STORE_GLOBAL_LONG] = &&L_OP_STORE_GLOBAL_LONG,
+        [OP_LOAD_LOCAL]    = &&L_OP_LOAD_LOCAL,
+        [OP_STORE_LOCAL]   = &&L_OP_STORE_LOCAL,
+        [OP_ADD]           = &&L_OP_ADD,
+        [OP_SUBTRACT]      = &&L_OP_SUBTRACT,
+        [OP_MULTIPLY]      = &&L_OP_MULTIPLY,
+        [OP_DIVIDE]        = &&L_OP_DIVIDE,
+        [OP_MODULO]        = &&L_OP_MODULO,
+        [OP_FLOOR_DIV]     = &&L_OP_FLOOR_DIV,
+        [OP_NEGATE]        = &&L_OP_NEGATE,
+        [OP_EQUAL]         = &&L_OP_EQUAL,
+        [OP_NOT_EQUAL]     = &&L_OP_NOT_EQUAL,
+        [OP_LESS]          = &&L_OP_LESS,
+        [OP_LESS_EQUAL]    = &&L_OP_LESS_EQUAL,
+        [OP_GREATER]       = &&L_OP_GREATER,
+        [OP_GREATER_EQUAL] = &&L_OP_GREATER_EQUAL,
+        [OP_NOT]           = &&L_OP_NOT,
+        [OP_BUILD_ARRAY]   = &&L_OP_BUILD_ARRAY,
+        [OP_BUILD_ARRAY_LONG] = &&L_OP_BUILD_ARRAY_LONG,
+        [OP_BUILD_DICT]    = &&L_unknown,
+        [OP_INDEX]         = &&L_OP_INDEX,
+        [OP_STORE_INDEX]   = &&L_unknown,
+        [OP_ARRAY_LENGTH]  = &&L_OP_ARRAY_LENGTH,
+        [OP_JUMP]          = &&L_OP_JUMP,
+        [OP_JUMP_IF_FALSE] = &&L_OP_JUMP_IF_FALSE,
+        [OP_JUMP_IF_TRUE]  = &&L_OP_JUMP_IF_TRUE,
+        [OP_LOOP]          = &&L_OP_LOOP,
+        [OP_CALL]          = &&L_OP_CALL,
+        [OP_RETURN]        = &&L_OP_RETURN,
+        [OP_CALL_BUILTIN]  = &&L_OP_CALL_BUILTIN,
+        [OP_PRINT]         = &&L_OP_PRINT,
+        [OP_POP]           = &&L_OP_POP,
+        [OP_DUP]           = &&L_OP_DUP,
+        [OP_THROW]         = &&L_OP_THROW,
+        [OP_JUMP_IF_NOT_LESS] = &&L_OP_JUMP_IF_NOT_LESS,
+        [OP_INCR_LOCAL]    = &&L_OP_INCR_LOCAL,
+        [OP_INCR_GLOBAL]   = &&L_OP_INCR_GLOBAL,
+        [OP_INDEX_LOCALS]  = &&L_OP_INDEX_LOCALS,
+        [OP_INDEX_GLOBALS] = &&L_OP_INDEX_GLOBALS,
+        [OP_ADD_CONST]     = &&L_OP_ADD_CONST,
+        [OP_ADD_NUM]       = &&L_OP_ADD_NUM,
+        [OP_ADD_STR]       = &&L_OP_ADD_STR,
+        [OP_SUBTRACT_NUM]  = &&L_OP_SUBTRACT_NUM,
+        [OP_MULTIPLY_NUM]  = &&L_OP_MULTIPLY_NUM,
+        [OP_LESS_NUM]      = &&L_OP_LESS_NUM,
+        [OP_LESS_EQUAL_NUM] = &&L_OP_LESS_EQUAL_NUM,
+        [OP_GREATER_NUM]   = &&L_OP_GREATER_NUM,
+        [OP_GREATER_EQUAL_NUM] = &&L_OP_GREATER_EQUAL_NUM,
+        [OP_HALT]          = &&L_OP_HALT,
+    };
+
+    DISPATCH();
+#else
+    for (;;) {
+        switch (*ip++) {
+#endif
+            VM_CASE(OP_LOAD_CONST):
+                vm_push(vm, vm_value_from_heap(chunk->constants[READ_BYTE()]));
+                DISPATCH();
+
+            VM_CASE(OP_LOAD_CONST_LONG):
+                vm_push(vm, vm_value_from_heap(chunk->constants[READ_U32()]));
+                DISPATCH();
+
+            VM_CASE(OP_LOAD_TRUE):
+                vm_push(vm, TRUE_VAL);
+                DISPATCH();
+
+            VM_CASE(OP_LOAD_FALSE):
+                vm_push(vm, FALSE_VAL);
+                DISPATCH();
+
+            VM_CASE(OP_LOAD_NULL):
+                vm_push(vm, NULL_VAL);
+                DISPATCH();
+
+            VM_CASE(OP_ADD):
+            op_add: {
+                VMValue right = vm_pop(vm);
+                VMValue left = vm_pop(vm);
+
+                if (IS_NUMBER(left) && IS_NUMBER(right)) {
+                    ip[-1] = OP_ADD_NUM;
+                    vm_push(vm, NUMBER_VAL(AS_NUMBER(left) + AS_NUMBER(right)));
+                } else if (IS_OBJ_TYPE(left, VAL_STRING) && IS_OBJ_TYPE(right, VAL_STRING)) {
                     // 문자열 연결
-                    int len = strlen(left->data.string) + strlen(right->data.string);
-                    char* result = (char*)malloc(len + 1);
-                    strcpy(result, left->data.string);
-                    strcat(result, right->data.string);
-                    vm_push(vm, value_create_string(result));
-                    free(result);
+                    ip[-1] = OP_ADD_STR;
+                    vm_push(vm, vm_concat_strings(AS_OBJ(left), AS_OBJ(right)));
                 } else {
-                    fprintf(stderr, "Type error in ADD\n");
-                    exit(1);
+                    THROW_ERROR("TypeError", "unsupported operand types for +");
                 }
-                break;
+                DISPATCH();
             }
-            
-            case OP_SUBTRACT: {
-                Value* right = vm_pop(vm);
-                Value* left = vm_pop(vm);
-                
-                if (left->type == VAL_NUMBER && right->type == VAL_NUMBER) {
-                    vm_push(vm, value_create_number(left->data.number - right->data.number));
+
+            VM_CASE(OP_SUBTRACT):
+            op_subtract: {
+                VMValue right = vm_pop(vm);
+                VMValue left = vm_pop(vm);
+
+                if (IS_NUMBER(left) && IS_NUMBER(right)) {
+                    ip[-1] = OP_SUBTRACT_NUM;
+                    vm_push(vm, NUMBER_VAL(AS_NUMBER(left) - AS_NUMBER(right)));
                 } else {
-                    fprintf(stderr, "Type error in SUBTRACT\n");
-                    exit(1);
+                    THROW_ERROR("TypeError", "unsupported operand types for -");
                 }
-                break;
+                DISPATCH();
             }
-            
-            case OP_MULTIPLY: {
-                Value* right = vm_pop(vm);
-                Value* left = vm_pop(vm);
-                
-                if (left->type == VAL_NUMBER && right->type == VAL_NUMBER) {
-                    vm_push(vm, value_create_number(left->data.number * right->data.number));
-                } else if (left->type == VAL_STRING && right->type == VAL_NUMBER) {
+
+            VM_CASE(OP_MULTIPLY):
+            op_multiply: {
+                VMValue right = vm_pop(vm);
+                VMValue left = vm_pop(vm);
+
+                if (IS_NUMBER(left) && IS_NUMBER(right)) {
+                    ip[-1] = OP_MULTIPLY_NUM;
+                    vm_push(vm, NUMBER_VAL(AS_NUMBER(left) * AS_NUMBER(right)));
+                } else if (IS_OBJ_TYPE(left, VAL_STRING) && IS_NUMBER(right)) {
                     // 문자열 반복
-                    int repeat = (int)right->data.number;
-                    if (repeat < 0) repeat = 0;
-                    int len = strlen(left->data.string) * repeat;
-                    char* result = (char*)malloc(len + 1);
-                    result[0] = '\0';
-                    for (int i = 0; i < repeat; i++) {
-                        strcat(result, left->data.string);
-                    }
-                    vm_push(vm, value_create_string(result));
-                    free(result);
+                    vm_push(vm, vm_repeat_string(AS_OBJ(left), AS_NUMBER(right)));
                 } else {
-                    fprintf(stderr, "Type error in MULTIPLY\n");
-                    exit(1);
+                    THROW_ERROR("TypeError", "unsupported operand types for *");
                 }
-                break;
+                DISPATCH();
             }
-            
-            case OP_DIVIDE: {
-                Value* right = vm_pop(vm);
-                Value* left = vm_pop(vm);
-                
-                if (left->type == VAL_NUMBER && right->type == VAL_NUMBER) {
-                    if (right->data.number == 0) {
-                        fprintf(stderr, "Division by zero\n");
-                        exit(1);
+
+            VM_CASE(OP_DIVIDE): {
+                VMValue right = vm_pop(vm);
+                VMValue left = vm_pop(vm);
+
+                if (IS_NUMBER(left) && IS_NUMBER(right)) {
+                    if (AS_NUMBER(right) == 0) {
+                        THROW_ERROR("ZeroDivisionError", "division by zero");
                     }
-                    vm_push(vm, value_create_number(left->data.number / right->data.number));
+                    vm_push(vm, NUMBER_VAL(AS_NUMBER(left) / AS_NUMBER(right)));
                 } else {
-                    fprintf(stderr, "Type error in DIVIDE\n");
-                    exit(1);
+                    THROW_ERROR("TypeError", "unsupported operand types for /");
                 }
-                break;
+                DISPATCH();
             }
-            
-            case OP_MODULO: {
-                Value* right = vm_pop(vm);
-                Value* left = vm_pop(vm);
-                
-                if (left->type == VAL_NUMBER && right->type == VAL_NUMBER) {
-                    if (right->data.number == 0) {
-                        fprintf(stderr, "Modulo by zero\n");
-                        exit(1);
+
+            VM_CASE(OP_MODULO): {
+                VMValue right = vm_pop(vm);
+                VMValue left = vm_pop(vm);
+
+                if (IS_NUMBER(left) && IS_NUMBER(right)) {
+                    if (AS_NUMBER(right) == 0) {
+                        THROW_ERROR("ZeroDivisionError", "modulo by zero");
                     }
-                    vm_push(vm, value_create_number(fmod(left->data.number, right->data.number)));
+                    vm_push(vm, NUMBER_VAL(fmod(AS_NUMBER(left), AS_NUMBER(right))));
                 } else {
-                    fprintf(stderr, "Type error in MODULO\n");
-                    exit(1);
+                    THROW_ERROR("TypeError", "unsupported operand types for %");
                 }
-                break;
+                DISPATCH();
             }
-            
-            case OP_FLOOR_DIV: {
-                Value* right = vm_pop(vm);
-                Value* left = vm_pop(vm);
-                
-                if (left->type == VAL_NUMBER && right->type == VAL_NUMBER) {
-                    if (right->data.number == 0) {
-                        fprintf(stderr, "Floor division by zero\n");
-                        exit(1);
+
+            VM_CASE(OP_FLOOR_DIV): {
+                VMValue right = vm_pop(vm);
+                VMValue left = vm_pop(vm);
+
+                if (IS_NUMBER(left) && IS_NUMBER(right)) {
+                    if (AS_NUMBER(right) == 0) {
+                        THROW_ERROR("ZeroDivisionError", "floor division by zero");
                     }
-                    vm_push(vm, value_create_number(floor(left->data.number / right->data.number)));
+                    vm_push(vm, NUMBER_VAL(floor(AS_NUMBER(left) / AS_NUMBER(right))));
                 } else {
-                    fprintf(stderr, "Type error in FLOOR_DIV\n");
-                    exit(1);
+                    THROW_ERROR("TypeError", "unsupported operand types for //");
                 }
-                break;
+                DISPATCH();
             }
-            
-            case OP_NEGATE: {
-                Value* value = vm_pop(vm);
-                if (value->type == VAL_NUMBER) {
-                    vm_push(vm, value_create_number(-value->data.number));
+
+            VM_CASE(OP_NEGATE): {
+                VMValue value = vm_pop(vm);
+                if (IS_NUMBER(value)) {
+                    vm_push(vm, NUMBER_VAL(-AS_NUMBER(value)));
                 } else {
-                    fprintf(stderr, "Type error in NEGATE\n");
-                    exit(1);
+                    THROW_ERROR("TypeError", "bad operand type for unary -");
                 }
-                break;
+                DISPATCH();
             }
-            
-            case OP_EQUAL: {
-                Value* right = vm_pop(vm);
-                Value* left = vm_pop(vm);
-                
-                int result = 0;
-                if (left->type == VAL_NUMBER && right->type == VAL_NUMBER) {
-                    result = (left->data.number == right->data.number);
-                } else if (left->type == VAL_BOOL && right->type == VAL_BOOL) {
-                    result = (left->data.boolean == right->data.boolean);
-                } else if (left->type == VAL_STRING && right->type == VAL_STRING) {
-                    result = (strcmp(left->data.string, right->data.string) == 0);
-                }
-                
-                vm_push(vm, value_create_bool(result));
-                break;
+
+            VM_CASE(OP_EQUAL): {
+                VMValue right = vm_pop(vm);
+                VMValue left = vm_pop(vm);
+                vm_push(vm, BOOL_VAL(vm_values_equal(left, right)));
+                DISPATCH();
             }
-            
-            case OP_NOT_EQUAL: {
-                Value* right = vm_pop(vm);
-                Value* left = vm_pop(vm);
-                
-                int result = 1;
-                if (left->type == VAL_NUMBER && right->type == VAL_NUMBER) {
-                    result = (left->data.number != right->data.number);
-                } else if (left->type == VAL_BOOL && right->type == VAL_BOOL) {
-                    result = (left->data.boolean != right->data.boolean);
-                } else if (left->type == VAL_STRING && right->type == VAL_STRING) {
-                    result = (strcmp(left->data.string, right->data.string) != 0);
-                }
-                
-                vm_push(vm, value_create_bool(result));
-                break;
+
+            VM_CASE(OP_NOT_EQUAL): {
+                VMValue right = vm_pop(vm);
+                VMValue left = vm_pop(vm);
+                vm_push(vm, BOOL_VAL(!vm_values_equal(left, right)));
+                DISPATCH();
             }
-            
-            case OP_LESS: {
-                Value* right = vm_pop(vm);
-                Value* left = vm_pop(vm);
-                
-                if (left->type == VAL_NUMBER && right->type == VAL_NUMBER) {
-                    vm_push(vm, value_create_bool(left->data.number < right->data.number));
+
+            VM_CASE(OP_LESS):
+            op_less: {
+                VMValue right = vm_pop(vm);
+                VMValue left = vm_pop(vm);
+
+                if (IS_NUMBER(left) && IS_NUMBER(right)) {
+                    ip[-1] = OP_LESS_NUM;
+                    vm_push(vm, BOOL_VAL(AS_NUMBER(left) < AS_NUMBER(right)));
                 } else {
-                    fprintf(stderr, "Type error in LESS\n");
-                    exit(1);
+                    THROW_ERROR("TypeError", "unsupported operand types for <");
                 }
-                break;
+                DISPATCH();
             }
-            
-            case OP_LESS_EQUAL: {
-                Value* right = vm_pop(vm);
-                Value* left = vm_pop(vm);
-                
-                if (left->type == VAL_NUMBER && right->type == VAL_NUMBER) {
-                    vm_push(vm, value_create_bool(left->data.number <= right->data.number));
+
+            VM_CASE(OP_LESS_EQUAL):
+            op_less_equal: {
+                VMValue right = vm_pop(vm);
+                VMValue left = vm_pop(vm);
+
+                if (IS_NUMBER(left) && IS_NUMBER(right)) {
+                    ip[-1] = OP_LESS_EQUAL_NUM;
+                    vm_push(vm, BOOL_VAL(AS_NUMBER(left) <= AS_NUMBER(right)));
                 } else {
-                    fprintf(stderr, "Type error in LESS_EQUAL\n");
-                    exit(1);
+                    THROW_ERROR("TypeError", "unsupported operand types for <=");
                 }
-                break;
+                DISPATCH();
             }
-            
-            case OP_GREATER: {
-                Value* right = vm_pop(vm);
-                Value* left = vm_pop(vm);
-                
-                if (left->type == VAL_NUMBER && right->type == VAL_NUMBER) {
-                    vm_push(vm, value_create_bool(left->data.number > right->data.number));
+
+            VM_CASE(OP_GREATER):
+            op_greater: {
+                VMValue right = vm_pop(vm);
+                VMValue left = vm_pop(vm);
+
+                if (IS_NUMBER(left) && IS_NUMBER(right)) {
+                    ip[-1] = OP_GREATER_NUM;
+                    vm_push(vm, BOOL_VAL(AS_NUMBER(left) > AS_NUMBER(right)));
                 } else {
-                    fprintf(stderr, "Type error in GREATER\n");
-                    exit(1);
+                    THROW_ERROR("TypeError", "unsupported operand types for >");
                 }
-                break;
+                DISPATCH();
             }
-            
-            case OP_GREATER_EQUAL: {
-                Value* right = vm_pop(vm);
-                Value* left = vm_pop(vm);
-                
-                if (left->type == VAL_NUMBER && right->type == VAL_NUMBER) {
-                    vm_push(vm, value_create_bool(left->data.number >= right->data.number));
+
+            VM_CASE(OP_GREATER_EQUAL):
+            op_greater_equal: {
+                VMValue right = vm_pop(vm);
+                VMValue left = vm_pop(vm);
+
+                if (IS_NUMBER(left) && IS_NUMBER(right)) {
+                    ip[-1] = OP_GREATER_EQUAL_NUM;
+                    vm_push(vm, BOOL_VAL(AS_NUMBER(left) >= AS_NUMBER(right)));
                 } else {
-                    fprintf(stderr, "Type error in GREATER_EQUAL\n");
-                    exit(1);
+                    THROW_ERROR("TypeError", "unsupported operand types for >=");
                 }
-                break;
+                DISPATCH();
             }
-            
-            case OP_NOT: {
-                Value* value = vm_pop(vm);
+
+            VM_CASE(OP_NOT): {
+                VMValue value = vm_pop(vm);
                 int result = 0;
-                
-                if (value->type == VAL_BOOL) {
-                    result = !value->data.boolean;
-                } else if (value->type == VAL_NUMBER) {
-                    result = (value->data.number == 0);
-                }
-                
-                vm_push(vm, value_create_bool(result));
-                break;
+
+                if (IS_BOOL(value)) {
+                    result = !AS_BOOL(value);
+                } else if (IS_NUMBER(value)) {
+                    result = (AS_NUMBER(value) == 0);
+                }
+
+                vm_push(vm, BOOL_VAL(result));
+                DISPATCH();
             }
-            
-            case OP_PRINT: {
-                Value* value = vm_pop(vm);
-                value_print(value);
+
+            VM_CASE(OP_PRINT): {
+                VMValue value = vm_pop(vm);
+                vm_value_print(value);
                 printf("\n");
-                break;
+                DISPATCH();
             }
-            
-            case OP_POP: {
+
+            VM_CASE(OP_POP): {
                 vm_pop(vm);
-                break;
+                DISPATCH();
             }
-            
-            case OP_DUP: {
-                Value* value = vm_peek(vm, 0);
-                vm_push(vm, value_copy(value));
-                break;
-            }
-            
-            case OP_LOAD_VAR: {
-                int index = (int)instr->operand.int_operand;
-                Value* var_name = chunk->constants[index];
-                
-                if (var_name->type != VAL_STRING) {
-                    fprintf(stderr, "Variable name must be a string\n");
-                    exit(1);
-                }
-                
-                Value* value = environment_get(vm->globals, var_name->data.string);
-                if (!value) {
-                    fprintf(stderr, "Undefined variable: %s\n", var_name->data.string);
-                    exit(1);
-                }
-                
-                vm_push(vm, value_copy(value));
-                break;
+
+            VM_CASE(OP_DUP): {
+                vm_push(vm, vm_peek(vm, 0));
+                DISPATCH();
             }
-            
-            case OP_STORE_VAR: {
-                int index = (int)instr->operand.int_operand;
-                Value* var_name = chunk->constants[index];
-                
-                if (var_name->type != VAL_STRING) {
-                    fprintf(stderr, "Variable name must be a string\n");
-                    exit(1);
-                }
-                
-                Value* value = vm_peek(vm, 0);
-                environment_set(vm->globals, var_name->data.string, value);
-                break;
+
+            VM_CASE(OP_LOAD_GLOBAL_LONG):
+                operand = READ_U32();
+                goto load_global;
+
+            VM_CASE(OP_LOAD_GLOBAL):
+                operand = READ_BYTE();
+            load_global: {
+                VMValue value = vm->globals[operand];
+
+                if (IS_UNDEFINED(value)) {
+                    THROW_ERROR("NameError", "name '%s' is not defined", vm->chunk->global_names[operand]);
+                }
+
+                vm_push(vm, value);
+                DISPATCH();
             }
-            
-            case OP_BUILD_ARRAY: {
-                int size = (int)instr->operand.int_operand;
+
+            VM_CASE(OP_STORE_GLOBAL):
+                // 슬롯에 VMValue를 그대로 저장 (즉시값 박싱 없음)
+                vm->globals[READ_BYTE()] = vm_peek(vm, 0);
+                DISPATCH();
+
+            VM_CASE(OP_STORE_GLOBAL_LONG):
+                vm->globals[READ_U32()] = vm_peek(vm, 0);
+                DISPATCH();
+
+            VM_CASE(OP_LOAD_LOCAL):
+                vm_push(vm, slots[READ_BYTE()]);
+                DISPATCH();
+
+            VM_CASE(OP_STORE_LOCAL):
+                slots[READ_BYTE()] = vm_peek(vm, 0);
+                DISPATCH();
+
+            VM_CASE(OP_BUILD_ARRAY_LONG):
+                operand = READ_U32();
+                goto build_array;
+
+            VM_CASE(OP_BUILD_ARRAY):
+                operand = READ_BYTE();
+            build_array: {
+                int size = (int)operand;
                 Value** elements = (Value**)malloc(sizeof(Value*) * size);
-                
+
                 // 스택에서 요소들을 역순으로 팝
                 for (int i = size - 1; i >= 0; i--) {
-                    elements[i] = vm_pop(vm);
+                    elements[i] = vm_value_to_heap(vm_pop(vm));
                 }
-                
+
                 Value* array = value_create_array(elements, size);
-                
+
                 // elements는 배열이 소유하므로 free하지 않음!
-                vm_push(vm, array);
-                break;
+                vm_push(vm, OBJ_VAL(array));
+                DISPATCH();
             }
-            
-            case OP_INDEX: {
-                Value* index = vm_pop(vm);
-                Value* array = vm_pop(vm);
-                
-                if (array->type == VAL_ARRAY) {
-                    if (index->type != VAL_NUMBER) {
-                        fprintf(stderr, "Array index must be a number\n");
-                        exit(1);
-                    }
-                    
-                    int idx = (int)index->data.number;
-                    if (idx < 0 || idx >= array->data.array.count) {
-                        fprintf(stderr, "Array index out of bounds: %d\n", idx);
-                        exit(1);
-                    }
-                    
-                    vm_push(vm, value_copy(array->data.array.elements[idx]));
-                } else if (array->type == VAL_STRING) {
-                    if (index->type != VAL_NUMBER) {
-                        fprintf(stderr, "String index must be a number\n");
-                        exit(1);
-                    }
-                    
-                    int idx = (int)index->data.number;
-                    int len = strlen(array->data.string);
-                    if (idx < 0 || idx >= len) {
-                        fprintf(stderr, "String index out of bounds: %d\n", idx);
-                        exit(1);
-                    }
-                    
-                    char str[2] = {array->data.string[idx], '\0'};
-                    vm_push(vm, value_create_string(str));
-                } else {
-                    fprintf(stderr, "Cannot index non-array/string type\n");
-                    exit(1);
+
+            VM_CASE(OP_INDEX): {
+                VMValue index = vm_pop(vm);
+                VMValue target = vm_pop(vm);
+                vm_push(vm, vm_index_value(target, index));
+                CHECK_ERROR();
+                DISPATCH();
+            }
+
+            VM_CASE(OP_ARRAY_LENGTH):
+                vm_push(vm, NUMBER_VAL(vm_length(vm_pop(vm))));
+                CHECK_ERROR();
+                DISPATCH();
+
+            VM_CASE(OP_JUMP): {
+                uint16_t offset = READ_U16();
+                ip += offset;
+                DISPATCH();
+            }
+
+            VM_CASE(OP_JUMP_IF_FALSE): {
+                uint16_t offset = READ_U16();
+                if (vm_is_falsey(vm_pop(vm))) ip += offset;
+                DISPATCH();
+            }
+
+            VM_CASE(OP_JUMP_IF_TRUE): {
+                uint16_t offset = READ_U16();
+                if (!vm_is_falsey(vm_pop(vm))) ip += offset;
+                DISPATCH();
+            }
+
+            VM_CASE(OP_LOOP): {
+                uint16_t offset = READ_U16();
+
+                // 무한 루프 방지는 역방향 점프에서만 검사
+                if (vm->max_loop_iterations > 0 && ++loop_count > vm->max_loop_iterations) {
+                    fprintf(stderr, "Too many loop iterations (%ld)! Possible infinite loop.\n",
+                            vm->max_loop_iterations);
+                    vm->ip = ip;
+                    return;
                 }
-                break;
+                ip -= offset;
+                gc_safepoint();  // 살아 있는 값은 모두 스택/전역에 있음
+
+                // 핫 루프는 트레이스(기계어)로 돌리고, 빠져나온 위치에서 이어서 해석
+                if (vm->trace_enabled) {
+                    int resume = trace_enter(vm, chunk, (int)(ip - chunk->code),
+                                             (int)(ip + offset - 3 - chunk->code), slots, &loop_count);
+                    if (resume >= 0) ip = chunk->code + resume;
+                }
+                DISPATCH();
             }
-            
-            case OP_ARRAY_LENGTH: {
-                Value* array = vm_pop(vm);
-                
-                if (array->type == VAL_ARRAY) {
-                    vm_push(vm, value_create_number(array->data.array.count));
-                } else if (array->type == VAL_STRING) {
-                    vm_push(vm, value_create_number(strlen(array->data.string)));
-                } else {
-                    fprintf(stderr, "Cannot get length of non-array/string type\n");
-                    exit(1);
+
+            // ===== 함수 호출 =====
+
+            VM_CASE(OP_CALL): {
+                int arg_count = READ_BYTE();
+                VMValue callee = vm_peek(vm, arg_count);
+
+                if (!IS_OBJ_TYPE(callee, VAL_FUNCTION) || !AS_OBJ(callee)->data.function->chunk) {
+                    THROW_ERROR("TypeError", "value is not callable");
                 }
-                break;
+                BytecodeChunk* function = AS_OBJ(callee)->data.function->chunk;
+
+                if (vm->frame_count >= FRAMES_MAX) {
+                    THROW_ERROR("RecursionError", "maximum recursion depth exceeded");
+                }
+
+                // 새 프레임이 쓸 스택을 한 번에 확보 (이후 push는 검사 없음)
+                int base = (int)(vm->stack_top - vm->stack) - arg_count - 1;
+                vm_reserve_stack(vm, base + function->max_stack);
+
+                // 인자 개수 맞추기 (모자라면 null, 남으면 버림 - 인터프리터와 동일)
+                for (; arg_count < function->arity; arg_count++) vm_push(vm, NULL_VAL);
+                for (; arg_count > function->arity; arg_count--) vm_pop(vm);
+
+                // 나머지 지역 변수 슬롯
+                for (int i = 0; i < function->local_count; i++) vm_push(vm, NULL_VAL);
+
+                frame->ip = ip;
+                frame = &vm->frames[vm->frame_count++];
+                frame->chunk = function;
+                frame->base = base;
+
+                chunk = function;
+                ip = function->code;
+                slots = &vm->stack[frame->base];
+                gc_safepoint();
+                DISPATCH();
             }
-            
-            case OP_JUMP: {
-                int target = (int)instr->operand.int_operand;
-                vm->ip = &chunk->instructions[target];
-                break;
+
+            VM_CASE(OP_RETURN): {
+                VMValue result = vm_pop(vm);
+
+                // 스크립트 최상위의 return은 프로그램 종료
+                if (--vm->frame_count == 0) {
+                    vm->ip = ip;
+                    return;
+                }
+
+                vm->stack_top = vm->stack + frame->base;
+                vm_push(vm, result);
+
+                frame = &vm->frames[vm->frame_count - 1];
+                chunk = frame->chunk;
+                ip = frame->ip;
+                slots = &vm->stack[frame->base];
+                DISPATCH();
+            }
+
+            VM_CASE(OP_CALL_BUILTIN): {
+                int builtin = READ_BYTE();
+                int arg_count = READ_BYTE();
+                VMValue result = vm_call_builtin(builtin, vm->stack_top - arg_count, arg_count);
+                vm->stack_top -= arg_count;
+                vm_push(vm, result);
+                DISPATCH();
+            }
+
+            // ===== 슈퍼명령어 =====
+
+            VM_CASE(OP_JUMP_IF_NOT_LESS): {
+                uint16_t offset = READ_U16();
+                VMValue right = vm_pop(vm);
+                VMValue left = vm_pop(vm);
+
+                if (!IS_NUMBER(left) || !IS_NUMBER(right)) {
+                    THROW_ERROR("TypeError", "unsupported operand types for <");
+                }
+                if (!(AS_NUMBER(left) < AS_NUMBER(right))) ip += offset;
+                DISPATCH();
+            }
+
+            VM_CASE(OP_INCR_LOCAL): {
+                uint8_t slot = READ_BYTE();
+                int8_t amount = (int8_t)READ_BYTE();
+                VMValue value = slots[slot];
+
+                if (!IS_NUMBER(value)) {
+                    THROW_ERROR("TypeError", "unsupported operand types for +");
+                }
+                slots[slot] = NUMBER_VAL(AS_NUMBER(value) + amount);
+                DISPATCH();
+            }
+
+            VM_CASE(OP_INCR_GLOBAL): {
+                uint8_t slot = READ_BYTE();
+                int8_t amount = (int8_t)READ_BYTE();
+                VMValue value = vm->globals[slot];
+
+                if (IS_UNDEFINED(value)) {
+                    THROW_ERROR("NameError", "name '%s' is not defined", vm->chunk->global_names[slot]);
+                }
+                if (!IS_NUMBER(value)) {
+                    THROW_ERROR("TypeError", "unsupported operand types for +");
+                }
+                vm->globals[slot] = NUMBER_VAL(AS_NUMBER(value) + amount);
+                DISPATCH();
+            }
+
+            VM_CASE(OP_INDEX_LOCALS): {
+                uint8_t array_slot = READ_BYTE();
+                uint8_t index_slot = READ_BYTE();
+                vm_push(vm, vm_index_value(slots[array_slot], slots[index_slot]));
+                CHECK_ERROR();
+                DISPATCH();
+            }
+
+            VM_CASE(OP_INDEX_GLOBALS): {
+                uint8_t array_slot = READ_BYTE();
+                uint8_t index_slot = READ_BYTE();
+                VMValue target = vm->globals[array_slot];
+                VMValue index = vm->globals[index_slot];
+
+                if (IS_UNDEFINED(target) || IS_UNDEFINED(index)) {
+                    THROW_ERROR("NameError", "name '%s' is not defined", 
+                                vm->chunk->global_names[IS_UNDEFINED(target) ? array_slot : index_slot]);
+                }
+                vm_push(vm, vm_index_value(target, index));
+                CHECK_ERROR();
+                DISPATCH();
             }
-            
-            case OP_JUMP_IF_FALSE: {
-                Value* condition = vm_pop(vm);
-                int is_false = 0;
-                
-                if (condition->type == VAL_BOOL) {
-                    is_false = !condition->data.boolean;
-                } else if (condition->type == VAL_NUMBER) {
-                    is_false = (condition->data.number == 0);
+
+            VM_CASE(OP_ADD_CONST): {
+                VMValue right = vm_value_from_heap(chunk->constants[READ_BYTE()]);
+                VMValue left = vm_pop(vm);
+
+                if (IS_NUMBER(left) && IS_NUMBER(right)) {
+                    vm_push(vm, NUMBER_VAL(AS_NUMBER(left) + AS_NUMBER(right)));
+                } else if (IS_OBJ_TYPE(left, VAL_STRING) && IS_OBJ_TYPE(right, VAL_STRING)) {
+                    vm_push(vm, vm_concat_strings(AS_OBJ(left), AS_OBJ(right)));
                 } else {
-                    is_false = 0;
+                    THROW_ERROR("TypeError", "unsupported operand types for +");
                 }
-                
-                if (is_false) {
-                    int target = (int)instr->operand.int_operand;
-                    vm->ip = &chunk->instructions[target];
+                DISPATCH();
+            }
+
+            // ===== 퀵닝된 명령어 =====
+            // 같은 위치의 일반 명령어가 이미 한 번 실행됐으므로 스택 깊이 검사 없이 top을 직접 읽는다.
+            // 가드가 틀리면 ip[-1]을 일반 명령어로 되돌리고 일반 핸들러로 넘어가 다시 처리한다.
+
+#define QUICK_NUMBER_OP(generic, label, make, operator) { \
+                VMValue right = vm->stack_top[-1]; \
+                VMValue left = vm->stack_top[-2]; \
+                if (IS_NUMBER(left) && IS_NUMBER(right)) { \
+                    VMValue result = make(AS_NUMBER(left) operator AS_NUMBER(right)); \
+                    *(--vm->stack_top - 1) = result; \
+                    DISPATCH(); \
+                } \
+                ip[-1] = generic; \
+                goto label; \
+            }
+
+            VM_CASE(OP_ADD_NUM):           QUICK_NUMBER_OP(OP_ADD, op_add, NUMBER_VAL, +)
+            VM_CASE(OP_SUBTRACT_NUM):      QUICK_NUMBER_OP(OP_SUBTRACT, op_subtract, NUMBER_VAL, -)
+            VM_CASE(OP_MULTIPLY_NUM):      QUICK_NUMBER_OP(OP_MULTIPLY, op_multiply, NUMBER_VAL, *)
+            VM_CASE(OP_LESS_NUM):          QUICK_NUMBER_OP(OP_LESS, op_less, BOOL_VAL, <)
+            VM_CASE(OP_LESS_EQUAL_NUM):    QUICK_NUMBER_OP(OP_LESS_EQUAL, op_less_equal, BOOL_VAL, <=)
+            VM_CASE(OP_GREATER_NUM):       QUICK_NUMBER_OP(OP_GREATER, op_greater, BOOL_VAL, >)
+            VM_CASE(OP_GREATER_EQUAL_NUM): QUICK_NUMBER_OP(OP_GREATER_EQUAL, op_greater_equal, BOOL_VAL, >=)
+
+#undef QUICK_NUMBER_OP
+
+            VM_CASE(OP_ADD_STR): {
+                VMValue* top = vm->stack_top;
+                if (IS_OBJ_TYPE(top[-2], VAL_STRING) && IS_OBJ_TYPE(top[-1], VAL_STRING)) {
+                    top[-2] = vm_concat_strings(AS_OBJ(top[-2]), AS_OBJ(top[-1]));
+                    vm->stack_top--;
+                    DISPATCH();
                 }
-                break;
+                ip[-1] = OP_ADD;
+                goto op_add;
             }
-            
-            case OP_HALT:
+
+            VM_CASE(OP_HALT):
+                vm->ip = ip;
                 return;
-            
+
+            // ===== 예외 =====
+            // 던지지 않는 경로에는 비용이 없고, 던질 때만 청크의 핸들러 테이블을 찾아 프레임을 되감는다.
+
+            VM_CASE(OP_THROW): {
+                // 예외 값은 그대로, 그 밖의 값은 RuntimeError로 감쌈 (문자열이면 메시지)
+                VMValue value = vm_pop(vm);
+                if (IS_OBJ_TYPE(value, VAL_EXCEPTION)) {
+                    exception = AS_OBJ(value);
+                } else {
+                    char* message = IS_OBJ_TYPE(value, VAL_STRING) ? AS_OBJ(value)->data.string : "";
+                    exception = value_create_exception("RuntimeError", message);
+                }
+                goto throw_exception;
+            }
+
+            throw_pending:
+                exception = pending_error;
+                pending_error = NULL;
+
+            throw_exception: {
+                attach_stack_trace(vm, exception);
+
+                // 던진 명령어 위치부터, 핸들러가 없으면 호출한 프레임의 CALL 위치에서 다시 찾음
+                BytecodeHandler* handler;
+                for (;;) {
+                    int offset = (int)(ip - chunk->code) - 1;
+                    handler = bytecode_find_handler(chunk, offset, exception->data.exception->type);
+                    if (handler || vm->frame_count == 1) break;
+
+                    frame = &vm->frames[--vm->frame_count - 1];
+                    chunk = frame->chunk;
+                    ip = frame->ip;
+                    slots = &vm->stack[frame->base];
+                }
+
+                // 잡히지 않은 예외는 인터프리터처럼 출력하고 종료
+                if (!handler) {
+                    exception_report_uncaught(exception);
+                    vm->ip = ip;
+                    return;
+                }
+
+                // 핸들러의 스택 깊이로 잘라내고 예외 값을 올린 채 catch 블록으로
+                vm->stack_top = vm->stack + frame->base + handler->depth;
+                vm_push(vm, OBJ_VAL(exception));
+                ip = chunk->code + handler->handler;
+                DISPATCH();
+            }
+
+#ifdef VM_THREADED_DISPATCH
+            L_unknown:
+#else
             default:
-                fprintf(stderr, "Unknown opcode: %d\n", instr->opcode);
+#endif
+                fprintf(stderr, "Unknown opcode: %d\n", ip[-1]);
                 exit(1);
+#ifndef VM_THREADED_DISPATCH
         }
     }
+#endif
 }
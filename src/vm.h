@@ -3,32 +3,87 @@
 
 #include "bytecode.h"
 #include "interpreter.h"
+#include "nanbox.h"
 
-#define STACK_MAX 256
+#define FRAMES_MAX 1000                 // 최대 호출 깊이 (인터프리터의 max_stack_depth와 같음)
+#define VM_STACK_INITIAL 256             // 처음 확보하는 스택 슬롯 수 (모자라면 프레임에 들어갈 때 늘림)
+#define VM_DEFAULT_MAX_LOOPS 100000000L  // 역방향 점프 허용 횟수 (0이면 무제한)
+
+// 호출 프레임 (함수 호출 하나)
+typedef struct {
+    BytecodeChunk* chunk;   // 실행 중인 함수의 청크
+    uint8_t* ip;            // 호출한 쪽으로 돌아갈 때 이어서 실행할 위치
+    int base;               // 스택에서 이 프레임의 슬롯 0 위치 (슬롯 0 = 함수, 1.. = 인자/지역 변수)
+} CallFrame;
 
 // 가상 머신 구조체
 typedef struct {
-    BytecodeChunk* chunk;
-    Instruction* ip;  // Instruction Pointer (현재 실행 중인 명령어)
+    BytecodeChunk* chunk;   // 스크립트 청크 (전역 이름 테이블 포함)
+    uint8_t* ip;      // Instruction Pointer (다음에 실행할 명령어 바이트)
+    
+    // 스택 (NaN-boxed 값: 숫자/불리언/null은 힙 할당 없음)
+    // 프레임에 들어갈 때 청크의 max_stack만큼 미리 확보하므로 push/pop은 범위 검사 없이 포인터만 옮긴다.
+    // 늘어날 때 주소가 바뀌므로 프레임 위치는 포인터가 아니라 인덱스(CallFrame.base)로 들고 있음
+    VMValue* stack;
+    VMValue* stack_top;     // 다음에 푸시할 자리
+    int stack_capacity;
     
-    // 스택
-    Value* stack[STACK_MAX];
-    int stack_top;
+    // 호출 프레임 스택
+    CallFrame frames[FRAMES_MAX];
+    int frame_count;
     
-    // 전역 변수
-    Environment* globals;
+    // 전역 변수 (컴파일러가 정한 슬롯 번호로 인덱싱)
+    VMValue* globals;
+    int global_count;
+    
+    // 무한 루프 방지 (OP_LOOP 실행 횟수 상한, 0이면 무제한)
+    long max_loop_iterations;
+    long jit_loop_budget;   // JIT 코드가 역방향 점프마다 줄이는 남은 횟수
+    int trace_enabled;      // 핫 루프를 트레이스 JIT로 실행 (--no-trace로 끔)
 } VM;
 
 // VM 생성/해제
 VM* vm_create();
 void vm_free(VM* vm);
 
-// VM 실행
-void vm_run(VM* vm, BytecodeChunk* chunk);
+// VM 실행 (검증에 실패해서 실행하지 않았으면 0)
+int vm_run(VM* vm, BytecodeChunk* chunk);
+
+// 스택 연산 (깊이는 컴파일러가 계산한 max_stack과 bytecode_verify가 보장)
+void vm_reserve_stack(VM* vm, int slots);  // 스택 바닥부터 slots개를 쓸 수 있게 늘림
+
+static inline void vm_push(VM* vm, VMValue value) {
+    *vm->stack_top++ = value;
+}
+
+static inline VMValue vm_pop(VM* vm) {
+    return *--vm->stack_top;
+}
+
+static inline VMValue vm_peek(VM* vm, int distance) {
+    return vm->stack_top[-1 - distance];
+}
+
+// VMValue <-> 힙 Value 변환
+VMValue vm_value_from_heap(Value* value);
+Value* vm_value_to_heap(VMValue value);
+void vm_value_print(VMValue value);
+
+// 런타임 에러 (type은 인터프리터와 같은 예외 타입 이름)
+// vm_run 실행 중이면 예외로 만들어 두었다가 vm_run이 핸들러 테이블로 던지고,
+// 그 밖(JIT/레지스터 VM)에서는 exception_report_uncaught로 출력 후 종료
+void vm_runtime_error(const char* type, const char* format, ...);
+const char* vm_operator_symbol(OpCode opcode);
 
-// 스택 연산
-void vm_push(VM* vm, Value* value);
-Value* vm_pop(VM* vm);
-Value* vm_peek(VM* vm, int distance);
+// 값 연산 (스택 VM과 레지스터 VM 공용, 에러는 vm_runtime_error로 알리고 아무 값이나 반환)
+int vm_is_falsey(VMValue value);
+int vm_values_equal(VMValue left, VMValue right);
+int vm_length(VMValue target);
+VMValue vm_concat_strings(Value* left, Value* right);
+VMValue vm_repeat_string(Value* string, double count);
+VMValue vm_index_value(VMValue target, VMValue index);
+VMValue vm_call_builtin(int builtin, VMValue* args, int arg_count);
+VMValue vm_binary_op(OpCode opcode, VMValue left, VMValue right);
+VMValue vm_unary_op(OpCode opcode, VMValue value);
 
 #endif
@@ -0,0 +1,152 @@
+#include "x64.h"
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+void x64_byte(X64Assembler* as, uint8_t byte) {
+    if (as->count >= as->capacity) {
+        as->capacity = as->capacity < 256 ? 256 : as->capacity * 2;
+        as->code = (uint8_t*)realloc(as->code, as->capacity);
+    }
+    as->code[as->count++] = byte;
+}
+
+void x64_u32(X64Assembler* as, uint32_t value) {
+    for (int i = 0; i < 4; i++) x64_byte(as, (value >> (i * 8)) & 0xff);
+}
+
+void x64_u64(X64Assembler* as, uint64_t value) {
+    for (int i = 0; i < 8; i++) x64_byte(as, (value >> (i * 8)) & 0xff);
+}
+
+// REX 접두사 (64비트 연산, 확장 레지스터)
+void x64_rex(X64Assembler* as, int reg, int rm) {
+    x64_byte(as, 0x48 | ((reg & 8) ? 4 : 0) | ((rm & 8) ? 1 : 0));
+}
+
+void x64_modrm_reg(X64Assembler* as, int reg, int rm) {
+    x64_byte(as, 0xC0 | ((reg & 7) << 3) | (rm & 7));
+}
+
+// [base + disp32] (rsp/r12 기준이면 SIB 필요)
+void x64_modrm_mem(X64Assembler* as, int reg, int base, int32_t disp) {
+    x64_byte(as, 0x80 | ((reg & 7) << 3) | (base & 7));
+    if ((base & 7) == RSP) x64_byte(as, 0x24);
+    x64_u32(as, (uint32_t)disp);
+}
+
+void x64_mov_imm(X64Assembler* as, int reg, uint64_t value) {
+    x64_rex(as, 0, reg);
+    x64_byte(as, 0xB8 + (reg & 7));
+    x64_u64(as, value);
+}
+
+void x64_mov(X64Assembler* as, int dst, int src) {
+    x64_rex(as, src, dst);
+    x64_byte(as, 0x89);
+    x64_modrm_reg(as, src, dst);
+}
+
+void x64_load(X64Assembler* as, int dst, int base, int32_t disp) {
+    x64_rex(as, dst, base);
+    x64_byte(as, 0x8B);
+    x64_modrm_mem(as, dst, base, disp);
+}
+
+void x64_store(X64Assembler* as, int base, int32_t disp, int src) {
+    x64_rex(as, src, base);
+    x64_byte(as, 0x89);
+    x64_modrm_mem(as, src, base, disp);
+}
+
+void x64_alu_imm(X64Assembler* as, int ext, int reg, int32_t value) {
+    x64_rex(as, 0, reg);
+    x64_byte(as, 0x81);
+    x64_modrm_reg(as, ext, reg);
+    x64_u32(as, (uint32_t)value);
+}
+
+void x64_alu(X64Assembler* as, uint8_t opcode, int dst, int src) {
+    x64_rex(as, src, dst);
+    x64_byte(as, opcode);
+    x64_modrm_reg(as, src, dst);
+}
+
+void x64_movq_to_xmm(X64Assembler* as, int xmm, int reg) {
+    x64_byte(as, 0x66);
+    x64_rex(as, xmm, reg);
+    x64_byte(as, 0x0F);
+    x64_byte(as, 0x6E);
+    x64_modrm_reg(as, xmm, reg);
+}
+
+void x64_movq_from_xmm(X64Assembler* as, int reg, int xmm) {
+    x64_byte(as, 0x66);
+    x64_rex(as, xmm, reg);
+    x64_byte(as, 0x0F);
+    x64_byte(as, 0x7E);
+    x64_modrm_reg(as, xmm, reg);
+}
+
+// prefix [REX] 0F opcode xmm, xmm (xmm8 이상이면 REX.R/REX.B만, W 없음)
+void x64_sse(X64Assembler* as, uint8_t prefix, uint8_t opcode, int dst, int src) {
+    x64_byte(as, prefix);
+    if ((dst | src) & 8) {
+        x64_byte(as, 0x40 | ((dst & 8) ? 4 : 0) | ((src & 8) ? 1 : 0));
+    }
+    x64_byte(as, 0x0F);
+    x64_byte(as, opcode);
+    x64_modrm_reg(as, dst, src);
+}
+
+void x64_call(X64Assembler* as, void* function) {
+    x64_mov_imm(as, RAX, (uint64_t)(uintptr_t)function);
+    x64_byte(as, 0xFF);
+    x64_byte(as, 0xD0);
+}
+
+int x64_jmp(X64Assembler* as) {
+    x64_byte(as, 0xE9);
+    x64_u32(as, 0);
+    return as->count - 4;
+}
+
+int x64_jcc(X64Assembler* as, int cc) {
+    x64_byte(as, 0x0F);
+    x64_byte(as, 0x80 | cc);
+    x64_u32(as, 0);
+    return as->count - 4;
+}
+
+void x64_patch_rel32(X64Assembler* as, int position, int target) {
+    int32_t rel = target - (position + 4);
+    memcpy(as->code + position, &rel, 4);
+}
+
+void x64_patch_here(X64Assembler* as, int position) {
+    x64_patch_rel32(as, position, as->count);
+}
+
+uint8_t* x64_finalize(X64Assembler* as, size_t* size) {
+    uint8_t* code = NULL;
+    void* memory = mmap(NULL, as->count, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (memory != MAP_FAILED) {
+        memcpy(memory, as->code, as->count);
+        if (mprotect(memory, as->count, PROT_READ | PROT_EXEC) == 0) {
+            code = (uint8_t*)memory;
+            *size = as->count;
+        } else {
+            munmap(memory, as->count);
+        }
+    }
+
+    free(as->code);
+    as->code = NULL;
+    as->count = as->capacity = 0;
+    return code;
+}
+
+void x64_free_code(uint8_t* code, size_t size) {
+    if (code) munmap(code, size);
+}
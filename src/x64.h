@@ -0,0 +1,83 @@
+#ifndef X64_H
+#define X64_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// x86-64 기계어 인코더 (jit.c 템플릿 JIT와 trace.c 트레이스 JIT 공용)
+//
+// 필요한 명령어만 직접 바이트로 인코딩한다. 모든 연산은 64비트 (REX.W).
+// 점프는 rel32로 내보내고 위치를 돌려주므로 목적지를 안 뒤에 x64_patch_*로 채운다.
+
+// 범용 레지스터 번호
+enum {
+    RAX = 0, RCX = 1, RDX = 2, RBX = 3, RSP = 4, RBP = 5, RSI = 6, RDI = 7,
+    R8 = 8, R9 = 9, R10 = 10, R11 = 11, R12 = 12, R13 = 13, R14 = 14
+};
+
+// 조건 코드 (Jcc/SETcc 하위 4비트)
+enum {
+    CC_B = 0x2, CC_AE = 0x3, CC_E = 0x4, CC_NE = 0x5, CC_BE = 0x6, CC_A = 0x7,
+    CC_P = 0xA, CC_NP = 0xB
+};
+
+// ALU 확장 opcode (0x81 /n)
+enum { ALU_ADD = 0, ALU_SUB = 5, ALU_CMP = 7 };
+
+// x64_alu용 opcode (r/m64, r64 형식)
+#define OPC_ADD 0x01
+#define OPC_AND 0x21
+#define OPC_XOR 0x31
+#define OPC_CMP 0x39
+
+// SSE2 스칼라 double 연산 (x64_sse의 opcode, prefix는 주석)
+#define SSE_MOVAPD  0x28   // 66
+#define SSE_UCOMISD 0x2E   // 66
+#define SSE_XORPD   0x57   // 66
+#define SSE_ADDSD   0x58   // F2
+#define SSE_MULSD   0x59   // F2
+#define SSE_SUBSD   0x5C   // F2
+#define SSE_DIVSD   0x5E   // F2
+
+typedef struct {
+    uint8_t* code;
+    int count;
+    int capacity;
+} X64Assembler;
+
+void x64_byte(X64Assembler* as, uint8_t byte);
+void x64_u32(X64Assembler* as, uint32_t value);
+void x64_u64(X64Assembler* as, uint64_t value);
+
+// REX.W 접두사와 ModRM (reg, rm은 레지스터 번호 0..15)
+void x64_rex(X64Assembler* as, int reg, int rm);
+void x64_modrm_reg(X64Assembler* as, int reg, int rm);
+void x64_modrm_mem(X64Assembler* as, int reg, int base, int32_t disp);   // [base + disp32]
+
+void x64_mov_imm(X64Assembler* as, int reg, uint64_t value);             // mov reg, imm64
+void x64_mov(X64Assembler* as, int dst, int src);                        // mov dst, src
+void x64_load(X64Assembler* as, int dst, int base, int32_t disp);        // mov dst, [base + disp]
+void x64_store(X64Assembler* as, int base, int32_t disp, int src);       // mov [base + disp], src
+void x64_alu_imm(X64Assembler* as, int ext, int reg, int32_t value);     // add/sub/cmp reg, imm32
+void x64_alu(X64Assembler* as, uint8_t opcode, int dst, int src);        // OPC_* dst, src
+
+// xmm 레지스터 (0..15)
+void x64_movq_to_xmm(X64Assembler* as, int xmm, int reg);
+void x64_movq_from_xmm(X64Assembler* as, int reg, int xmm);
+void x64_sse(X64Assembler* as, uint8_t prefix, uint8_t opcode, int dst, int src);
+
+// C 함수 호출 (절대 주소, rax 사용)
+void x64_call(X64Assembler* as, void* function);
+
+// jmp/jcc rel32 (채울 rel32 위치 반환)
+int x64_jmp(X64Assembler* as);
+int x64_jcc(X64Assembler* as, int cc);
+void x64_patch_rel32(X64Assembler* as, int position, int target);
+void x64_patch_here(X64Assembler* as, int position);
+
+// 만든 코드를 실행 메모리로 옮김 (W^X: mmap RW → 복사 → mprotect RX, 실패하면 NULL)
+// 어셈블러 버퍼는 해제한다.
+uint8_t* x64_finalize(X64Assembler* as, size_t* size);
+void x64_free_code(uint8_t* code, size_t size);
+
+#endif
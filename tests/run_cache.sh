@@ -0,0 +1,78 @@
+#!/bin/sh
+# 바이트코드 캐시(.finec) 테스트: tests/*.fine을 임시 디렉터리에 복사해 --vm으로 실행하면서
+#  - 캐시를 읽은 실행이 새로 컴파일한 실행과 같은 출력/종료 코드를 내고 캐시를 다시 쓰지 않는지
+#  - 캐시가 깨지거나 잘렸을 때, -O 단계가 바뀌었을 때, 소스를 고쳤을 때 실행하지 않고 다시 컴파일하는지
+#    (다시 컴파일하면 캐시 파일이 새로 컴파일한 내용으로 다시 쓰인다)
+# 를 확인. VM이 컴파일하지 못해 인터프리터로 대체 실행하는 프로그램은 캐시가 없으므로 건너뜀
+#   사용법: tests/run_cache.sh [finelang 경로]
+
+FINELANG=${1:-./finelang}
+DIR=$(dirname "$0")
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+PROGRAM="$WORK/prog.fine"
+CACHE="$WORK/prog.finec"
+failed=0
+
+# 프로그램 출력 + 종료 코드
+run() {
+    "$FINELANG" --vm "$@" "$PROGRAM" 2>/dev/null
+    echo "exit $?"
+}
+
+check() {
+    if [ "$2" != "$3" ]; then
+        echo "FAIL $test: $1"
+        test_failed=1
+    fi
+}
+
+for test in "$DIR"/*.fine; do
+    test_failed=0
+    cp "$test" "$PROGRAM"
+    rm -f "$CACHE"
+    fresh=$(run --no-cache)
+
+    # 처음 실행은 컴파일해서 캐시를 씀
+    check "first run output" "$(run)" "$fresh"
+    [ -f "$CACHE" ] || { echo "skip $test (no cache)"; continue; }
+    cp "$CACHE" "$WORK/expected.finec"
+
+    # 두 번째 실행은 캐시를 읽음 (다시 쓰지 않음)
+    touch "$WORK/marker"
+    check "cached run output" "$(run)" "$fresh"
+    check "cached run rewrote the cache" "$(find "$CACHE" -newer "$WORK/marker")" ""
+
+    # 내용 한 바이트가 깨진 캐시
+    size=$(wc -c < "$WORK/expected.finec")
+    for byte in A B; do
+        printf "$byte" | dd of="$CACHE" bs=1 seek=$((size / 2)) conv=notrunc 2>/dev/null
+        cmp -s "$CACHE" "$WORK/expected.finec" || break
+    done
+    check "corrupted cache output" "$(run)" "$fresh"
+    check "corrupted cache was not recompiled" "$(cmp -s "$CACHE" "$WORK/expected.finec"; echo $?)" 0
+
+    # 잘린 캐시
+    head -c $((size / 2)) "$WORK/expected.finec" > "$CACHE"
+    check "truncated cache output" "$(run)" "$fresh"
+    check "truncated cache was not recompiled" "$(cmp -s "$CACHE" "$WORK/expected.finec"; echo $?)" 0
+
+    # -O0으로 바꾸면 다시 컴파일, -O1로 돌아오면 또 다시 컴파일
+    check "-O0 run output" "$(run -O0)" "$(run -O0 --no-cache)"
+    check "-O0 run reused the -O1 cache" "$(cmp -s "$CACHE" "$WORK/expected.finec"; echo $?)" 1
+    check "-O1 run output" "$(run -O1)" "$fresh"
+    check "-O1 cache was not recompiled" "$(cmp -s "$CACHE" "$WORK/expected.finec"; echo $?)" 0
+
+    # 소스를 고치면 다시 컴파일
+    echo 'print("edited")' >> "$PROGRAM"
+    check "edited source output" "$(run)" "$(run --no-cache)"
+    check "edited source reused the old cache" "$(cmp -s "$CACHE" "$WORK/expected.finec"; echo $?)" 1
+
+    if [ $test_failed = 0 ]; then
+        echo "ok   $test"
+    else
+        failed=1
+    fi
+done
+
+exit $failed
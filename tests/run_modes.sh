@@ -0,0 +1,54 @@
+#!/bin/sh
+# 모드 비교 테스트: tests/*.fine을 인터프리터, --vm, --jit, --reg로 실행해서
+# 프로그램 출력(VM 모드는 "=== Execution ===" 뒤, 대체 실행이면 전체)과 종료 코드가 인터프리터와 같은지 확인
+# 기준 실행과 세 모드를 점진 GC(--gc-incremental --gc-pause 1, 단계마다 최소한만 진행)로 한 번 더 돌려서 같은지 확인
+#   사용법: tests/run_modes.sh [finelang 경로]
+#
+# 테스트 파일 머리의 주석으로 실행 방법을 바꿀 수 있다:
+#   # modes-flags: <옵션>       모든 실행에 붙일 옵션 (예: --max-loops 500)
+#   # modes-reference: <옵션>   기준 실행 (기본은 인터프리터, 인터프리터에 없는 기능이면 --vm --no-trace 등)
+
+FINELANG=${1:-./finelang}
+DIR=$(dirname "$0")
+failed=0
+
+program_output() {
+    # 디스어셈블리를 출력했으면 실행 결과만, 아니면 (인터프리터로 대체 실행) 전체
+    awk 'found { print; next } /^=== Execution ===$/ { found = 1; n = 0; next } { lines[n++] = $0 }
+         END { if (!found) for (i = 0; i < n; i++) print lines[i] }'
+}
+
+for test in "$DIR"/*.fine; do
+    flags=$(sed -n 's/^# modes-flags: //p' "$test")
+    reference=$(sed -n 's/^# modes-reference: //p' "$test")
+
+    expected=$("$FINELANG" $reference $flags --no-cache "$test" 2>/dev/null | program_output)
+    expected_status=$("$FINELANG" $reference $flags --no-cache "$test" >/dev/null 2>&1; echo $?)
+
+    for gc in "" "--gc-incremental --gc-pause 1"; do
+        for mode in reference --vm --jit --reg; do
+            # 기준 실행 자체는 점진 GC로만 다시 돌림
+            if [ "$mode" = reference ]; then
+                [ -z "$gc" ] && continue
+                mode=${reference:-interpreter}
+                options="$reference $gc"
+            else
+                options="$mode${gc:+ $gc}"
+            fi
+
+            actual=$("$FINELANG" $options $flags --no-cache "$test" 2>/dev/null | program_output)
+            actual_status=$("$FINELANG" $options $flags --no-cache "$test" >/dev/null 2>&1; echo $?)
+
+            if [ "$actual" != "$expected" ] || [ "$actual_status" != "$expected_status" ]; then
+                echo "FAIL $test ($mode${gc:+ $gc}): exit $actual_status, expected $expected_status"
+                echo "--- expected"; echo "$expected"
+                echo "--- actual"; echo "$actual"
+                failed=1
+            else
+                echo "ok   $test ($mode${gc:+ $gc})"
+            fi
+        done
+    done
+done
+
+exit $failed
@@ -0,0 +1,28 @@
+#!/bin/sh
+# REPL 테스트: tests/*.repl을 한 줄씩 REPL에 넣어서, 안내문과 프롬프트를 뺀 출력이
+# 같은 파일을 프로그램으로 실행한 출력과 같고 정상 종료하는지 확인
+# (REPL은 줄마다 따로 파싱하므로 앞 줄에서 정의한 것을 뒤 줄에서 쓰는 경우를 확인할 수 있다)
+#   사용법: tests/run_repl.sh [finelang 경로]
+
+FINELANG=${1:-./finelang}
+DIR=$(dirname "$0")
+failed=0
+
+for test in "$DIR"/*.repl; do
+    expected=$("$FINELANG" "$test" 2>/dev/null)
+
+    # 안내문 세 줄을 건너뛰고 프롬프트를 지움
+    actual=$("$FINELANG" < "$test" 2>/dev/null | tail -n +4 | sed 's/>>> //g')
+    status=$("$FINELANG" < "$test" >/dev/null 2>&1; echo $?)
+
+    if [ "$actual" != "$expected" ] || [ "$status" != 0 ]; then
+        echo "FAIL $test: exit $status"
+        echo "--- expected"; echo "$expected"
+        echo "--- actual"; echo "$actual"
+        failed=1
+    else
+        echo "ok   $test"
+    fi
+done
+
+exit $failed